@@ -0,0 +1,269 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "fixed_block_pool.h"
+#include "foo.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t BlockCount = 1'000'000;
+
+struct NewDelete
+{
+  static constexpr const char* name = "new/delete";
+
+  std::int32_t* allocate(std::int32_t value)
+  {
+    return new std::int32_t(value);
+  }
+
+  void deallocate(std::int32_t* p)
+  {
+    delete p;
+  }
+};
+
+struct Pool
+{
+  static constexpr const char* name = "FixedBlockPool";
+
+  std::int32_t* allocate(std::int32_t value)
+  {
+    return ::new (pool.allocate()) std::int32_t(value);
+  }
+
+  void deallocate(std::int32_t* p)
+  {
+    pool.deallocate(p);
+  }
+
+  FixedBlockPool pool{sizeof(std::int32_t), alignof(std::int32_t)};
+};
+
+/// @brief Allocates BlockCount blocks, then frees a random half and allocates it again, which is
+/// what a long-lived container of Foo sees as elements come and go.
+template <typename Allocator>
+std::vector<std::int32_t*> fragment(Allocator& allocator)
+{
+  std::vector<std::int32_t*> blocks(BlockCount);
+  for (std::size_t i = 0; i < BlockCount; ++i)
+  {
+    blocks[i] = allocator.allocate(static_cast<std::int32_t>(i));
+  }
+
+  std::vector<std::size_t> order(BlockCount);
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::shuffle(order.begin(), order.end(), std::mt19937{42});
+  order.resize(BlockCount / 2);
+
+  for (auto i : order)
+  {
+    allocator.deallocate(blocks[i]);
+  }
+
+  for (auto i : order)
+  {
+    blocks[i] = allocator.allocate(static_cast<std::int32_t>(i));
+  }
+
+  return blocks;
+}
+
+/// @brief Percentage of consecutive elements whose blocks share a 64-byte cache line; higher means
+/// fewer cache misses when walking the container.
+double sharedCacheLines(const std::vector<std::int32_t*>& blocks)
+{
+  std::size_t shared = 0;
+  for (std::size_t i = 1; i < blocks.size(); ++i)
+  {
+    const auto a = reinterpret_cast<std::uintptr_t>(blocks[i - 1]) / 64;
+    const auto b = reinterpret_cast<std::uintptr_t>(blocks[i]) / 64;
+    shared += a == b ? 1 : 0;
+  }
+
+  return 100.0 * static_cast<double>(shared) / static_cast<double>(blocks.size() - 1);
+}
+
+/// @brief Growth in peak resident set size (in KiB) of a child process that allocates BlockCount
+/// blocks. Returns 0 where that cannot be measured.
+template <typename Allocator>
+long peakRssKiB()
+{
+#if defined(__linux__)
+  // The child starts out with the parent's resident pages, so measure relative to those
+  long resident_pages = 0;
+  if (auto statm = std::fopen("/proc/self/statm", "r"))
+  {
+    long size_pages = 0;
+    if (std::fscanf(statm, "%ld %ld", &size_pages, &resident_pages) != 2)
+    {
+      resident_pages = 0;
+    }
+    std::fclose(statm);
+  }
+
+  const pid_t pid = fork();
+  if (pid == 0)
+  {
+    Allocator allocator;
+    for (std::size_t i = 0; i < BlockCount; ++i)
+    {
+      allocator.allocate(static_cast<std::int32_t>(i));
+    }
+    _exit(0);
+  }
+
+  int status = 0;
+  rusage usage{};
+  if (pid < 0 || wait4(pid, &status, 0, &usage) != pid)
+  {
+    return 0;
+  }
+
+  return std::max(0L, usage.ru_maxrss - resident_pages * (sysconf(_SC_PAGESIZE) / 1024));
+#else
+  return 0;
+#endif
+}
+
+template <typename Allocator>
+void reportFragmentation(long peak_rss)
+{
+  Allocator allocator;
+  auto blocks = fragment(allocator);
+
+  std::cout << std::left << std::setw(18) << Allocator::name << std::right << std::setw(14)
+            << peak_rss << std::setw(24) << std::fixed << std::setprecision(1)
+            << sharedCacheLines(blocks) << "%\n";
+
+  for (auto block : blocks)
+  {
+    allocator.deallocate(block);
+  }
+}
+
+template <typename Allocator>
+void benchmarkAllocator()
+{
+  const std::string name{Allocator::name};
+
+  BENCHMARK(name + " allocate then free 1M")
+  {
+    Allocator allocator;
+    std::vector<std::int32_t*> blocks(BlockCount);
+    for (std::size_t i = 0; i < BlockCount; ++i)
+    {
+      blocks[i] = allocator.allocate(static_cast<std::int32_t>(i));
+    }
+
+    for (auto block : blocks)
+    {
+      allocator.deallocate(block);
+    }
+
+    return blocks.front();
+  };
+
+  BENCHMARK(name + " churn 1M")
+  {
+    Allocator allocator;
+    std::int32_t* window[64]{};
+    for (std::size_t i = 0; i < BlockCount; ++i)
+    {
+      auto& slot = window[i % 64];
+      allocator.deallocate(slot);
+      slot = allocator.allocate(static_cast<std::int32_t>(i));
+    }
+
+    for (auto block : window)
+    {
+      allocator.deallocate(block);
+    }
+
+    return window[0];
+  };
+
+  BENCHMARK_ADVANCED(name + " sum fragmented 1M")(Catch::Benchmark::Chronometer meter)
+  {
+    Allocator allocator;
+    auto blocks = fragment(allocator);
+
+    meter.measure([&blocks] {
+      std::int64_t sum = 0;
+      for (auto block : blocks)
+      {
+        sum += *block;
+      }
+      return sum;
+    });
+
+    for (auto block : blocks)
+    {
+      allocator.deallocate(block);
+    }
+  };
+}
+} // namespace
+
+TEST_CASE("FixedBlockPool memory footprint", "[fixed_block_pool][benchmark]")
+{
+  std::cout << std::left << std::setw(18) << "allocator" << std::right << std::setw(14)
+            << "peak RSS KiB" << std::setw(25) << "shared cache lines" << '\n';
+
+  // Measure both before either workload leaves freed pages behind for the children to reuse
+  const long new_delete_rss = peakRssKiB<NewDelete>();
+  const long pool_rss = peakRssKiB<Pool>();
+
+  reportFragmentation<NewDelete>(new_delete_rss);
+  reportFragmentation<Pool>(pool_rss);
+}
+
+TEST_CASE("FixedBlockPool against new/delete", "[fixed_block_pool][benchmark]")
+{
+  benchmarkAllocator<NewDelete>();
+  benchmarkAllocator<Pool>();
+}
+
+#if defined(CPP_TRAINING_FOO_USE_POOL)
+TEST_CASE("Foo with pooled data", "[fixed_block_pool][benchmark]")
+#else
+TEST_CASE("Foo with heap data", "[fixed_block_pool][benchmark]")
+#endif
+{
+  BENCHMARK("std::vector<Foo> construct and destroy 1M")
+  {
+    std::vector<Foo> values;
+    values.reserve(BlockCount);
+    for (std::size_t i = 0; i < BlockCount; ++i)
+    {
+      values.emplace_back(static_cast<std::int32_t>(i));
+    }
+
+    return values.back().getData();
+  };
+
+  BENCHMARK_ADVANCED("std::vector<Foo> copy 1M")(Catch::Benchmark::Chronometer meter)
+  {
+    const std::vector<Foo> values(BlockCount);
+    meter.measure([&values] { return std::vector<Foo>(values).size(); });
+  };
+}
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "allocation_stats.h"
+#include "instrumented_allocator.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t AllocationCount = 100'000;
+
+/// @brief Allocates and frees blocks of a few sizes, keeping a handful live at a time.
+template <typename Allocator>
+std::size_t churn(Allocator allocator)
+{
+  constexpr std::size_t Sizes[] = {1, 4, 16, 64, 256};
+  constexpr std::size_t Live = 8;
+
+  std::int32_t* blocks[Live] = {};
+  std::size_t counts[Live] = {};
+  std::size_t checksum = 0;
+  for (std::size_t i = 0; i < AllocationCount; ++i)
+  {
+    const auto slot = i % Live;
+    if (blocks[slot] != nullptr)
+    {
+      allocator.deallocate(blocks[slot], counts[slot]);
+    }
+
+    counts[slot] = Sizes[i % std::size(Sizes)];
+    blocks[slot] = allocator.allocate(counts[slot]);
+    checksum += reinterpret_cast<std::uintptr_t>(blocks[slot]) & 0xff;
+  }
+
+  for (std::size_t slot = 0; slot < Live; ++slot)
+  {
+    allocator.deallocate(blocks[slot], counts[slot]);
+  }
+
+  return checksum;
+}
+
+template <typename Allocator>
+std::size_t churnOnThreads(const Allocator& allocator, std::size_t thread_count)
+{
+  std::vector<std::size_t> checksums(thread_count);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < thread_count; ++t)
+  {
+    threads.emplace_back([&, t] { checksums[t] = churn(allocator); });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  std::size_t checksum = 0;
+  for (auto value : checksums)
+  {
+    checksum += value;
+  }
+
+  return checksum;
+}
+} // namespace
+
+TEST_CASE("InstrumentedAllocator overhead", "[stats][benchmark]")
+{
+  auto& site = AllocationStatsRegistry::global().site("benchmark");
+  const InstrumentedAllocator<std::int32_t> instrumented{site};
+  const auto thread_count = std::max(2u, std::thread::hardware_concurrency());
+
+  BENCHMARK("std::allocator / 1 thread")
+  {
+    return churn(std::allocator<std::int32_t>{});
+  };
+
+  BENCHMARK("InstrumentedAllocator / 1 thread")
+  {
+    return churn(instrumented);
+  };
+
+  BENCHMARK("std::allocator / all threads")
+  {
+    return churnOnThreads(std::allocator<std::int32_t>{}, thread_count);
+  };
+
+  BENCHMARK("InstrumentedAllocator / all threads")
+  {
+    return churnOnThreads(instrumented, thread_count);
+  };
+}
@@ -0,0 +1,135 @@
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "default_equality.h"
+#include "default_hash.h"
+#include "simd_algorithms.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t KeyCount = 4096;
+
+/// @brief Keys of the given length that differ only in their last characters, as generated
+/// identifiers often do, so every comparison of a key with its copy reads it all.
+std::vector<std::string> makeKeys(std::size_t length)
+{
+  std::vector<std::string> keys;
+  keys.reserve(KeyCount);
+  for (std::size_t i = 0; i < KeyCount; ++i)
+  {
+    auto key = std::string(length, 'k') + std::to_string(i);
+    keys.push_back(key.substr(key.size() - length));
+  }
+
+  return keys;
+}
+
+const char* name(simd::InstructionSet instruction_set)
+{
+  switch (instruction_set)
+  {
+  case simd::InstructionSet::Avx2:
+    return "AVX2";
+  case simd::InstructionSet::Sse2:
+    return "SSE2";
+  default:
+    return "scalar";
+  }
+}
+
+void benchmarkStrings(std::size_t length)
+{
+  const auto keys = makeKeys(length);
+  const auto copies = keys;
+  const auto suffix = " (" + std::to_string(length) + " characters)";
+
+  BENCHMARK("strcmp" + suffix)
+  {
+    std::size_t matches = 0;
+    for (std::size_t i = 0; i < KeyCount; ++i)
+    {
+      matches += std::strcmp(keys[i].c_str(), copies[i].c_str()) == 0 ? 1 : 0;
+    }
+    return matches;
+  };
+
+  BENCHMARK("std::hash<std::string_view>" + suffix)
+  {
+    std::size_t combined = 0;
+    for (const auto& key : keys)
+    {
+      combined ^= std::hash<std::string_view>{}(key);
+    }
+    return combined;
+  };
+
+  BENCHMARK("DefaultHash<std::string_view>" + suffix)
+  {
+    std::size_t combined = 0;
+    for (const auto& key : keys)
+    {
+      combined ^= DefaultHash<std::string_view>{}(key);
+    }
+    return combined;
+  };
+
+  BENCHMARK("DefaultEquality<std::string_view>" + suffix)
+  {
+    std::size_t matches = 0;
+    for (std::size_t i = 0; i < KeyCount; ++i)
+    {
+      matches += DefaultEquality<std::string_view>{}(keys[i], copies[i]) ? 1 : 0;
+    }
+    return matches;
+  };
+
+  const auto original = simd::instruction_set();
+  for (auto instruction_set :
+       {simd::InstructionSet::Scalar, simd::InstructionSet::Sse2, simd::InstructionSet::Avx2})
+  {
+    if (simd::set_instruction_set(instruction_set) != instruction_set)
+    {
+      continue;
+    }
+
+    const auto label = suffix + " " + name(instruction_set);
+
+    BENCHMARK("DefaultEquality<const char*>" + label)
+    {
+      std::size_t matches = 0;
+      for (std::size_t i = 0; i < KeyCount; ++i)
+      {
+        matches += DefaultEquality<const char*>{}(keys[i].c_str(), copies[i].c_str()) ? 1 : 0;
+      }
+      return matches;
+    };
+
+    BENCHMARK("DefaultHash<const char*>" + label)
+    {
+      std::size_t combined = 0;
+      for (const auto& key : keys)
+      {
+        combined ^= DefaultHash<const char*>{}(key.c_str());
+      }
+      return combined;
+    };
+  }
+  simd::set_instruction_set(original);
+}
+} // namespace
+
+TEST_CASE("C string equality and hashing against strcmp and std::hash", "[strings][benchmark]")
+{
+  benchmarkStrings(8);
+  benchmarkStrings(24);
+  benchmarkStrings(64);
+  benchmarkStrings(256);
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "thread_pool.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 1 << 20;
+
+/// @brief Enough arithmetic per element that the loop is bound by computation, not memory.
+double work(double value)
+{
+  for (int i = 0; i < 16; ++i)
+  {
+    value = std::sqrt(value + 1.0) * 1.0001;
+  }
+  return value;
+}
+} // namespace
+
+TEST_CASE("ThreadPool scheduling overhead", "[thread_pool][benchmark]")
+{
+  auto& pool = ThreadPool::global();
+
+  BENCHMARK("submit and wait for an empty task") { pool.submit([] {}).get(); };
+
+  BENCHMARK("submit 64 empty tasks, then wait for them")
+  {
+    std::vector<std::future<void>> futures;
+    futures.reserve(64);
+    for (int i = 0; i < 64; ++i)
+    {
+      futures.push_back(pool.submit([] {}));
+    }
+    for (auto& future : futures)
+    {
+      future.get();
+    }
+  };
+
+  std::vector<std::size_t> values(ElementCount);
+
+  BENCHMARK("serial loop over 1M trivial elements")
+  {
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      values[i] = i;
+    }
+    return values.back();
+  };
+
+  BENCHMARK("parallel_for over 1M trivial elements")
+  {
+    pool.parallel_for(0, values.size(), [&values](std::size_t i) { values[i] = i; });
+    return values.back();
+  };
+
+  BENCHMARK("parallel_for over 1M trivial elements, grain size 1024")
+  {
+    pool.parallel_for(0, values.size(), [&values](std::size_t i) { values[i] = i; }, 1024);
+    return values.back();
+  };
+}
+
+TEST_CASE("ThreadPool scaling from one worker to every hardware thread",
+          "[thread_pool][benchmark]")
+{
+  std::vector<double> values(ElementCount, 2.0);
+
+  BENCHMARK("serial loop over 1M elements of computation")
+  {
+    for (auto& value : values)
+    {
+      value = work(value);
+    }
+    return values.back();
+  };
+
+  const auto hardware_threads = std::max(1U, std::thread::hardware_concurrency());
+  for (std::size_t workers = 1; workers <= hardware_threads; workers *= 2)
+  {
+    ThreadPool pool{workers};
+
+    BENCHMARK("parallel_for over 1M elements of computation, " + std::to_string(workers) +
+              " workers")
+    {
+      pool.parallel_for(
+        0, values.size(), [&values](std::size_t i) { values[i] = work(values[i]); });
+      return values.back();
+    };
+  }
+}
@@ -0,0 +1,249 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace CppTraining
+{
+/// @brief A point-in-time copy of one AllocationSite's counters.
+struct AllocationSiteStats
+{
+  /// @brief Bucket i of the size histogram counts requests of (2^(i-1), 2^i] bytes; bucket 0
+  /// counts requests of at most one byte and the last bucket everything larger than its
+  /// predecessor.
+  static constexpr std::size_t SizeBuckets = 32;
+
+  /// @brief The largest request, in bytes, that lands in the given bucket. The last bucket has no
+  /// limit.
+  static std::optional<std::size_t> bucket_limit(std::size_t bucket) noexcept
+  {
+    if (bucket + 1 >= SizeBuckets)
+    {
+      return std::nullopt;
+    }
+
+    return std::size_t{1} << bucket;
+  }
+
+  std::string name;
+  std::uint64_t allocations{0};
+  std::uint64_t deallocations{0};
+  std::uint64_t reallocations{0};
+  std::uint64_t bytes_allocated{0};
+  std::uint64_t bytes_deallocated{0};
+  std::int64_t live_bytes{0};
+  std::int64_t peak_live_bytes{0};
+  std::uint64_t growth_events{0};
+  std::uint64_t growth_bytes{0};
+  std::array<std::uint64_t, SizeBuckets> size_histogram{};
+};
+
+/// @brief Allocation counters for one named source of allocations, e.g. a container type or a
+/// subsystem. Every thread that records through a site gets its own block of counters, which only
+/// that thread writes, so recording is a few plain loads and stores with no locks and no shared
+/// cache lines. Only live and peak bytes are shared, since the peak must see every thread's
+/// allocations at once.
+class AllocationSite final
+{
+public:
+  explicit AllocationSite(std::string name);
+  AllocationSite(const AllocationSite&) = delete;
+  AllocationSite(AllocationSite&&) = delete;
+  AllocationSite& operator=(const AllocationSite&) = delete;
+  AllocationSite& operator=(AllocationSite&&) = delete;
+  ~AllocationSite();
+
+  const std::string& name() const noexcept;
+
+  void record_allocation(std::size_t bytes) noexcept
+  {
+    auto& counters = thread_counters();
+    add(counters.allocations, 1);
+    add(counters.bytes_allocated, bytes);
+    add(counters.size_histogram[size_bucket(bytes)], 1);
+    add_live_bytes(static_cast<std::int64_t>(bytes));
+  }
+
+  void record_deallocation(std::size_t bytes) noexcept
+  {
+    auto& counters = thread_counters();
+    add(counters.deallocations, 1);
+    add(counters.bytes_deallocated, bytes);
+    add_live_bytes(-static_cast<std::int64_t>(bytes));
+  }
+
+  /// @brief A block resized without a separate allocation (in place, or by realloc).
+  void record_reallocation(std::size_t old_bytes, std::size_t new_bytes) noexcept
+  {
+    auto& counters = thread_counters();
+    add(counters.reallocations, 1);
+    if (new_bytes > old_bytes)
+    {
+      add(counters.bytes_allocated, new_bytes - old_bytes);
+    }
+    else
+    {
+      add(counters.bytes_deallocated, old_bytes - new_bytes);
+    }
+    add_live_bytes(static_cast<std::int64_t>(new_bytes) - static_cast<std::int64_t>(old_bytes));
+  }
+
+  /// @brief A container grew its capacity from old_bytes to new_bytes.
+  void record_growth(std::size_t old_bytes, std::size_t new_bytes) noexcept
+  {
+    auto& counters = thread_counters();
+    add(counters.growth_events, 1);
+    add(counters.growth_bytes, new_bytes - std::min(old_bytes, new_bytes));
+  }
+
+  /// @brief Sums every thread's counters. While other threads are allocating the counters are read
+  /// one at a time, so the result may be a moment out of step between fields.
+  AllocationSiteStats snapshot() const;
+
+  static std::size_t size_bucket(std::size_t bytes) noexcept
+  {
+    if (bytes <= 1)
+    {
+      return 0;
+    }
+
+#if defined(__GNUC__)
+    const auto bits = static_cast<std::size_t>(std::numeric_limits<unsigned long long>::digits -
+                                               __builtin_clzll(bytes - 1));
+#else
+    std::size_t bits = 0;
+    for (auto value = bytes - 1; value != 0; value >>= 1)
+    {
+      ++bits;
+    }
+#endif
+
+    return std::min(bits, AllocationSiteStats::SizeBuckets - 1);
+  }
+
+private:
+  /// @brief One thread's counters. They are atomics only so that snapshot() may read them while
+  /// the owning thread writes.
+  struct alignas(64) ThreadCounters
+  {
+    explicit ThreadCounters(std::thread::id owner) noexcept : owner{owner} {}
+
+    std::thread::id owner;
+    ThreadCounters* next{nullptr};
+
+    std::atomic<std::uint64_t> allocations{0};
+    std::atomic<std::uint64_t> deallocations{0};
+    std::atomic<std::uint64_t> reallocations{0};
+    std::atomic<std::uint64_t> bytes_allocated{0};
+    std::atomic<std::uint64_t> bytes_deallocated{0};
+    std::atomic<std::uint64_t> growth_events{0};
+    std::atomic<std::uint64_t> growth_bytes{0};
+    std::array<std::atomic<std::uint64_t>, AllocationSiteStats::SizeBuckets> size_histogram{};
+  };
+
+  /// @brief Remembers the calling thread's counters for the most recently used sites. Trivially
+  /// destructible, so that allocators may still record from other thread_local destructors.
+  struct ThreadCacheEntry
+  {
+    std::uint64_t site_id;
+    ThreadCounters* counters;
+  };
+
+  static constexpr std::size_t ThreadCacheSize = 64;
+
+  /// @brief Only the owning thread writes, so no read-modify-write instruction is needed.
+  static void add(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+
+  static ThreadCacheEntry* thread_cache() noexcept
+  {
+    thread_local ThreadCacheEntry cache[ThreadCacheSize] = {};
+    return cache;
+  }
+
+  ThreadCounters& thread_counters() noexcept
+  {
+    auto& entry = thread_cache()[id_ % ThreadCacheSize];
+    if (entry.site_id != id_)
+    {
+      entry = {id_, &find_thread_counters()};
+    }
+
+    return *entry.counters;
+  }
+
+  /// @brief Finds the calling thread's counters, adding them on its first visit. A new thread may
+  /// take over the counters of an exited thread that had the same id. If the counters cannot be
+  /// allocated the thread shares fallback_, where concurrent updates may be lost.
+  ThreadCounters& find_thread_counters() noexcept;
+
+  void add_live_bytes(std::int64_t delta) noexcept
+  {
+    const auto live = live_bytes_.fetch_add(delta, std::memory_order_relaxed) + delta;
+    auto peak = peak_live_bytes_.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !peak_live_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  // Ids are never reused, so a thread's cache cannot mistake a new site for a destroyed one
+  std::uint64_t id_;
+  std::string name_;
+  std::atomic<ThreadCounters*> threads_{nullptr};
+  ThreadCounters fallback_{std::thread::id{}};
+  alignas(64) std::atomic<std::int64_t> live_bytes_{0};
+  std::atomic<std::int64_t> peak_live_bytes_{0};
+};
+
+/// @brief Owns the allocation sites, keyed by name. Creating or looking up a site takes a lock;
+/// recording through a site never does, so look a site up once and keep the reference.
+class AllocationStatsRegistry final
+{
+public:
+  AllocationStatsRegistry() = default;
+  AllocationStatsRegistry(const AllocationStatsRegistry&) = delete;
+  AllocationStatsRegistry(AllocationStatsRegistry&&) = delete;
+  AllocationStatsRegistry& operator=(const AllocationStatsRegistry&) = delete;
+  AllocationStatsRegistry& operator=(AllocationStatsRegistry&&) = delete;
+
+  /// @brief The process-wide registry. It is never destroyed, so that containers with static
+  /// storage duration can keep recording while the program shuts down.
+  static AllocationStatsRegistry& global();
+
+  /// @brief The site with the given name, created on first use. The reference stays valid for the
+  /// registry's lifetime.
+  AllocationSite& site(std::string_view name);
+
+  std::optional<AllocationSiteStats> find(std::string_view name) const;
+
+  /// @brief Every site's counters, ordered by name.
+  std::vector<AllocationSiteStats> snapshot() const;
+
+  void write_json(std::ostream& stream) const;
+  std::string to_json() const;
+
+private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<AllocationSite>, std::less<>> sites_;
+};
+
+/// @brief The global registry's site for allocators that were not given one.
+AllocationSite& default_allocation_site();
+} // namespace CppTraining
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace CppTraining
+{
+namespace detail
+{
+template <typename Allocator>
+using allocator_pointer_t = typename std::allocator_traits<Allocator>::pointer;
+
+template <typename Allocator>
+using allocator_size_t = typename std::allocator_traits<Allocator>::size_type;
+
+template <typename Allocator>
+using expand_in_place_result_t = decltype(std::declval<Allocator&>().expand_in_place(
+  std::declval<allocator_pointer_t<Allocator>>(),
+  std::declval<allocator_size_t<Allocator>>(),
+  std::declval<allocator_size_t<Allocator>>()));
+
+template <typename Allocator>
+using reallocate_result_t = decltype(std::declval<Allocator&>().reallocate(
+  std::declval<allocator_pointer_t<Allocator>>(),
+  std::declval<allocator_size_t<Allocator>>(),
+  std::declval<allocator_size_t<Allocator>>()));
+
+template <typename Allocator>
+using on_growth_result_t =
+  decltype(std::declval<Allocator&>().on_growth(std::declval<allocator_size_t<Allocator>>(),
+                                                std::declval<allocator_size_t<Allocator>>(),
+                                                std::declval<allocator_size_t<Allocator>>()));
+
+template <typename Allocator, typename = void>
+struct has_expand_in_place : std::false_type
+{
+};
+
+template <typename Allocator>
+struct has_expand_in_place<Allocator, std::void_t<expand_in_place_result_t<Allocator>>>
+    : std::true_type
+{
+};
+
+template <typename Allocator, typename = void>
+struct has_reallocate : std::false_type
+{
+};
+
+template <typename Allocator>
+struct has_reallocate<Allocator, std::void_t<reallocate_result_t<Allocator>>> : std::true_type
+{
+};
+
+template <typename Allocator, typename = void>
+struct has_on_growth : std::false_type
+{
+};
+
+template <typename Allocator>
+struct has_on_growth<Allocator, std::void_t<on_growth_result_t<Allocator>>> : std::true_type
+{
+};
+} // namespace detail
+
+/// @brief Optional allocator extensions that let a container resize its block instead of
+/// allocating a new one, in the spirit of realloc/mremap. An allocator opts in by providing either
+/// member:
+///
+///   bool expand_in_place(pointer p, size_type old_count, size_type new_count) noexcept;
+///     Grows or shrinks the block at p without moving it. Returns false (leaving the block intact)
+///     when that is not possible.
+///
+///   pointer reallocate(pointer p, size_type old_count, size_type new_count);
+///     Resizes the block and may move its bytes, like realloc. Only used for trivially relocatable
+///     element types. Throws std::bad_alloc on failure, leaving the original block intact.
+///
+/// An allocator may also observe the container it serves by providing:
+///
+///   void on_growth(size_type size, size_type old_capacity, size_type new_capacity) noexcept;
+///     Called after a container holding size elements has grown its capacity, whether the block
+///     was resized in place or replaced.
+template <typename Allocator>
+struct allocator_extension_traits final
+{
+  using pointer = detail::allocator_pointer_t<Allocator>;
+  using size_type = detail::allocator_size_t<Allocator>;
+
+  static constexpr bool has_expand_in_place = detail::has_expand_in_place<Allocator>::value;
+  static constexpr bool has_reallocate = detail::has_reallocate<Allocator>::value;
+  static constexpr bool has_on_growth = detail::has_on_growth<Allocator>::value;
+
+  static bool expand_in_place(Allocator& allocator,
+                              pointer p,
+                              size_type old_count,
+                              size_type new_count) noexcept
+  {
+    if constexpr (has_expand_in_place)
+    {
+      return allocator.expand_in_place(p, old_count, new_count);
+    }
+    else
+    {
+      (void)allocator;
+      (void)p;
+      (void)old_count;
+      (void)new_count;
+      return false;
+    }
+  }
+
+  static pointer reallocate(Allocator& allocator,
+                            pointer p,
+                            size_type old_count,
+                            size_type new_count)
+  {
+    static_assert(has_reallocate, "Allocator does not provide reallocate()");
+    return allocator.reallocate(p, old_count, new_count);
+  }
+
+  static void on_growth(Allocator& allocator,
+                        size_type size,
+                        size_type old_capacity,
+                        size_type new_capacity) noexcept
+  {
+    if constexpr (has_on_growth)
+    {
+      allocator.on_growth(size, old_capacity, new_capacity);
+    }
+    else
+    {
+      (void)allocator;
+      (void)size;
+      (void)old_capacity;
+      (void)new_capacity;
+    }
+  }
+};
+} // namespace CppTraining
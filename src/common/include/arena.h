@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CppTraining
+{
+/// @brief Monotonic (bump-pointer) memory arena. Allocations are carved from a caller-supplied
+/// buffer and, once that is exhausted, from a chain of chunks obtained from the global allocator.
+/// Individual deallocation is a no-op; reset() makes all of the memory available again at once.
+class Arena final
+{
+public:
+  static constexpr std::size_t DefaultChunkSize = 64 * 1024;
+
+  explicit Arena(std::size_t chunk_size = DefaultChunkSize);
+  Arena(void* buffer, std::size_t buffer_size, std::size_t chunk_size = DefaultChunkSize);
+  Arena(const Arena&) = delete;
+  Arena(Arena&&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  Arena& operator=(Arena&&) = delete;
+  ~Arena();
+
+  void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+  /// @brief Rewinds to the start of the arena. Chunks are kept for reuse.
+  void reset() noexcept;
+
+  /// @brief Rewinds to the start of the arena and returns all chunks to the global allocator.
+  void release() noexcept;
+
+  std::size_t bytes_allocated() const noexcept;
+  std::size_t chunk_count() const noexcept;
+
+private:
+  struct Chunk
+  {
+    Chunk* next;
+    std::size_t size;
+  };
+
+  static std::byte* chunk_begin(Chunk* chunk) noexcept;
+  static std::byte* chunk_end(Chunk* chunk) noexcept;
+
+  void* try_allocate(std::size_t bytes, std::size_t alignment) noexcept;
+  void use_next_chunk(std::size_t bytes, std::size_t alignment);
+
+  std::byte* buffer_{nullptr};
+  std::size_t buffer_size_{0};
+  std::size_t chunk_size_;
+
+  Chunk* chunks_{nullptr};
+  Chunk* current_chunk_{nullptr};
+
+  std::byte* current_{nullptr};
+  std::byte* end_{nullptr};
+  std::size_t bytes_allocated_{0};
+};
+} // namespace CppTraining
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "arena.h"
+
+namespace CppTraining
+{
+/// @brief Allocator that carves memory out of an Arena. deallocate() is a no-op; the memory comes
+/// back all at once when the arena is reset. The allocator propagates with the container on copy,
+/// move and swap so that storage never outlives (or strays from) the arena it came from.
+template <typename T>
+class ArenaAllocator final
+{
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  explicit ArenaAllocator(Arena& arena) noexcept : arena_{&arena} {}
+  template <class U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_{&other.getArena()}
+  {
+  }
+  ArenaAllocator(const ArenaAllocator&) = default;
+  ArenaAllocator(ArenaAllocator&&) noexcept = default;
+  ArenaAllocator& operator=(const ArenaAllocator&) = default;
+  ArenaAllocator& operator=(ArenaAllocator&&) noexcept = default;
+  ~ArenaAllocator() = default;
+
+  T* allocate(std::size_t n)
+  {
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+  void deallocate(T*, std::size_t) noexcept {}
+
+  Arena& getArena() const noexcept { return *arena_; }
+
+private:
+  Arena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept
+{
+  return &lhs.getArena() == &rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+} // namespace CppTraining
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "foo.h"
+#include "throwing_copy.h"
+
+namespace CppTraining
+{
+/// @brief How the container benchmarks create, compare and name each element type. make(i) creates
+/// the i-th value, argument() gives the constructor argument that emplace_back forwards, and less()
+/// orders values for std::sort.
+template <typename T>
+struct BenchmarkElement;
+
+template <>
+struct BenchmarkElement<int>
+{
+  static constexpr const char* name = "int";
+
+  static int make(std::size_t i) { return static_cast<int>(i); }
+  static int argument(int value) { return value; }
+  static std::int64_t key(int value) { return value; }
+  static bool less(int lhs, int rhs) { return lhs < rhs; }
+};
+
+template <>
+struct BenchmarkElement<Foo>
+{
+  static constexpr const char* name = "Foo";
+
+  static Foo make(std::size_t i) { return Foo{static_cast<std::int32_t>(i)}; }
+  static std::int32_t argument(const Foo& value) { return value.getData(); }
+  static std::int64_t key(const Foo& value) { return value.getData(); }
+  static bool less(const Foo& lhs, const Foo& rhs) { return lhs.getData() < rhs.getData(); }
+};
+
+template <>
+struct BenchmarkElement<std::string>
+{
+  static constexpr const char* name = "std::string";
+
+  /// @brief Long enough to defeat the small string optimization, so that copies allocate.
+  static std::string make(std::size_t i) { return "benchmark element #" + std::to_string(i); }
+  static std::string_view argument(const std::string& value) { return value; }
+  static std::int64_t key(const std::string& value)
+  {
+    return static_cast<std::int64_t>(value.size());
+  }
+  static bool less(const std::string& lhs, const std::string& rhs) { return lhs < rhs; }
+};
+
+template <>
+struct BenchmarkElement<ThrowingCopy>
+{
+  static constexpr const char* name = "ThrowingCopy";
+
+  static ThrowingCopy make(std::size_t i) { return ThrowingCopy{static_cast<std::int32_t>(i)}; }
+  static std::int32_t argument(const ThrowingCopy& value) { return value.getData(); }
+  static std::int64_t key(const ThrowingCopy& value) { return value.getData(); }
+  static bool less(const ThrowingCopy& lhs, const ThrowingCopy& rhs)
+  {
+    return lhs.getData() < rhs.getData();
+  }
+};
+
+/// @brief count values in a fixed pseudo-random order, so that sorting them has work to do.
+template <typename T>
+std::vector<T> makeBenchmarkValues(std::size_t count)
+{
+  std::vector<std::size_t> order(count);
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::shuffle(order.begin(), order.end(), std::mt19937{42});
+
+  std::vector<T> values;
+  values.reserve(count);
+  for (auto i : order)
+  {
+    values.push_back(BenchmarkElement<T>::make(i));
+  }
+
+  return values;
+}
+
+/// @brief count indices into a container of size elements, for random access benchmarks.
+inline std::vector<std::size_t> makeBenchmarkIndices(std::size_t count, std::size_t size)
+{
+  std::mt19937 engine{7};
+  std::uniform_int_distribution<std::size_t> distribution{0, size - 1};
+
+  std::vector<std::size_t> indices(count);
+  std::generate(indices.begin(), indices.end(), [&] { return distribution(engine); });
+
+  return indices;
+}
+} // namespace CppTraining
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
+#include <string_view>
 
-#include <string.h>
+#include "simd_algorithms.h"
 
 namespace CppTraining
 {
@@ -12,16 +14,19 @@ struct DefaultEquality final
   bool operator()(const T& lhs, const T& rhs) const { return lhs == rhs; }
 };
 
+// C strings compare by their characters, with the vectorized simd::string_equal() rather than
+// strcmp(), which has to find which string sorts first
+
 template <>
 struct DefaultEquality<char*> final
 {
-  bool operator()(const char* lhs, const char* rhs) const { return strcmp(lhs, rhs) == 0; }
+  bool operator()(const char* lhs, const char* rhs) const { return simd::string_equal(lhs, rhs); }
 };
 
 template <>
 struct DefaultEquality<const char*> final
 {
-  bool operator()(const char* lhs, const char* rhs) const { return strcmp(lhs, rhs) == 0; }
+  bool operator()(const char* lhs, const char* rhs) const { return simd::string_equal(lhs, rhs); }
 };
 
 template <>
@@ -29,7 +34,7 @@ struct DefaultEquality<char* const> final
 {
   bool operator()(const char* const lhs, const char* const rhs) const
   {
-    return strcmp(lhs, rhs) == 0;
+    return simd::string_equal(lhs, rhs);
   }
 };
 
@@ -38,7 +43,27 @@ struct DefaultEquality<const char* const> final
 {
   bool operator()(const char* const lhs, const char* const rhs) const
   {
-    return strcmp(lhs, rhs) == 0;
+    return simd::string_equal(lhs, rhs);
+  }
+};
+
+// Strings that know their size compare it first, and only read the characters of equal sizes
+
+template <>
+struct DefaultEquality<std::string_view> final
+{
+  bool operator()(std::string_view lhs, std::string_view rhs) const
+  {
+    return simd::string_equal(lhs.data(), lhs.size(), rhs.data(), rhs.size());
+  }
+};
+
+template <>
+struct DefaultEquality<std::string> final
+{
+  bool operator()(const std::string& lhs, const std::string& rhs) const
+  {
+    return simd::string_equal(lhs.data(), lhs.size(), rhs.data(), rhs.size());
   }
 };
 } // namespace CppTraining
@@ -1,11 +1,43 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
 
 namespace CppTraining
 {
-struct DefaultGrowthPolicy final
+/// @brief Grows by the current capacity (i.e. doubles it). Stateless, so a Vector stores it for
+/// free.
+struct DefaultGrowthPolicy
 {
   std::size_t operator()(std::size_t /* size */, std::size_t capacity) const { return capacity; }
 };
+
+/// @brief Type-erased growth policy, for choosing growth behavior at runtime (e.g. from a lambda)
+/// without changing the Vector type. Costs a std::function per Vector and an indirect call on
+/// every regrow.
+class RuntimeGrowthPolicy final
+{
+public:
+  using function_type = std::function<std::size_t(std::size_t, std::size_t)>;
+
+  RuntimeGrowthPolicy() = default;
+
+  template <
+    typename Policy,
+    typename = std::enable_if_t<!std::is_same<std::decay_t<Policy>, RuntimeGrowthPolicy>::value>>
+  RuntimeGrowthPolicy(Policy&& policy) : policy_{std::forward<Policy>(policy)}
+  {
+  }
+
+  std::size_t operator()(std::size_t size, std::size_t capacity) const
+  {
+    // A moved-from policy falls back to the default so that moved-from vectors stay usable
+    return policy_ ? policy_(size, capacity) : DefaultGrowthPolicy{}(size, capacity);
+  }
+
+private:
+  function_type policy_{DefaultGrowthPolicy{}};
+};
 } // namespace CppTraining
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+#include "simd_algorithms.h"
+
+namespace CppTraining
+{
+/// @brief The hash that goes with DefaultEquality<T>: std::hash, except that C strings hash by
+/// their characters, like DefaultEquality compares them.
+template <typename T>
+struct DefaultHash final
+{
+  std::size_t operator()(const T& value) const { return std::hash<T>{}(value); }
+};
+
+template <>
+struct DefaultHash<char*> final
+{
+  std::size_t operator()(const char* value) const { return simd::string_hash(value); }
+};
+
+template <>
+struct DefaultHash<const char*> final
+{
+  std::size_t operator()(const char* value) const { return simd::string_hash(value); }
+};
+
+template <>
+struct DefaultHash<char* const> final
+{
+  std::size_t operator()(const char* const value) const { return simd::string_hash(value); }
+};
+
+template <>
+struct DefaultHash<const char* const> final
+{
+  std::size_t operator()(const char* const value) const { return simd::string_hash(value); }
+};
+
+// Strings that know their size skip the search for the terminator, and hash like the C strings
+// with the same characters, so a table keyed by one can be searched with the other
+
+template <>
+struct DefaultHash<std::string_view> final
+{
+  std::size_t operator()(std::string_view value) const
+  {
+    return simd::string_hash(value.data(), value.size());
+  }
+};
+
+template <>
+struct DefaultHash<std::string> final
+{
+  std::size_t operator()(const std::string& value) const
+  {
+    return simd::string_hash(value.data(), value.size());
+  }
+};
+} // namespace CppTraining
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// MSVC only applies the empty base optimization to the first empty base unless asked to
+#if defined(_MSC_VER)
+#define CPP_TRAINING_EMPTY_BASES __declspec(empty_bases)
+#else
+#define CPP_TRAINING_EMPTY_BASES
+#endif
+
+namespace CppTraining
+{
+namespace detail
+{
+/// @brief Holds a T as a member, or as a base class when T is empty so that it takes up no space
+/// (the empty base optimization). Index distinguishes several EboStorage bases of the same type.
+template <typename T, std::size_t Index, bool = std::is_empty<T>::value && !std::is_final<T>::value>
+class EboStorage
+{
+public:
+  EboStorage() = default;
+  explicit EboStorage(const T& value) : value_(value) {}
+  explicit EboStorage(T&& value) : value_(std::move(value)) {}
+
+  T& get() noexcept { return value_; }
+  const T& get() const noexcept { return value_; }
+
+private:
+  T value_{};
+};
+
+template <typename T, std::size_t Index>
+class EboStorage<T, Index, true> : private T
+{
+public:
+  EboStorage() = default;
+  explicit EboStorage(const T& value) : T(value) {}
+  explicit EboStorage(T&& value) : T(std::move(value)) {}
+
+  T& get() noexcept { return *this; }
+  const T& get() const noexcept { return *this; }
+};
+} // namespace detail
+} // namespace CppTraining
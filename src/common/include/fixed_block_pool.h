@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace CppTraining
+{
+/// @brief Slab allocator for blocks of a single size. Blocks are carved from large chunks and
+/// recycled through an intrusive free list, so allocate() and deallocate() are a handful of pointer
+/// operations and neighbouring blocks share cache lines. Not thread-safe; see thread_local_pool().
+class FixedBlockPool final
+{
+public:
+  static constexpr std::size_t DefaultBlocksPerChunk = 4096;
+
+  explicit FixedBlockPool(std::size_t block_size,
+                          std::size_t block_alignment = alignof(std::max_align_t),
+                          std::size_t blocks_per_chunk = DefaultBlocksPerChunk);
+  FixedBlockPool(const FixedBlockPool&) = delete;
+  FixedBlockPool(FixedBlockPool&&) = delete;
+  FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+  FixedBlockPool& operator=(FixedBlockPool&&) = delete;
+
+  /// @brief Returns the chunks to the global allocator, but only if every block carved from them
+  /// has come back. Otherwise the chunks are deliberately leaked so that outstanding blocks (for
+  /// example, ones handed to another thread) stay valid.
+  ~FixedBlockPool();
+
+  void* allocate();
+
+  /// @brief Adds the block to this pool's free list. The block may have come from a different pool
+  /// of the same block size.
+  void deallocate(void* block) noexcept;
+
+  /// @brief The distance between consecutive blocks: the requested size, rounded up to hold a free
+  /// list link and to the block alignment.
+  std::size_t block_size() const noexcept;
+
+  /// @brief Blocks allocated from this pool less blocks deallocated to it.
+  std::size_t blocks_in_use() const noexcept;
+  std::size_t chunk_count() const noexcept;
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  void add_chunk();
+  bool all_blocks_returned() const;
+
+  std::size_t block_alignment_;
+  std::size_t block_size_;
+  std::size_t blocks_per_chunk_;
+
+  std::vector<std::byte*> chunks_;
+  FreeBlock* free_list_{nullptr};
+
+  // Blocks are carved lazily so that a new chunk is only touched as it is used
+  std::byte* unused_{nullptr};
+  std::byte* unused_end_{nullptr};
+
+  std::size_t blocks_carved_{0};
+  std::size_t blocks_in_use_{0};
+};
+
+/// @brief The calling thread's pool for blocks of BlockSize bytes. Blocks freed on another thread
+/// join that thread's pool, which is safe because chunks are only released once all of their
+/// blocks have come home. Objects whose storage comes from these pools must not outlive the
+/// thread's pool itself (e.g. as statics destroyed after thread_local objects).
+template <std::size_t BlockSize, std::size_t Alignment = alignof(std::max_align_t)>
+FixedBlockPool& thread_local_pool()
+{
+  thread_local FixedBlockPool pool{BlockSize, Alignment};
+  return pool;
+}
+} // namespace CppTraining
@@ -2,6 +2,9 @@
 
 #include <cstdint>
 #include <string>
+#include <type_traits>
+
+#include "trivially_relocatable.h"
 
 namespace CppTraining
 {
@@ -26,4 +29,10 @@ private:
 };
 
 std::string to_string(const Foo& value);
+
+/// @brief Foo owns a single heap pointer, so its bytes can be moved without fixing anything up.
+template <>
+struct is_trivially_relocatable<Foo> : std::true_type
+{
+};
 } // namespace CppTraining
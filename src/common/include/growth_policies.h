@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "default_growth_policy.h"
+
+// Growth policies tuned for particular workloads. Like DefaultGrowthPolicy, each one returns the
+// number of elements to add to a full vector's capacity. The ones that care about the allocator's
+// view of a block are parameterized on the element type so that they can work in bytes.
+
+namespace CppTraining
+{
+namespace detail
+{
+inline std::size_t round_up(std::size_t value, std::size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/// @brief Converts a target block size in bytes into an increment in elements (at least one).
+template <typename T>
+std::size_t increment_for_bytes(std::size_t bytes, std::size_t capacity)
+{
+  const std::size_t new_capacity = bytes / sizeof(T);
+  return new_capacity > capacity ? new_capacity - capacity : 1;
+}
+} // namespace detail
+
+/// @brief Grows capacity by Numerator/Denominator (1.5x by default). Less memory is stranded than
+/// with doubling, and freed blocks can eventually be reused for later growth.
+template <std::size_t Numerator = 3, std::size_t Denominator = 2>
+struct GeometricGrowthPolicy
+{
+  static_assert(Numerator > Denominator, "GeometricGrowthPolicy must grow");
+
+  std::size_t operator()(std::size_t /* size */, std::size_t capacity) const
+  {
+    return std::max<std::size_t>(1, capacity * (Numerator - Denominator) / Denominator);
+  }
+};
+
+/// @brief Doubles, and rounds blocks of a page or more up to a whole number of pages so that the
+/// tail of the last page is usable capacity rather than waste.
+template <typename T, std::size_t PageSize = 4096>
+struct PageAlignedGrowthPolicy
+{
+  std::size_t operator()(std::size_t /* size */, std::size_t capacity) const
+  {
+    const std::size_t bytes = std::max<std::size_t>(1, capacity * 2) * sizeof(T);
+    if (bytes < PageSize)
+    {
+      return std::max<std::size_t>(1, capacity);
+    }
+
+    return detail::increment_for_bytes<T>(detail::round_up(bytes, PageSize), capacity);
+  }
+};
+
+/// @brief jemalloc's size classes: 8 and 16 bytes, multiples of 16 up to 128, then four classes
+/// per doubling (e.g. 160, 192, 224, 256).
+struct JemallocSizeClasses
+{
+  static std::size_t round_up(std::size_t bytes)
+  {
+    if (bytes <= 8)
+    {
+      return 8;
+    }
+
+    if (bytes <= 128)
+    {
+      return detail::round_up(bytes, 16);
+    }
+
+    std::size_t group = 128;
+    while (group * 2 < bytes)
+    {
+      group *= 2;
+    }
+
+    return detail::round_up(bytes, group / 4);
+  }
+};
+
+/// @brief glibc malloc's usable sizes on 64-bit targets: chunks are 16-byte aligned and carry an
+/// 8-byte header, so the usable sizes are 24, 40, 56, ...
+struct GlibcSizeClasses
+{
+  static std::size_t round_up(std::size_t bytes)
+  {
+    return std::max<std::size_t>(24, detail::round_up(bytes + 8, 16) - 8);
+  }
+};
+
+/// @brief Doubles, then rounds the block up to the allocator's next size class. The allocator
+/// hands out the whole size class anyway, so the rounding turns its slack into usable capacity.
+template <typename T, typename SizeClasses = JemallocSizeClasses>
+struct SizeClassGrowthPolicy
+{
+  std::size_t operator()(std::size_t /* size */, std::size_t capacity) const
+  {
+    const std::size_t bytes = std::max<std::size_t>(1, capacity * 2) * sizeof(T);
+    return detail::increment_for_bytes<T>(SizeClasses::round_up(bytes), capacity);
+  }
+};
+
+/// @brief Doubles until the capacity reaches Threshold elements, then grows by a constant Step.
+/// Bounds the memory a very large vector can strand, at the cost of more frequent regrowth.
+template <std::size_t Threshold = (1 << 20), std::size_t Step = (1 << 20)>
+struct CappedLinearGrowthPolicy
+{
+  static_assert(Step > 0, "CappedLinearGrowthPolicy must grow");
+
+  std::size_t operator()(std::size_t /* size */, std::size_t capacity) const
+  {
+    return capacity < Threshold ? std::max<std::size_t>(1, capacity) : Step;
+  }
+};
+
+/// @brief Doubles, and rounds blocks of a huge page or more up to a whole number of huge pages so
+/// that transparent huge pages can back the entire block.
+template <typename T, std::size_t HugePageSize = (2 << 20)>
+struct HugePageGrowthPolicy
+{
+  std::size_t operator()(std::size_t size, std::size_t capacity) const
+  {
+    return PageAlignedGrowthPolicy<T, HugePageSize>{}(size, capacity);
+  }
+};
+} // namespace CppTraining
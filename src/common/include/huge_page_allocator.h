@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "huge_pages.h"
+
+namespace CppTraining
+{
+/// @brief Stateless allocator that puts large blocks in 2 MiB pages and small ones on the heap
+/// (see huge_pages.h). Implements the reallocate() extension (see allocator_extensions.h), so a
+/// Vector of trivially relocatable elements grows by remapping its pages instead of copying them.
+template <typename T>
+class HugePageAllocator final
+{
+public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "HugePageAllocator does not support over-aligned types");
+
+  HugePageAllocator() = default;
+  template <class U>
+  HugePageAllocator(const HugePageAllocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(std::size_t n) { return static_cast<T*>(huge_pages::allocate(n * sizeof(T))); }
+
+  void deallocate(T* p, std::size_t n) noexcept { huge_pages::deallocate(p, n * sizeof(T)); }
+
+  T* reallocate(T* p, std::size_t old_count, std::size_t new_count)
+  {
+    return static_cast<T*>(
+      huge_pages::reallocate(p, old_count * sizeof(T), new_count * sizeof(T)));
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) noexcept
+{
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&) noexcept
+{
+  return false;
+}
+} // namespace CppTraining
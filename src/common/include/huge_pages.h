@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CppTraining
+{
+/// @brief Memory backed by 2 MiB pages, for large blocks that are accessed at random: every 4 KiB
+/// page costs a TLB entry, so a scan of gigabytes in 4 KiB pages misses the TLB on almost every
+/// access, where 2 MiB pages cover 512 times as much memory per entry.
+///
+/// Blocks of at least Threshold bytes are mapped with mmap, rounded up to whole 2 MiB pages. The
+/// first choice is MAP_HUGETLB, which takes pages from the kernel's reserved pool
+/// (/proc/sys/vm/nr_hugepages); when the pool is empty, the block is aligned to 2 MiB and marked
+/// with madvise(MADV_HUGEPAGE), so that transparent huge pages back it. Smaller blocks come from
+/// malloc, as they would not fill a huge page. On platforms other than Linux everything does.
+namespace huge_pages
+{
+inline constexpr std::size_t PageSize = std::size_t{2} << 20;
+inline constexpr std::size_t Threshold = PageSize;
+
+/// @brief Throws std::bad_alloc on failure.
+void* allocate(std::size_t bytes);
+
+/// @brief bytes must be the size the block was allocated or last reallocated with.
+void deallocate(void* block, std::size_t bytes) noexcept;
+
+/// @brief Resizes a block like realloc. Large blocks are moved with mremap, to a new 2 MiB
+/// aligned address, rather than copied. Throws std::bad_alloc on failure, leaving the block
+/// intact.
+void* reallocate(void* block, std::size_t old_bytes, std::size_t new_bytes);
+
+/// @brief Whether a block of this size is mapped in huge pages rather than taken from malloc.
+constexpr bool is_mapped(std::size_t bytes) noexcept
+{
+  return bytes >= Threshold;
+}
+} // namespace huge_pages
+} // namespace CppTraining
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CppTraining
+{
+namespace detail
+{
+/// @brief Uninitialized, suitably aligned room for Capacity objects of type T. The owner decides
+/// which of them are alive. With a capacity of zero this is an empty class, so it costs nothing as
+/// a base.
+template <typename T, std::size_t Capacity>
+class InlineStorage
+{
+public:
+  // Deliberately leaves the buffer uninitialized, even when value-initialized
+  InlineStorage() noexcept {}
+
+  T* data() noexcept { return reinterpret_cast<T*>(buffer_); }
+  const T* data() const noexcept { return reinterpret_cast<const T*>(buffer_); }
+
+private:
+  alignas(T) std::byte buffer_[Capacity * sizeof(T)];
+};
+
+template <typename T>
+class InlineStorage<T, 0>
+{
+public:
+  T* data() noexcept { return nullptr; }
+  const T* data() const noexcept { return nullptr; }
+};
+} // namespace detail
+} // namespace CppTraining
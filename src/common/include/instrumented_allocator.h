@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+#include "allocation_stats.h"
+#include "allocator_extensions.h"
+
+namespace CppTraining
+{
+/// @brief Wraps another allocator and records what it is asked for in an AllocationSite: counts,
+/// bytes, live and peak bytes, a size histogram and the growth events reported by containers. The
+/// inner allocator decides where memory comes from, how the allocator propagates and whether two
+/// allocators are interchangeable; the site only decides where the numbers go. The inner
+/// allocator's reallocate() and expand_in_place() extensions are forwarded when it has them.
+template <typename T, typename Inner = std::allocator<T>>
+class InstrumentedAllocator final
+{
+  using inner_traits = std::allocator_traits<Inner>;
+  using inner_extensions = allocator_extension_traits<Inner>;
+
+public:
+  using value_type = T;
+  using inner_allocator_type = Inner;
+  using propagate_on_container_copy_assignment =
+    typename inner_traits::propagate_on_container_copy_assignment;
+  using propagate_on_container_move_assignment =
+    typename inner_traits::propagate_on_container_move_assignment;
+  using propagate_on_container_swap = typename inner_traits::propagate_on_container_swap;
+  using is_always_equal = typename inner_traits::is_always_equal;
+
+  template <class U>
+  struct rebind
+  {
+    using other = InstrumentedAllocator<U, typename inner_traits::template rebind_alloc<U>>;
+  };
+
+  /// @brief Records in default_allocation_site().
+  InstrumentedAllocator() : site_{&default_allocation_site()} {}
+  explicit InstrumentedAllocator(AllocationSite& site, const Inner& inner = Inner{})
+      : inner_{inner}
+      , site_{&site}
+  {
+  }
+  template <class U, class OtherInner>
+  InstrumentedAllocator(const InstrumentedAllocator<U, OtherInner>& other) noexcept
+      : inner_{other.inner()}
+      , site_{&other.site()}
+  {
+  }
+  InstrumentedAllocator(const InstrumentedAllocator&) = default;
+  InstrumentedAllocator(InstrumentedAllocator&&) noexcept = default;
+  InstrumentedAllocator& operator=(const InstrumentedAllocator&) = default;
+  InstrumentedAllocator& operator=(InstrumentedAllocator&&) noexcept = default;
+  ~InstrumentedAllocator() = default;
+
+  T* allocate(std::size_t n)
+  {
+    auto p = inner_traits::allocate(inner_, n);
+    site_->record_allocation(n * sizeof(T));
+    return p;
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    site_->record_deallocation(n * sizeof(T));
+    inner_traits::deallocate(inner_, p, n);
+  }
+
+  // Allocator extensions (see allocator_extensions.h), available when the inner allocator has them
+  template <typename I = Inner,
+            typename = std::enable_if_t<allocator_extension_traits<I>::has_expand_in_place>>
+  bool expand_in_place(T* p, std::size_t old_count, std::size_t new_count) noexcept
+  {
+    if (!inner_extensions::expand_in_place(inner_, p, old_count, new_count))
+    {
+      return false;
+    }
+
+    site_->record_reallocation(old_count * sizeof(T), new_count * sizeof(T));
+    return true;
+  }
+
+  template <typename I = Inner,
+            typename = std::enable_if_t<allocator_extension_traits<I>::has_reallocate>>
+  T* reallocate(T* p, std::size_t old_count, std::size_t new_count)
+  {
+    auto result = inner_extensions::reallocate(inner_, p, old_count, new_count);
+    site_->record_reallocation(old_count * sizeof(T), new_count * sizeof(T));
+    return result;
+  }
+
+  void on_growth(std::size_t size, std::size_t old_capacity, std::size_t new_capacity) noexcept
+  {
+    site_->record_growth(old_capacity * sizeof(T), new_capacity * sizeof(T));
+    inner_extensions::on_growth(inner_, size, old_capacity, new_capacity);
+  }
+
+  InstrumentedAllocator select_on_container_copy_construction() const
+  {
+    return InstrumentedAllocator{*site_,
+                                 inner_traits::select_on_container_copy_construction(inner_)};
+  }
+
+  const Inner& inner() const noexcept { return inner_; }
+  AllocationSite& site() const noexcept { return *site_; }
+
+private:
+  Inner inner_;
+  AllocationSite* site_;
+};
+
+template <typename T, typename TInner, typename U, typename UInner>
+bool operator==(const InstrumentedAllocator<T, TInner>& lhs,
+                const InstrumentedAllocator<U, UInner>& rhs) noexcept
+{
+  return lhs.inner() == rhs.inner();
+}
+
+template <typename T, typename TInner, typename U, typename UInner>
+bool operator!=(const InstrumentedAllocator<T, TInner>& lhs,
+                const InstrumentedAllocator<U, UInner>& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+} // namespace CppTraining
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+namespace CppTraining
+{
+/// @brief Stateless allocator backed by malloc/realloc/free. Implements both allocator extensions
+/// (see allocator_extensions.h): reallocate() forwards to realloc, and expand_in_place() forwards
+/// to _expand where the C runtime has it (MSVC) and fails elsewhere.
+template <typename T>
+class MallocAllocator final
+{
+public:
+  using value_type = T;
+  using is_always_equal = std::true_type;
+
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "MallocAllocator does not support over-aligned types");
+
+  MallocAllocator() = default;
+  template <class U>
+  MallocAllocator(const MallocAllocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    auto p = std::malloc(n * sizeof(T));
+    if (p == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, std::size_t) noexcept { std::free(p); }
+
+  T* reallocate(T* p, std::size_t, std::size_t new_count)
+  {
+    auto result = std::realloc(static_cast<void*>(p), new_count * sizeof(T));
+    if (result == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    return static_cast<T*>(result);
+  }
+
+  /// @brief malloc_usable_size (glibc) and malloc_size (macOS) would report slack after the block,
+  /// but writing into it is not allowed: glibc documents the size as diagnostic only, and
+  /// _FORTIFY_SOURCE=3 checks writes against the size requested. Growth goes through reallocate()
+  /// there instead.
+  bool expand_in_place(T* p, std::size_t old_count, std::size_t new_count) noexcept
+  {
+#if defined(_MSC_VER)
+    (void)old_count;
+    return _expand(p, new_count * sizeof(T)) != nullptr;
+#else
+    (void)p;
+    (void)old_count;
+    (void)new_count;
+    return false;
+#endif
+  }
+};
+
+template <typename T, typename U>
+bool operator==(const MallocAllocator<T>&, const MallocAllocator<U>&) noexcept
+{
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const MallocAllocator<T>&, const MallocAllocator<U>&) noexcept
+{
+  return false;
+}
+} // namespace CppTraining
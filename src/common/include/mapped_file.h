@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace CppTraining
+{
+/// @brief A file that holds one block of memory, mapped with mmap(MAP_SHARED) so that whatever is
+/// written to the block is in the file. The file starts with a one-page header recording where the
+/// block is and how many elements its owner stored, so that a later run can map the block again
+/// and use it as it is: pages are read from the file when they are first touched, and nothing is
+/// parsed or copied. POSIX only.
+///
+/// The block grows with ftruncate and mremap. While a container moves its elements from one block
+/// to another, both are live: the file holds at most two blocks, the second after the first, and
+/// the header follows the most recently allocated one. Deallocating the only live block leaves its
+/// bytes in the file for the next run. Not thread safe.
+class MappedFile final
+{
+public:
+  enum class Mode
+  {
+    /// Opens the file if it exists, so that the block it holds can be adopted, or creates it.
+    OpenOrCreate,
+    /// Discards whatever the file holds.
+    Truncate
+  };
+
+  /// @brief Throws std::system_error if the file cannot be opened or mapped, and
+  /// std::runtime_error if it exists but was not written by a MappedFile.
+  explicit MappedFile(const std::string& path, Mode mode = Mode::OpenOrCreate);
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&&) = delete;
+  ~MappedFile();
+
+  /// @brief Maps a new block, page aligned. Throws std::bad_alloc if the file cannot grow or two
+  /// blocks are already live.
+  void* allocate(std::size_t bytes);
+
+  /// @brief Resizes the block with ftruncate and mremap; it may move in memory but its bytes stay
+  /// where they are in the file. Throws std::bad_alloc on failure, leaving the block intact.
+  void* reallocate(void* block, std::size_t old_bytes, std::size_t new_bytes);
+
+  void deallocate(void* block) noexcept;
+
+  /// @brief The block the file held when it was opened, which the caller now owns and must
+  /// deallocate. Null if the file held none, or it was adopted or replaced already.
+  void* adopt_stored_block() noexcept;
+  /// @brief The size of the block recorded in the header.
+  std::size_t stored_bytes() const noexcept;
+  /// @brief The element count recorded in the header by the block's owner.
+  std::uint64_t stored_count() const noexcept;
+  void store_count(std::uint64_t count) noexcept;
+
+  /// @brief Writes the header and the live blocks to the file with msync. The kernel writes them
+  /// back eventually anyway; this is for when the data must survive a crash of the machine.
+  void flush();
+
+  const std::string& path() const noexcept;
+
+private:
+  struct Header;
+
+  struct Block
+  {
+    std::byte* address;
+    std::size_t offset;
+    std::size_t bytes;
+  };
+
+  std::size_t mapped_length(std::size_t bytes) const noexcept;
+  std::byte* map(std::size_t offset, std::size_t length) noexcept;
+  Block* find(void* address) noexcept;
+  void record(const Block& block) noexcept;
+  void release() noexcept;
+
+  std::string path_;
+  std::size_t page_size_;
+  int fd_{-1};
+  Header* header_{nullptr};
+
+  std::array<Block, 2> blocks_{};
+  std::size_t block_count_{0};
+  std::byte* stored_block_{nullptr};
+};
+} // namespace CppTraining
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#include "mapped_file.h"
+
+namespace CppTraining
+{
+/// @brief Allocator that serves a container's block from a MappedFile, so that the container's
+/// elements are in the file and a later run can map them back in instead of rebuilding them:
+///
+///   MappedFile file{"lookup.bin"};
+///   MappedFileAllocator<Entry> allocator{file};
+///   auto stored = allocator.adopt_stored();
+///   Vector<Entry, MappedFileAllocator<Entry>> entries{
+///     adopt_buffer, stored.data, stored.size, stored.capacity, allocator};
+///   ...
+///   allocator.store_size(entries.size());
+///
+/// Only trivially copyable elements can be read back like this. reallocate() (see
+/// allocator_extensions.h) grows the block in the file with mremap rather than copying it.
+///
+/// A file holds one container's elements, so a copy of the container is given a default
+/// constructed allocator, which allocates from the heap. Otherwise the allocator propagates like
+/// PropagatingAllocator: on copy assignment and swap, but not on move assignment.
+template <typename T>
+class MappedFileAllocator final
+{
+public:
+  using value_type = T;
+  using propagate_on_container_swap = std::true_type;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using is_always_equal = std::false_type;
+
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable elements can be read back from a file");
+  static_assert(alignof(T) <= alignof(std::max_align_t),
+                "MappedFileAllocator does not support over-aligned types");
+
+  /// @brief A block a previous run left in the file, for Vector's adopt_buffer constructor.
+  struct StoredBlock
+  {
+    T* data;
+    std::size_t size;
+    std::size_t capacity;
+  };
+
+  /// @brief Allocates from the heap.
+  MappedFileAllocator() = default;
+  explicit MappedFileAllocator(MappedFile& file) noexcept : file_{&file} {}
+  template <class U>
+  MappedFileAllocator(const MappedFileAllocator<U>& other) noexcept : file_{other.getFile()}
+  {
+  }
+  MappedFileAllocator(const MappedFileAllocator&) = default;
+  MappedFileAllocator(MappedFileAllocator&&) noexcept = default;
+  MappedFileAllocator& operator=(const MappedFileAllocator&) = default;
+  MappedFileAllocator& operator=(MappedFileAllocator&&) noexcept = default;
+  ~MappedFileAllocator() = default;
+
+  T* allocate(std::size_t n)
+  {
+    if (file_ != nullptr)
+    {
+      return static_cast<T*>(file_->allocate(n * sizeof(T)));
+    }
+
+    auto p = std::malloc(n * sizeof(T));
+    if (p == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, std::size_t) noexcept
+  {
+    if (file_ != nullptr)
+    {
+      file_->deallocate(p);
+    }
+    else
+    {
+      std::free(p);
+    }
+  }
+
+  T* reallocate(T* p, std::size_t old_count, std::size_t new_count)
+  {
+    if (file_ != nullptr)
+    {
+      return static_cast<T*>(file_->reallocate(p, old_count * sizeof(T), new_count * sizeof(T)));
+    }
+
+    auto result = std::realloc(static_cast<void*>(p), new_count * sizeof(T));
+    if (result == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    return static_cast<T*>(result);
+  }
+
+  MappedFileAllocator select_on_container_copy_construction() const noexcept
+  {
+    return MappedFileAllocator{};
+  }
+
+  /// @brief Hands over the block the file held when it was opened, with the size last stored by
+  /// store_size(). Empty if there is no file, the file held nothing, or the block was adopted or
+  /// replaced already.
+  StoredBlock adopt_stored() noexcept
+  {
+    auto data = file_ == nullptr ? nullptr : static_cast<T*>(file_->adopt_stored_block());
+    if (data == nullptr)
+    {
+      return {nullptr, 0, 0};
+    }
+
+    const auto capacity = file_->stored_bytes() / sizeof(T);
+    const auto size = std::min<std::uint64_t>(file_->stored_count(), capacity);
+    return {data, static_cast<std::size_t>(size), capacity};
+  }
+
+  /// @brief Records how many elements the block holds, for the next run's adopt_stored().
+  void store_size(std::size_t size) noexcept
+  {
+    if (file_ != nullptr)
+    {
+      file_->store_count(size);
+    }
+  }
+
+  MappedFile* getFile() const noexcept { return file_; }
+
+private:
+  MappedFile* file_{nullptr};
+};
+
+template <typename T, typename U>
+bool operator==(const MappedFileAllocator<T>& lhs, const MappedFileAllocator<U>& rhs) noexcept
+{
+  return lhs.getFile() == rhs.getFile();
+}
+
+template <typename T, typename U>
+bool operator!=(const MappedFileAllocator<T>& lhs, const MappedFileAllocator<U>& rhs) noexcept
+{
+  return !(lhs == rhs);
+}
+} // namespace CppTraining
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace CppTraining
+{
+/// @brief Linear scans over arrays of integers or floating-point numbers, vectorized with AVX2 or
+/// SSE2 when the CPU has them and plain loops otherwise. The instruction set is chosen once, at
+/// run time, so one binary runs everywhere and still uses the widest registers available. Every
+/// function gives the same result as its standard algorithm counterpart; in particular NaNs
+/// compare unequal to everything, themselves included.
+namespace simd
+{
+/// @brief The instruction sets the kernels are built for, from slowest to fastest.
+enum class InstructionSet
+{
+  Scalar,
+  Sse2,
+  Avx2
+};
+
+/// @brief The fastest instruction set that both this build and the CPU support.
+InstructionSet best_instruction_set() noexcept;
+
+/// @brief The instruction set the kernels use: best_instruction_set() unless changed.
+InstructionSet instruction_set() noexcept;
+
+/// @brief Makes the kernels use the given instruction set, or best_instruction_set() if the CPU
+/// lacks it, e.g. to compare them in benchmarks. Returns the instruction set now in use.
+InstructionSet set_instruction_set(InstructionSet instruction_set) noexcept;
+
+namespace detail
+{
+template <typename T>
+struct type_identity
+{
+  using type = T;
+};
+
+template <std::size_t Size, bool Signed>
+struct integer_of_size;
+
+template <>
+struct integer_of_size<1, true>
+{
+  using type = std::int8_t;
+};
+
+template <>
+struct integer_of_size<1, false>
+{
+  using type = std::uint8_t;
+};
+
+template <>
+struct integer_of_size<2, true>
+{
+  using type = std::int16_t;
+};
+
+template <>
+struct integer_of_size<2, false>
+{
+  using type = std::uint16_t;
+};
+
+template <>
+struct integer_of_size<4, true>
+{
+  using type = std::int32_t;
+};
+
+template <>
+struct integer_of_size<4, false>
+{
+  using type = std::uint32_t;
+};
+
+template <>
+struct integer_of_size<8, true>
+{
+  using type = std::int64_t;
+};
+
+template <>
+struct integer_of_size<8, false>
+{
+  using type = std::uint64_t;
+};
+
+template <typename T, typename = void>
+struct kernel_element
+{
+};
+
+template <typename T>
+struct kernel_element<T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    : integer_of_size<sizeof(T), std::is_signed_v<T>>
+{
+};
+
+template <>
+struct kernel_element<float>
+{
+  using type = float;
+};
+
+template <>
+struct kernel_element<double>
+{
+  using type = double;
+};
+
+template <typename T, typename = void>
+struct is_supported : std::false_type
+{
+};
+
+template <typename T>
+struct is_supported<T, std::void_t<typename kernel_element<T>::type>> : std::true_type
+{
+};
+
+// Compiled for each fixed-width integer type, float and double (see simd_algorithms.cpp)
+template <typename T>
+std::size_t find(const T* data, std::size_t size, T value) noexcept;
+template <typename T>
+std::size_t count(const T* data, std::size_t size, T value) noexcept;
+template <typename T>
+std::size_t min_element(const T* data, std::size_t size) noexcept;
+template <typename T>
+std::size_t max_element(const T* data, std::size_t size) noexcept;
+template <typename T>
+bool equal(const T* lhs, const T* rhs, std::size_t size) noexcept;
+} // namespace detail
+
+/// @brief Whether the kernels accept T: any integer type but bool, float and double. Integer types
+/// share the kernels of the fixed-width type with the same size and signedness, so e.g. char and
+/// long long work too.
+template <typename T>
+inline constexpr bool is_supported_v = detail::is_supported<T>::value;
+
+template <typename T>
+using kernel_element_t = typename detail::kernel_element<T>::type;
+
+/// @brief The index of the first element equal to value, or size if there is none.
+template <typename T, typename = std::enable_if_t<is_supported_v<T>>>
+std::size_t find(const T* data,
+                 std::size_t size,
+                 typename detail::type_identity<T>::type value) noexcept
+{
+  using Kernel = kernel_element_t<T>;
+  return detail::find(reinterpret_cast<const Kernel*>(data), size, static_cast<Kernel>(value));
+}
+
+template <typename T, typename = std::enable_if_t<is_supported_v<T>>>
+std::size_t count(const T* data,
+                  std::size_t size,
+                  typename detail::type_identity<T>::type value) noexcept
+{
+  using Kernel = kernel_element_t<T>;
+  return detail::count(reinterpret_cast<const Kernel*>(data), size, static_cast<Kernel>(value));
+}
+
+/// @brief The index of the first smallest element, as std::min_element finds it, or size if there
+/// are no elements. Like std::min_element, this skips NaNs unless the first element is one.
+template <typename T, typename = std::enable_if_t<is_supported_v<T>>>
+std::size_t min_element(const T* data, std::size_t size) noexcept
+{
+  return detail::min_element(reinterpret_cast<const kernel_element_t<T>*>(data), size);
+}
+
+/// @brief The index of the first largest element, as std::max_element finds it, or size if there
+/// are no elements.
+template <typename T, typename = std::enable_if_t<is_supported_v<T>>>
+std::size_t max_element(const T* data, std::size_t size) noexcept
+{
+  return detail::max_element(reinterpret_cast<const kernel_element_t<T>*>(data), size);
+}
+
+/// @brief Whether lhs[i] == rhs[i] for every i below size.
+template <typename T, typename = std::enable_if_t<is_supported_v<T>>>
+bool equal(const T* lhs, const T* rhs, std::size_t size) noexcept
+{
+  using Kernel = kernel_element_t<T>;
+  return detail::equal(
+    reinterpret_cast<const Kernel*>(lhs), reinterpret_cast<const Kernel*>(rhs), size);
+}
+
+// Strings. The NUL-terminated versions read whole vectors past the terminator, but never into a
+// page the string does not reach, so they cannot fault however the string is placed.
+
+/// @brief Whether two NUL-terminated strings are equal, as strcmp(lhs, rhs) == 0.
+bool string_equal(const char* lhs, const char* rhs) noexcept;
+
+/// @brief Whether two strings of known size are equal. Strings of different sizes are told apart
+/// without reading them.
+bool string_equal(const char* lhs,
+                  std::size_t lhs_size,
+                  const char* rhs,
+                  std::size_t rhs_size) noexcept;
+
+/// @brief The length of a NUL-terminated string, as strlen() returns it.
+std::size_t string_length(const char* string) noexcept;
+
+/// @brief A hash of a NUL-terminated string's characters. Equal to string_hash(string,
+/// string_length(string)), so C strings and string views of the same characters hash alike.
+std::size_t string_hash(const char* string) noexcept;
+
+/// @brief A hash of size characters. The same on every instruction set, but not across
+/// processes of different endianness or word size.
+std::size_t string_hash(const char* data, std::size_t size) noexcept;
+} // namespace simd
+} // namespace CppTraining
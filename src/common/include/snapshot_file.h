@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace CppTraining
+{
+/// @brief What a snapshot records about its elements, and checks again when it is loaded.
+struct SnapshotLayout
+{
+  std::uint64_t type_tag;
+  std::size_t element_size;
+  std::size_t alignment;
+};
+
+enum class SnapshotCheck
+{
+  /// Reads the whole payload once to compare its checksum with the one in the header.
+  Checksum,
+  /// Trusts the payload, so that no page is read before it is used.
+  HeaderOnly
+};
+
+/// @brief Writes count elements of the given layout as a snapshot: a 64-byte header (format
+/// version, byte order, type tag, element size, alignment, count and a checksum of the payload)
+/// followed by the elements' bytes as they are in memory. The payload is written in large chunks,
+/// each checksummed while it is still in the cache, to path + ".tmp", which is then renamed to
+/// path. The file is synced before the rename and its directory after it, so a reader sees either
+/// the old snapshot or the new one, even after a crash. POSIX only.
+///
+/// Throws std::system_error if the file cannot be written.
+void write_snapshot(const std::string& path,
+                    const SnapshotLayout& layout,
+                    const void* data,
+                    std::size_t count);
+
+/// @brief A snapshot mapped read-only with mmap. The payload is used where it lies in the mapping:
+/// nothing is decoded or copied, and pages are read from the file as they are touched.
+class SnapshotMapping final
+{
+public:
+  /// @brief Throws std::system_error if the file cannot be opened or mapped, and
+  /// std::runtime_error if it is not a snapshot of the given layout, was written on a machine of
+  /// another byte order, or (with SnapshotCheck::Checksum) its payload is corrupt.
+  SnapshotMapping(const std::string& path, const SnapshotLayout& layout, SnapshotCheck check);
+  SnapshotMapping(const SnapshotMapping&) = delete;
+  SnapshotMapping(SnapshotMapping&& other) noexcept;
+  SnapshotMapping& operator=(const SnapshotMapping&) = delete;
+  SnapshotMapping& operator=(SnapshotMapping&& other) noexcept;
+  ~SnapshotMapping();
+
+  /// @brief The first element; null if there are none.
+  const void* data() const noexcept;
+  std::size_t count() const noexcept;
+
+private:
+  void release() noexcept;
+
+  void* address_{nullptr};
+  std::size_t length_{0};
+  const std::byte* payload_{nullptr};
+  std::size_t count_{0};
+};
+} // namespace CppTraining
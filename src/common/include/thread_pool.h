@@ -0,0 +1,180 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "work_stealing_deque.h"
+
+namespace CppTraining
+{
+struct ThreadPoolOptions
+{
+  /// @brief Zero means one worker per hardware thread.
+  std::size_t worker_count{0};
+
+  /// @brief Pins worker i to CPU cpus[i % cpus.size()], so that a worker keeps its caches warm and
+  /// does not migrate between NUMA nodes. An empty cpus means the CPUs the process may run on (its
+  /// affinity mask on Linux). Supported on Linux and Windows; elsewhere workers are left unpinned.
+  bool pin_workers{false};
+  std::vector<std::size_t> cpus;
+};
+
+/// @brief A fixed set of worker threads, each with a WorkStealingDeque of tasks. A worker runs the
+/// tasks it spawns itself, newest first, and steals the oldest task of a random other worker when
+/// it has none. Tasks submitted from outside the pool go through a shared queue. Idle workers spin
+/// briefly and then sleep until there is work.
+///
+/// Threads waiting for a parallel_for() run its pieces themselves instead of just blocking, so
+/// parallel_for() may be nested (e.g. a parallel sort calling a parallel merge) without running out
+/// of workers.
+class ThreadPool final
+{
+public:
+  ThreadPool();
+
+  /// @brief Throws std::system_error if a thread cannot be started or pinned.
+  explicit ThreadPool(ThreadPoolOptions options);
+
+  /// @brief Unpinned workers; zero means one per hardware thread.
+  explicit ThreadPool(std::size_t worker_count);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// @brief Runs every task already submitted, then joins the workers.
+  ~ThreadPool();
+
+  /// @brief The pool the parallel algorithms use unless given another: one worker per hardware
+  /// thread, created on first use and never destroyed.
+  static ThreadPool& global();
+
+  std::size_t worker_count() const noexcept;
+
+  /// @brief The calling thread's index among this pool's workers, if it is one of them.
+  std::optional<std::size_t> current_worker() const noexcept;
+
+  /// @brief Runs function() on a worker. The future holds its result, or the exception it threw.
+  template <typename Function>
+  std::future<std::invoke_result_t<std::decay_t<Function>>> submit(Function&& function)
+  {
+    using Result = std::invoke_result_t<std::decay_t<Function>>;
+
+    std::packaged_task<Result()> task{std::forward<Function>(function)};
+    auto future = task.get_future();
+    schedule(std::make_unique<CallableTask<std::packaged_task<Result()>>>(std::move(task)));
+
+    return future;
+  }
+
+  /// @brief Calls body(first, last) on subranges that together cover [first, last) once, and
+  /// returns when all of them are done. Subranges have at most grain_size indices; zero picks a
+  /// size that gives each worker several subranges to balance the load. Ranges are split in halves
+  /// on demand, so an idle worker steals half of the biggest remaining piece of work.
+  ///
+  /// If body throws, subranges not yet started are skipped and the first exception is rethrown
+  /// once the others have finished.
+  template <typename Body>
+  void parallel_for_ranges(std::size_t first,
+                           std::size_t last,
+                           Body&& body,
+                           std::size_t grain_size = 0)
+  {
+    if (first >= last)
+    {
+      return;
+    }
+
+    auto& callable = body;
+    using Callable = std::remove_reference_t<decltype(callable)>;
+    run_loop(first,
+             last,
+             grain_size,
+             const_cast<void*>(static_cast<const void*>(std::addressof(callable))),
+             [](void* context, std::size_t range_first, std::size_t range_last) {
+               (*static_cast<Callable*>(context))(range_first, range_last);
+             });
+  }
+
+  /// @brief Calls body(i) for every i in [first, last), as parallel_for_ranges() does.
+  template <typename Body>
+  void parallel_for(std::size_t first, std::size_t last, Body&& body, std::size_t grain_size = 0)
+  {
+    parallel_for_ranges(
+      first,
+      last,
+      [&body](std::size_t range_first, std::size_t range_last) {
+        for (auto i = range_first; i < range_last; ++i)
+        {
+          body(i);
+        }
+      },
+      grain_size);
+  }
+
+private:
+  struct Task
+  {
+    virtual ~Task() = default;
+    virtual void run() = 0;
+  };
+
+  template <typename Callable>
+  struct CallableTask final : Task
+  {
+    explicit CallableTask(Callable callable) : callable{std::move(callable)} {}
+
+    void run() override { callable(); }
+
+    Callable callable;
+  };
+
+  using LoopBody = void (*)(void* context, std::size_t first, std::size_t last);
+  struct Loop;
+  class RangeTask;
+  struct Worker;
+
+  void start(std::size_t index, const ThreadPoolOptions& options);
+  void stop() noexcept;
+  void work(std::size_t index);
+
+  /// @brief Queues a task: on the calling worker's own deque, or the shared queue for threads from
+  /// outside the pool.
+  void schedule(std::unique_ptr<Task> task);
+  void wake_sleeper() noexcept;
+
+  /// @brief The calling thread's next task: its own newest one if it is a worker, then the oldest
+  /// in the shared queue, then one stolen from another worker.
+  Task* find_task(std::optional<std::size_t> worker) noexcept;
+  void run(Task* task) noexcept;
+
+  void run_loop(std::size_t first,
+                std::size_t last,
+                std::size_t grain_size,
+                void* context,
+                LoopBody body);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  std::mutex shared_mutex_;
+  std::deque<Task*> shared_tasks_;
+  std::atomic<std::size_t> shared_size_{0};
+
+  // Sleeping workers wait for epoch_ to change; see work() and wake_sleeper()
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_condition_;
+  std::uint64_t epoch_{0};
+  std::atomic<std::size_t> sleeping_{0};
+  std::atomic<bool> stopping_{false};
+};
+} // namespace CppTraining
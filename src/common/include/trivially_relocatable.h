@@ -0,0 +1,18 @@
+#pragma once
+
+#include <type_traits>
+
+namespace CppTraining
+{
+/// @brief Identifies types whose objects can be relocated with memcpy: the bytes are copied to new
+/// storage and the source is simply forgotten, with neither the move constructor nor the
+/// destructor being called. Defaults to std::is_trivially_copyable; specialize it for types that
+/// own resources through plain pointers and hold no self-references (e.g. Foo).
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+} // namespace CppTraining
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace CppTraining
+{
+/// @brief The Chase-Lev work-stealing deque, with the memory orders of Lê et al., "Correct and
+/// Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013). One owner thread pushes and pops
+/// at the bottom, last in first out, so that it works on the data it touched most recently; any
+/// number of thieves steal from the top, taking the oldest items, which in divide-and-conquer work
+/// are the largest. Pushing and popping take no locks and, unless the deque is almost empty, no
+/// read-modify-write instructions.
+///
+/// T must be trivially copyable and is usually a pointer. The ring buffer grows as needed; old
+/// buffers are kept until the deque is destroyed, since a thief may still be reading one.
+template <typename T>
+class WorkStealingDeque final
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Items are copied in and out with plain atomics");
+
+public:
+  static constexpr std::size_t DefaultCapacity = 256;
+
+  /// @brief capacity is rounded up to a power of two.
+  explicit WorkStealingDeque(std::size_t capacity = DefaultCapacity)
+  {
+    std::size_t rounded = 1;
+    while (rounded < capacity)
+    {
+      rounded *= 2;
+    }
+
+    buffers_.push_back(std::make_unique<Buffer>(rounded));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque(WorkStealingDeque&&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(WorkStealingDeque&&) = delete;
+
+  /// @brief Owner only.
+  void push(T item)
+  {
+    const auto bottom = bottom_.load(std::memory_order_relaxed);
+    const auto top = top_.load(std::memory_order_acquire);
+    auto* buffer = buffer_.load(std::memory_order_relaxed);
+
+    if (bottom - top > static_cast<std::int64_t>(buffer->capacity) - 1)
+    {
+      buffer = grow(buffer, top, bottom);
+    }
+
+    buffer->put(bottom, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /// @brief Owner only. Takes the most recently pushed item.
+  std::optional<T> pop() noexcept
+  {
+    const auto bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    auto* buffer = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom)
+    {
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+
+    std::optional<T> item{buffer->get(bottom)};
+    if (top == bottom)
+    {
+      // The last item: whoever moves top past it, this thread or a thief, gets it
+      if (!top_.compare_exchange_strong(
+            top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+      {
+        item.reset();
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return item;
+  }
+
+  /// @brief Any thread. Takes the oldest item, or nothing if the deque is empty or another thread
+  /// took the item first.
+  std::optional<T> steal() noexcept
+  {
+    auto top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const auto bottom = bottom_.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+    {
+      return std::nullopt;
+    }
+
+    // The paper's consume load; acquire is what compilers turn consume into anyway
+    auto* buffer = buffer_.load(std::memory_order_acquire);
+    const T item = buffer->get(top);
+    if (!top_.compare_exchange_strong(
+          top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+      return std::nullopt;
+    }
+
+    return item;
+  }
+
+  /// @brief A snapshot that may be out of date by the time it returns, unless only the owner is
+  /// using the deque.
+  std::size_t size() const noexcept
+  {
+    const auto bottom = bottom_.load(std::memory_order_relaxed);
+    const auto top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+  }
+
+  bool empty() const noexcept { return size() == 0; }
+
+  std::size_t capacity() const noexcept
+  {
+    return buffer_.load(std::memory_order_relaxed)->capacity;
+  }
+
+private:
+  struct Buffer
+  {
+    explicit Buffer(std::size_t capacity)
+        : capacity{capacity}
+        , items{std::make_unique<std::atomic<T>[]>(capacity)}
+    {
+    }
+
+    T get(std::int64_t index) const noexcept
+    {
+      return items[static_cast<std::size_t>(index) & (capacity - 1)].load(
+        std::memory_order_relaxed);
+    }
+
+    void put(std::int64_t index, T item) noexcept
+    {
+      items[static_cast<std::size_t>(index) & (capacity - 1)].store(item,
+                                                                     std::memory_order_relaxed);
+    }
+
+    std::size_t capacity;
+    std::unique_ptr<std::atomic<T>[]> items;
+  };
+
+  Buffer* grow(Buffer* buffer, std::int64_t top, std::int64_t bottom)
+  {
+    auto bigger = std::make_unique<Buffer>(buffer->capacity * 2);
+    for (auto index = top; index < bottom; ++index)
+    {
+      bigger->put(index, buffer->get(index));
+    }
+
+    buffers_.push_back(std::move(bigger));
+    buffer = buffers_.back().get();
+    buffer_.store(buffer, std::memory_order_release);
+
+    return buffer;
+  }
+
+  // Thieves hammer top_ while the owner works at bottom_, so they live on separate cache lines
+  alignas(64) std::atomic<std::int64_t> top_{0};
+  alignas(64) std::atomic<std::int64_t> bottom_{0};
+  std::atomic<Buffer*> buffer_{nullptr};
+
+  // Owner only: every buffer ever used, the current one last
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+} // namespace CppTraining
@@ -0,0 +1,249 @@
+#include "allocation_stats.h"
+
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <utility>
+
+namespace CppTraining
+{
+namespace
+{
+void writeJsonString(std::ostream& stream, std::string_view value)
+{
+  static constexpr char HexDigits[] = "0123456789abcdef";
+
+  stream << '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+    case '"':
+      stream << "\\\"";
+      break;
+    case '\\':
+      stream << "\\\\";
+      break;
+    case '\n':
+      stream << "\\n";
+      break;
+    case '\r':
+      stream << "\\r";
+      break;
+    case '\t':
+      stream << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        stream << "\\u00" << HexDigits[(c >> 4) & 0xf] << HexDigits[c & 0xf];
+      }
+      else
+      {
+        stream << c;
+      }
+    }
+  }
+  stream << '"';
+}
+
+void writeJson(std::ostream& stream, const AllocationSiteStats& stats)
+{
+  stream << "    {\n      \"name\": ";
+  writeJsonString(stream, stats.name);
+  stream << ",\n      \"allocations\": " << stats.allocations
+         << ",\n      \"deallocations\": " << stats.deallocations
+         << ",\n      \"reallocations\": " << stats.reallocations
+         << ",\n      \"bytes_allocated\": " << stats.bytes_allocated
+         << ",\n      \"bytes_deallocated\": " << stats.bytes_deallocated
+         << ",\n      \"live_bytes\": " << stats.live_bytes
+         << ",\n      \"peak_live_bytes\": " << stats.peak_live_bytes
+         << ",\n      \"growth_events\": " << stats.growth_events
+         << ",\n      \"growth_bytes\": " << stats.growth_bytes << ",\n      \"size_histogram\": [";
+
+  // Only the buckets that saw a request, each labelled with its upper bound
+  const char* separator = "";
+  for (std::size_t bucket = 0; bucket < AllocationSiteStats::SizeBuckets; ++bucket)
+  {
+    if (stats.size_histogram[bucket] == 0)
+    {
+      continue;
+    }
+
+    stream << separator << "{\"max_bytes\": ";
+    if (const auto limit = AllocationSiteStats::bucket_limit(bucket))
+    {
+      stream << *limit;
+    }
+    else
+    {
+      stream << "null";
+    }
+    stream << ", \"count\": " << stats.size_histogram[bucket] << '}';
+    separator = ", ";
+  }
+
+  stream << "]\n    }";
+}
+
+std::atomic<std::uint64_t> next_site_id{1};
+} // namespace
+
+AllocationSite::AllocationSite(std::string name)
+    : id_{next_site_id.fetch_add(1, std::memory_order_relaxed)}
+    , name_{std::move(name)}
+{
+}
+
+AllocationSite::~AllocationSite()
+{
+  for (auto counters = threads_.load(std::memory_order_acquire); counters != nullptr;)
+  {
+    delete std::exchange(counters, counters->next);
+  }
+}
+
+const std::string& AllocationSite::name() const noexcept
+{
+  return name_;
+}
+
+AllocationSiteStats AllocationSite::snapshot() const
+{
+  AllocationSiteStats stats;
+  stats.name = name_;
+
+  auto accumulate = [&stats](const ThreadCounters& counters) {
+    stats.allocations += counters.allocations.load(std::memory_order_relaxed);
+    stats.deallocations += counters.deallocations.load(std::memory_order_relaxed);
+    stats.reallocations += counters.reallocations.load(std::memory_order_relaxed);
+    stats.bytes_allocated += counters.bytes_allocated.load(std::memory_order_relaxed);
+    stats.bytes_deallocated += counters.bytes_deallocated.load(std::memory_order_relaxed);
+    stats.growth_events += counters.growth_events.load(std::memory_order_relaxed);
+    stats.growth_bytes += counters.growth_bytes.load(std::memory_order_relaxed);
+    for (std::size_t bucket = 0; bucket < AllocationSiteStats::SizeBuckets; ++bucket)
+    {
+      stats.size_histogram[bucket] +=
+        counters.size_histogram[bucket].load(std::memory_order_relaxed);
+    }
+  };
+
+  for (auto counters = threads_.load(std::memory_order_acquire); counters != nullptr;
+       counters = counters->next)
+  {
+    accumulate(*counters);
+  }
+  accumulate(fallback_);
+
+  stats.live_bytes = live_bytes_.load(std::memory_order_relaxed);
+  stats.peak_live_bytes = peak_live_bytes_.load(std::memory_order_relaxed);
+
+  return stats;
+}
+
+AllocationSite::ThreadCounters& AllocationSite::find_thread_counters() noexcept
+{
+  const auto thread = std::this_thread::get_id();
+
+  auto head = threads_.load(std::memory_order_acquire);
+  for (auto counters = head; counters != nullptr; counters = counters->next)
+  {
+    if (counters->owner == thread)
+    {
+      return *counters;
+    }
+  }
+
+  auto counters = new (std::nothrow) ThreadCounters{thread};
+  if (counters == nullptr)
+  {
+    return fallback_;
+  }
+
+  // Only the calling thread adds counters for itself, so anything pushed meanwhile belongs to
+  // other threads and need not be searched again
+  counters->next = head;
+  while (!threads_.compare_exchange_weak(
+    counters->next, counters, std::memory_order_release, std::memory_order_relaxed))
+  {
+  }
+
+  return *counters;
+}
+
+AllocationStatsRegistry& AllocationStatsRegistry::global()
+{
+  static auto registry = new AllocationStatsRegistry;
+  return *registry;
+}
+
+AllocationSite& AllocationStatsRegistry::site(std::string_view name)
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+
+  auto it = sites_.find(name);
+  if (it == sites_.end())
+  {
+    std::string key{name};
+    auto site = std::make_unique<AllocationSite>(key);
+    it = sites_.emplace(std::move(key), std::move(site)).first;
+  }
+
+  return *it->second;
+}
+
+std::optional<AllocationSiteStats> AllocationStatsRegistry::find(std::string_view name) const
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+
+  auto it = sites_.find(name);
+  if (it == sites_.end())
+  {
+    return std::nullopt;
+  }
+
+  return it->second->snapshot();
+}
+
+std::vector<AllocationSiteStats> AllocationStatsRegistry::snapshot() const
+{
+  std::lock_guard<std::mutex> lock{mutex_};
+
+  std::vector<AllocationSiteStats> result;
+  result.reserve(sites_.size());
+  for (const auto& [name, site] : sites_)
+  {
+    result.push_back(site->snapshot());
+  }
+
+  return result;
+}
+
+void AllocationStatsRegistry::write_json(std::ostream& stream) const
+{
+  const auto sites = snapshot();
+
+  stream << "{\n  \"sites\": [";
+  const char* separator = "\n";
+  for (const auto& stats : sites)
+  {
+    stream << separator;
+    writeJson(stream, stats);
+    separator = ",\n";
+  }
+  stream << (sites.empty() ? "]\n}\n" : "\n  ]\n}\n");
+}
+
+std::string AllocationStatsRegistry::to_json() const
+{
+  std::ostringstream stream;
+  write_json(stream);
+  return stream.str();
+}
+
+AllocationSite& default_allocation_site()
+{
+  static AllocationSite& site = AllocationStatsRegistry::global().site("default");
+  return site;
+}
+} // namespace CppTraining
@@ -0,0 +1,144 @@
+#include "arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+namespace CppTraining
+{
+Arena::Arena(std::size_t chunk_size) : chunk_size_{chunk_size} {}
+
+Arena::Arena(void* buffer, std::size_t buffer_size, std::size_t chunk_size)
+    : buffer_{static_cast<std::byte*>(buffer)}
+    , buffer_size_{buffer_size}
+    , chunk_size_{chunk_size}
+    , current_{buffer_}
+    , end_{buffer_ + buffer_size}
+{
+}
+
+Arena::~Arena()
+{
+  release();
+}
+
+void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+{
+  if (auto p = try_allocate(bytes, alignment))
+  {
+    return p;
+  }
+
+  use_next_chunk(bytes, alignment);
+
+  return try_allocate(bytes, alignment);
+}
+
+void Arena::reset() noexcept
+{
+  current_chunk_ = nullptr;
+  current_ = buffer_;
+  end_ = buffer_ + buffer_size_;
+  bytes_allocated_ = 0;
+}
+
+void Arena::release() noexcept
+{
+  while (chunks_ != nullptr)
+  {
+    auto next = chunks_->next;
+    ::operator delete(chunks_);
+    chunks_ = next;
+  }
+
+  reset();
+}
+
+std::size_t Arena::bytes_allocated() const noexcept
+{
+  return bytes_allocated_;
+}
+
+std::size_t Arena::chunk_count() const noexcept
+{
+  std::size_t count = 0;
+  for (auto chunk = chunks_; chunk != nullptr; chunk = chunk->next)
+  {
+    ++count;
+  }
+
+  return count;
+}
+
+std::byte* Arena::chunk_begin(Chunk* chunk) noexcept
+{
+  return reinterpret_cast<std::byte*>(chunk) + sizeof(Chunk);
+}
+
+std::byte* Arena::chunk_end(Chunk* chunk) noexcept
+{
+  return reinterpret_cast<std::byte*>(chunk) + chunk->size;
+}
+
+void* Arena::try_allocate(std::size_t bytes, std::size_t alignment) noexcept
+{
+  if (current_ == nullptr)
+  {
+    return nullptr;
+  }
+
+  auto address = reinterpret_cast<std::uintptr_t>(current_);
+  auto aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+  auto padding = aligned - address;
+
+  if (padding + bytes > static_cast<std::size_t>(end_ - current_))
+  {
+    return nullptr;
+  }
+
+  current_ += padding + bytes;
+  bytes_allocated_ += bytes;
+
+  return reinterpret_cast<void*>(aligned);
+}
+
+void Arena::use_next_chunk(std::size_t bytes, std::size_t alignment)
+{
+  const std::size_t required = sizeof(Chunk) + bytes + alignment;
+
+  // Reuse chunks kept by reset() before asking the global allocator for more
+  auto candidate = current_chunk_ == nullptr ? chunks_ : current_chunk_->next;
+  Chunk* previous = current_chunk_;
+  while (candidate != nullptr && candidate->size < required)
+  {
+    previous = candidate;
+    candidate = candidate->next;
+  }
+
+  if (candidate == nullptr)
+  {
+    const std::size_t size = std::max(chunk_size_, required);
+    candidate = static_cast<Chunk*>(::operator new(size));
+    candidate->next = nullptr;
+    candidate->size = size;
+
+    if (previous == nullptr)
+    {
+      chunks_ = candidate;
+    }
+    else
+    {
+      // Append after the skipped chunks so that the chain keeps its order
+      while (previous->next != nullptr)
+      {
+        previous = previous->next;
+      }
+      previous->next = candidate;
+    }
+  }
+
+  current_chunk_ = candidate;
+  current_ = chunk_begin(candidate);
+  end_ = chunk_end(candidate);
+}
+} // namespace CppTraining
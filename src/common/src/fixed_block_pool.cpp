@@ -0,0 +1,128 @@
+#include "fixed_block_pool.h"
+
+#include <algorithm>
+#include <iterator>
+#include <new>
+
+namespace CppTraining
+{
+FixedBlockPool::FixedBlockPool(std::size_t block_size,
+                               std::size_t block_alignment,
+                               std::size_t blocks_per_chunk)
+    : block_alignment_{std::max(block_alignment, alignof(FreeBlock))}
+    , block_size_{(std::max(block_size, sizeof(FreeBlock)) + block_alignment_ - 1) /
+                  block_alignment_ * block_alignment_}
+    , blocks_per_chunk_{std::max<std::size_t>(1, blocks_per_chunk)}
+{
+}
+
+FixedBlockPool::~FixedBlockPool()
+{
+  if (!all_blocks_returned())
+  {
+    return;
+  }
+
+  for (auto chunk : chunks_)
+  {
+    ::operator delete(chunk, std::align_val_t{block_alignment_});
+  }
+}
+
+void* FixedBlockPool::allocate()
+{
+  if (free_list_ != nullptr)
+  {
+    auto block = free_list_;
+    free_list_ = block->next;
+    ++blocks_in_use_;
+
+    return block;
+  }
+
+  if (unused_ == unused_end_)
+  {
+    add_chunk();
+  }
+
+  auto block = unused_;
+  unused_ += block_size_;
+  ++blocks_carved_;
+  ++blocks_in_use_;
+
+  return block;
+}
+
+void FixedBlockPool::deallocate(void* block) noexcept
+{
+  if (block == nullptr)
+  {
+    return;
+  }
+
+  free_list_ = ::new (block) FreeBlock{free_list_};
+  --blocks_in_use_;
+}
+
+std::size_t FixedBlockPool::block_size() const noexcept
+{
+  return block_size_;
+}
+
+std::size_t FixedBlockPool::blocks_in_use() const noexcept
+{
+  return blocks_in_use_;
+}
+
+std::size_t FixedBlockPool::chunk_count() const noexcept
+{
+  return chunks_.size();
+}
+
+void FixedBlockPool::add_chunk()
+{
+  const std::size_t chunk_bytes = block_size_ * blocks_per_chunk_;
+
+  chunks_.reserve(chunks_.size() + 1);
+  auto chunk =
+    static_cast<std::byte*>(::operator new(chunk_bytes, std::align_val_t{block_alignment_}));
+  chunks_.push_back(chunk);
+
+  unused_ = chunk;
+  unused_end_ = chunk + chunk_bytes;
+}
+
+bool FixedBlockPool::all_blocks_returned() const
+{
+  if (blocks_carved_ == 0)
+  {
+    return true;
+  }
+
+  try
+  {
+    // The free list may also hold blocks from other pools, so count only the ones that lie in
+    // this pool's chunks
+    std::vector<std::byte*> chunks{chunks_};
+    std::sort(chunks.begin(), chunks.end());
+
+    const std::size_t chunk_bytes = block_size_ * blocks_per_chunk_;
+    std::size_t returned = 0;
+    for (auto block = free_list_; block != nullptr; block = block->next)
+    {
+      auto address = reinterpret_cast<std::byte*>(block);
+      auto chunk = std::upper_bound(chunks.begin(), chunks.end(), address);
+      if (chunk != chunks.begin() && address < *std::prev(chunk) + chunk_bytes)
+      {
+        ++returned;
+      }
+    }
+
+    return returned == blocks_carved_;
+  }
+  catch (const std::bad_alloc&)
+  {
+    return false;
+  }
+}
+} // namespace CppTraining
@@ -2,11 +2,47 @@
 
 #include <cassert>
 
+#if defined(CPP_TRAINING_FOO_USE_POOL)
+#include <new>
+
+#include "fixed_block_pool.h"
+#endif
+
 namespace CppTraining
 {
-Foo::Foo(std::int32_t data) : data_{new std::int32_t(data)} {}
+namespace
+{
+#if defined(CPP_TRAINING_FOO_USE_POOL)
+FixedBlockPool& dataPool()
+{
+  return thread_local_pool<sizeof(std::int32_t), alignof(std::int32_t)>();
+}
+
+std::int32_t* allocateData(std::int32_t data)
+{
+  return ::new (dataPool().allocate()) std::int32_t(data);
+}
 
-Foo::Foo(const Foo& rhs) : data_{new std::int32_t(*rhs.data_)} {}
+void deallocateData(std::int32_t* data) noexcept
+{
+  dataPool().deallocate(data);
+}
+#else
+std::int32_t* allocateData(std::int32_t data)
+{
+  return new std::int32_t(data);
+}
+
+void deallocateData(std::int32_t* data) noexcept
+{
+  delete data;
+}
+#endif
+} // namespace
+
+Foo::Foo(std::int32_t data) : data_{allocateData(data)} {}
+
+Foo::Foo(const Foo& rhs) : data_{allocateData(*rhs.data_)} {}
 
 Foo::Foo(Foo&& rhs) noexcept : data_{rhs.data_}
 {
@@ -15,7 +51,17 @@ Foo::Foo(Foo&& rhs) noexcept : data_{rhs.data_}
 
 Foo& Foo::operator=(const Foo& rhs)
 {
-  if (this != &rhs)
+  if (this == &rhs)
+  {
+    return *this;
+  }
+
+  // A moved-from Foo has no data to overwrite
+  if (data_ == nullptr)
+  {
+    data_ = allocateData(*rhs.data_);
+  }
+  else
   {
     *data_ = *rhs.data_;
   }
@@ -27,7 +73,7 @@ Foo& Foo::operator=(Foo&& rhs) noexcept
 {
   if (this != &rhs)
   {
-    delete data_;
+    deallocateData(data_);
     data_ = rhs.data_;
     rhs.data_ = nullptr;
   }
@@ -37,7 +83,7 @@ Foo& Foo::operator=(Foo&& rhs) noexcept
 
 Foo::~Foo()
 {
-  delete data_;
+  deallocateData(data_);
 }
 
 bool Foo::operator==(const Foo& rhs) const
@@ -0,0 +1,183 @@
+#include "huge_pages.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace CppTraining
+{
+namespace huge_pages
+{
+namespace
+{
+#if defined(__linux__)
+std::size_t mapped_length(std::size_t bytes) noexcept
+{
+  return (bytes + PageSize - 1) / PageSize * PageSize;
+}
+
+/// @brief Maps length bytes of anonymous memory at a 2 MiB boundary, by mapping a page more than
+/// needed and unmapping the slack on either side.
+std::byte* map_aligned(std::size_t length) noexcept
+{
+  auto mapping =
+    ::mmap(nullptr, length + PageSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED)
+  {
+    return nullptr;
+  }
+
+  const auto address = reinterpret_cast<std::uintptr_t>(mapping);
+  const auto aligned = (address + PageSize - 1) & ~(PageSize - 1);
+  const auto head = aligned - address;
+  if (head != 0)
+  {
+    ::munmap(mapping, head);
+  }
+  ::munmap(reinterpret_cast<void*>(aligned + length), PageSize - head);
+
+  return reinterpret_cast<std::byte*>(aligned);
+}
+
+std::byte* map(std::size_t length) noexcept
+{
+#if defined(MAP_HUGE_2MB)
+  constexpr int HugeTlbFlags = MAP_HUGETLB | MAP_HUGE_2MB;
+#else
+  constexpr int HugeTlbFlags = MAP_HUGETLB;
+#endif
+
+  constexpr int Flags = MAP_PRIVATE | MAP_ANONYMOUS | HugeTlbFlags;
+  auto mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, Flags, -1, 0);
+  if (mapping != MAP_FAILED)
+  {
+    return static_cast<std::byte*>(mapping);
+  }
+
+  // No reserved huge pages: ask for transparent ones. The memory is usable even if the advice is
+  // not taken.
+  auto aligned = map_aligned(length);
+  if (aligned != nullptr)
+  {
+    ::madvise(aligned, length, MADV_HUGEPAGE);
+  }
+  return aligned;
+}
+
+/// @brief Moves a block between the heap and a mapping, or between mappings that mremap cannot
+/// move, by copying it.
+void* copy_to_new_block(void* block, std::size_t old_bytes, std::size_t new_bytes)
+{
+  auto new_block = allocate(new_bytes);
+  std::memcpy(new_block, block, std::min(old_bytes, new_bytes));
+  deallocate(block, old_bytes);
+  return new_block;
+}
+#endif
+} // namespace
+
+void* allocate(std::size_t bytes)
+{
+#if defined(__linux__)
+  if (is_mapped(bytes))
+  {
+    auto block = map(mapped_length(bytes));
+    if (block == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    return block;
+  }
+#endif
+
+  auto block = std::malloc(std::max<std::size_t>(bytes, 1));
+  if (block == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+
+  return block;
+}
+
+void deallocate(void* block, std::size_t bytes) noexcept
+{
+#if defined(__linux__)
+  if (is_mapped(bytes))
+  {
+    ::munmap(block, mapped_length(bytes));
+    return;
+  }
+#else
+  static_cast<void>(bytes);
+#endif
+
+  std::free(block);
+}
+
+void* reallocate(void* block, std::size_t old_bytes, std::size_t new_bytes)
+{
+#if defined(__linux__)
+  if (is_mapped(old_bytes) != is_mapped(new_bytes))
+  {
+    return copy_to_new_block(block, old_bytes, new_bytes);
+  }
+
+  if (is_mapped(old_bytes))
+  {
+    const auto old_length = mapped_length(old_bytes);
+    const auto new_length = mapped_length(new_bytes);
+    if (new_length <= old_length)
+    {
+      if (new_length < old_length)
+      {
+        ::munmap(static_cast<std::byte*>(block) + new_length, old_length - new_length);
+      }
+      return block;
+    }
+
+    // Grow where the block is if the address space after it is free, and otherwise move its
+    // pages to a new aligned range; the bytes are not copied either way
+    auto grown = ::mremap(block, old_length, new_length, 0);
+    if (grown != MAP_FAILED)
+    {
+      return grown;
+    }
+
+    auto target = map_aligned(new_length);
+    if (target == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    auto moved = ::mremap(block, old_length, new_length, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+    if (moved == MAP_FAILED)
+    {
+      // Reserved huge pages cannot always be moved
+      ::munmap(target, new_length);
+      return copy_to_new_block(block, old_bytes, new_bytes);
+    }
+
+    ::madvise(moved, new_length, MADV_HUGEPAGE);
+    return moved;
+  }
+#else
+  static_cast<void>(old_bytes);
+#endif
+
+  auto result = std::realloc(block, std::max<std::size_t>(new_bytes, 1));
+  if (result == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+
+  return result;
+}
+} // namespace huge_pages
+} // namespace CppTraining
@@ -0,0 +1,338 @@
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace CppTraining
+{
+namespace
+{
+constexpr char Magic[8] = {'C', 'P', 'P', 'T', 'M', 'A', 'P', '1'};
+
+[[noreturn]] void throw_errno(const char* what)
+{
+  throw std::system_error{errno, std::generic_category(), what};
+}
+} // namespace
+
+struct MappedFile::Header
+{
+  char magic[sizeof(Magic)];
+  std::uint64_t block_offset;
+  std::uint64_t block_bytes;
+  std::uint64_t stored_count;
+};
+
+MappedFile::MappedFile(const std::string& path, Mode mode)
+    : path_{path}
+    , page_size_{static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))}
+{
+  const int flags = O_RDWR | O_CREAT | O_CLOEXEC | (mode == Mode::Truncate ? O_TRUNC : 0);
+  fd_ = ::open(path.c_str(), flags, 0644);
+  if (fd_ < 0)
+  {
+    throw_errno("Cannot open mapped file");
+  }
+
+  try
+  {
+    struct stat status;
+    if (::fstat(fd_, &status) != 0)
+    {
+      throw_errno("Cannot open mapped file");
+    }
+
+    const auto file_size = static_cast<std::size_t>(status.st_size);
+    const bool is_new = file_size == 0;
+    if (is_new && ::ftruncate(fd_, static_cast<off_t>(page_size_)) != 0)
+    {
+      throw_errno("Cannot open mapped file");
+    }
+
+    if (!is_new && file_size < page_size_)
+    {
+      throw std::runtime_error("Not a mapped file.");
+    }
+
+    header_ = reinterpret_cast<Header*>(map(0, page_size_));
+    if (header_ == nullptr)
+    {
+      throw_errno("Cannot map file header");
+    }
+
+    if (is_new)
+    {
+      std::memcpy(header_->magic, Magic, sizeof(Magic));
+    }
+    else if (std::memcmp(header_->magic, Magic, sizeof(Magic)) != 0 ||
+             header_->block_offset % page_size_ != 0 ||
+             header_->block_offset + mapped_length(header_->block_bytes) > file_size)
+    {
+      throw std::runtime_error("Not a mapped file.");
+    }
+
+    if (header_->block_bytes != 0)
+    {
+      const auto offset = static_cast<std::size_t>(header_->block_offset);
+      const auto bytes = static_cast<std::size_t>(header_->block_bytes);
+      auto address = map(offset, mapped_length(bytes));
+      if (address == nullptr)
+      {
+        throw_errno("Cannot map stored block");
+      }
+
+      blocks_[0] = Block{address, offset, bytes};
+      block_count_ = 1;
+      stored_block_ = address;
+    }
+  }
+  catch (...)
+  {
+    release();
+    throw;
+  }
+}
+
+MappedFile::~MappedFile()
+{
+  release();
+}
+
+void* MappedFile::allocate(std::size_t bytes)
+{
+  if (stored_block_ != nullptr)
+  {
+    // Nobody adopted what the file held, so the new block replaces it
+    deallocate(stored_block_);
+  }
+
+  if (block_count_ == blocks_.size())
+  {
+    throw std::bad_alloc();
+  }
+
+  const auto offset =
+    block_count_ == 0 ? page_size_ : blocks_[0].offset + mapped_length(blocks_[0].bytes);
+  const auto length = mapped_length(bytes);
+  if (block_count_ == 0)
+  {
+    // The bytes the header points at are about to be overwritten
+    record(Block{nullptr, offset, 0});
+    header_->stored_count = 0;
+  }
+
+  if (::ftruncate(fd_, static_cast<off_t>(offset + length)) != 0)
+  {
+    throw std::bad_alloc();
+  }
+
+  auto address = map(offset, length);
+  if (address == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+
+  auto& block = blocks_[block_count_++];
+  block = Block{address, offset, bytes};
+  record(block);
+
+  return address;
+}
+
+void* MappedFile::reallocate(void* address, std::size_t old_bytes, std::size_t new_bytes)
+{
+  auto block = find(address);
+  if (block == nullptr || block->bytes != old_bytes || block != &blocks_[block_count_ - 1])
+  {
+    // Only the block at the end of the file has room to grow
+    throw std::bad_alloc();
+  }
+
+  const auto old_length = mapped_length(old_bytes);
+  const auto new_length = mapped_length(new_bytes);
+  if (new_length > old_length &&
+      ::ftruncate(fd_, static_cast<off_t>(block->offset + new_length)) != 0)
+  {
+    throw std::bad_alloc();
+  }
+
+  if (new_length != old_length)
+  {
+#if defined(__linux__)
+    auto new_address = ::mremap(block->address, old_length, new_length, MREMAP_MAYMOVE);
+    if (new_address == MAP_FAILED)
+    {
+      throw std::bad_alloc();
+    }
+
+    block->address = static_cast<std::byte*>(new_address);
+#else
+    // Both mappings show the same pages of the file, so nothing needs copying
+    auto new_address = map(block->offset, new_length);
+    if (new_address == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    ::munmap(block->address, old_length);
+    block->address = new_address;
+#endif
+
+    if (new_length < old_length)
+    {
+      static_cast<void>(::ftruncate(fd_, static_cast<off_t>(block->offset + new_length)));
+    }
+  }
+
+  block->bytes = new_bytes;
+  record(*block);
+
+  return block->address;
+}
+
+void MappedFile::deallocate(void* address) noexcept
+{
+  auto block = find(address);
+  if (block == nullptr)
+  {
+    return;
+  }
+
+  const auto freed = *block;
+  ::munmap(freed.address, mapped_length(freed.bytes));
+  if (freed.address == stored_block_)
+  {
+    stored_block_ = nullptr;
+  }
+
+  if (block == &blocks_[0])
+  {
+    blocks_[0] = blocks_[1];
+  }
+  --block_count_;
+
+  // The only live block stays recorded in the header, so that the next run can adopt it
+  if (block_count_ == 0)
+  {
+    return;
+  }
+
+  const auto& remaining = blocks_[0];
+  record(remaining);
+  if (freed.offset > remaining.offset)
+  {
+    static_cast<void>(::ftruncate(
+      fd_, static_cast<off_t>(remaining.offset + mapped_length(remaining.bytes))));
+  }
+  else
+  {
+#if defined(__linux__)
+    // Give the disk space back without moving the remaining block
+    static_cast<void>(::fallocate(fd_,
+                                  FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                                  static_cast<off_t>(freed.offset),
+                                  static_cast<off_t>(mapped_length(freed.bytes))));
+#endif
+  }
+}
+
+void* MappedFile::adopt_stored_block() noexcept
+{
+  return std::exchange(stored_block_, nullptr);
+}
+
+std::size_t MappedFile::stored_bytes() const noexcept
+{
+  return static_cast<std::size_t>(header_->block_bytes);
+}
+
+std::uint64_t MappedFile::stored_count() const noexcept
+{
+  return header_->stored_count;
+}
+
+void MappedFile::store_count(std::uint64_t count) noexcept
+{
+  header_->stored_count = count;
+}
+
+void MappedFile::flush()
+{
+  for (std::size_t i = 0; i < block_count_; ++i)
+  {
+    if (::msync(blocks_[i].address, mapped_length(blocks_[i].bytes), MS_SYNC) != 0)
+    {
+      throw_errno("Cannot flush mapped file");
+    }
+  }
+
+  if (::msync(header_, page_size_, MS_SYNC) != 0)
+  {
+    throw_errno("Cannot flush mapped file");
+  }
+}
+
+const std::string& MappedFile::path() const noexcept
+{
+  return path_;
+}
+
+std::size_t MappedFile::mapped_length(std::size_t bytes) const noexcept
+{
+  // Even an empty block gets a page, so that every block has an address of its own
+  return (std::max<std::size_t>(bytes, 1) + page_size_ - 1) / page_size_ * page_size_;
+}
+
+std::byte* MappedFile::map(std::size_t offset, std::size_t length) noexcept
+{
+  auto address =
+    ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, static_cast<off_t>(offset));
+  return address == MAP_FAILED ? nullptr : static_cast<std::byte*>(address);
+}
+
+MappedFile::Block* MappedFile::find(void* address) noexcept
+{
+  const auto last = blocks_.begin() + static_cast<std::ptrdiff_t>(block_count_);
+  const auto it = std::find_if(
+    blocks_.begin(), last, [address](const Block& block) { return block.address == address; });
+  return it == last ? nullptr : &*it;
+}
+
+void MappedFile::record(const Block& block) noexcept
+{
+  header_->block_offset = block.offset;
+  header_->block_bytes = block.bytes;
+}
+
+void MappedFile::release() noexcept
+{
+  for (std::size_t i = 0; i < block_count_; ++i)
+  {
+    ::munmap(blocks_[i].address, mapped_length(blocks_[i].bytes));
+  }
+  block_count_ = 0;
+  stored_block_ = nullptr;
+
+  if (header_ != nullptr)
+  {
+    ::munmap(header_, page_size_);
+    header_ = nullptr;
+  }
+
+  if (fd_ >= 0)
+  {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+} // namespace CppTraining
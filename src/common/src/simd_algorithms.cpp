@@ -0,0 +1,728 @@
+#include "simd_algorithms.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+// SSE2 must be part of the baseline, as it is on every x86-64 target: the AVX2 kernels use one of
+// its instructions
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define CPP_TRAINING_SIMD_X86
+#endif
+
+#if defined(CPP_TRAINING_SIMD_X86)
+#include <emmintrin.h>
+
+// Kernels must be inlined into the entry point of an instruction set to be compiled for it
+#define CPP_TRAINING_SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define CPP_TRAINING_SIMD_INLINE inline
+#endif
+
+// AddressSanitizer reports the string kernels' reads past the terminator (see load_within_page()),
+// so its builds use their scalar loops
+#if defined(__SANITIZE_ADDRESS__)
+#define CPP_TRAINING_SIMD_ADDRESS_SANITIZER
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define CPP_TRAINING_SIMD_ADDRESS_SANITIZER
+#endif
+#endif
+
+namespace CppTraining
+{
+namespace simd
+{
+namespace
+{
+/// @brief Reads an element with memcpy, since the kernel for e.g. std::int64_t also serves arrays
+/// of long long.
+template <typename T>
+CPP_TRAINING_SIMD_INLINE T read(const T* source) noexcept
+{
+  T value;
+  std::memcpy(&value, source, sizeof value);
+  return value;
+}
+
+#if defined(CPP_TRAINING_SIMD_X86)
+/// @brief A register of Bytes bytes holding T lanes, in GCC's vector extensions: comparing two
+/// vectors yields a mask with every bit of a lane set where the comparison holds.
+template <typename T, std::size_t Bytes>
+struct Lanes
+{
+  typedef T vector __attribute__((vector_size(Bytes)));
+  using mask = decltype(vector{} == vector{});
+
+  static constexpr std::size_t count = Bytes / sizeof(T);
+};
+
+// Vectors are passed by reference: a 32-byte vector passed by value is only well-defined where AVX
+// is enabled
+template <typename Vector, typename T>
+CPP_TRAINING_SIMD_INLINE void load(Vector& vector, const T* source) noexcept
+{
+  std::memcpy(&vector, source, sizeof vector);
+}
+
+template <typename Vector, typename T>
+CPP_TRAINING_SIMD_INLINE void broadcast(Vector& vector, T value) noexcept
+{
+  for (std::size_t lane = 0; lane < sizeof(Vector) / sizeof(T); ++lane)
+  {
+    vector[lane] = value;
+  }
+}
+
+#if defined(CPP_TRAINING_SIMD_ADDRESS_SANITIZER)
+constexpr bool ReadsPastStrings = false;
+#else
+constexpr bool ReadsPastStrings = true;
+#endif
+
+/// @brief The smallest page size of the targets we build for. Memory protection works in whole
+/// pages, so a load that stays within the page of a byte the caller may read cannot fault.
+constexpr std::size_t PageSize = 4096;
+
+/// @brief The number of bytes from address to the end of its page.
+CPP_TRAINING_SIMD_INLINE std::size_t page_room(const char* address) noexcept
+{
+  return PageSize - (reinterpret_cast<std::uintptr_t>(address) & (PageSize - 1));
+}
+
+/// @brief Loads a vector from a string whose end is unknown, which may read past the terminator
+/// into bytes that belong to something else. Only call it with at least sizeof(Vector) bytes of
+/// page_room(); the bytes after the terminator are ignored, however they compare.
+template <typename Vector>
+CPP_TRAINING_SIMD_INLINE void load_within_page(Vector& vector, const char* source) noexcept
+{
+  typedef Vector unaligned __attribute__((aligned(1), may_alias));
+  vector = *reinterpret_cast<const unaligned*>(source);
+}
+
+template <typename Mask>
+CPP_TRAINING_SIMD_INLINE bool any(const Mask& mask) noexcept
+{
+  std::uint64_t words[sizeof(Mask) / sizeof(std::uint64_t)];
+  std::memcpy(words, &mask, sizeof mask);
+
+  std::uint64_t bits = 0;
+  for (auto word : words)
+  {
+    bits |= word;
+  }
+
+  return bits != 0;
+}
+
+/// @brief One bit per lane of a mask of byte lanes, set where the lane is, lowest lane first.
+/// pmovmskb does this in one instruction per 16 bytes; there is no way to say it with vector
+/// extensions alone.
+template <typename Mask>
+CPP_TRAINING_SIMD_INLINE std::uint32_t lane_bits(const Mask& mask) noexcept
+{
+  std::uint32_t bits = 0;
+  for (std::size_t half = 0; half < sizeof(Mask) / sizeof(__m128i); ++half)
+  {
+    __m128i part;
+    std::memcpy(&part, reinterpret_cast<const char*>(&mask) + half * sizeof part, sizeof part);
+    bits |= static_cast<std::uint32_t>(_mm_movemask_epi8(part)) << (16 * half);
+  }
+
+  return bits;
+}
+#endif
+
+// Each kernel's run<Bytes>() works through Bytes-wide vectors and finishes with scalar code, which
+// is all it does when Bytes is zero. Four vectors per step in the searches keep several loads and
+// compares in flight.
+
+struct Find
+{
+  template <std::size_t Bytes, typename T>
+  static CPP_TRAINING_SIMD_INLINE std::size_t run(const T* data, std::size_t size, T value) noexcept
+  {
+    std::size_t i = 0;
+
+#if defined(CPP_TRAINING_SIMD_X86)
+    if constexpr (Bytes != 0)
+    {
+      using L = Lanes<T, Bytes>;
+
+      typename L::vector target;
+      broadcast(target, value);
+
+      // Stop at the first block with a match; the scalar loop below then finds it within the block
+      for (; size - i >= 4 * L::count; i += 4 * L::count)
+      {
+        typename L::vector a, b, c, d;
+        load(a, data + i);
+        load(b, data + i + L::count);
+        load(c, data + i + 2 * L::count);
+        load(d, data + i + 3 * L::count);
+        if (any((a == target) | (b == target) | (c == target) | (d == target)))
+        {
+          break;
+        }
+      }
+
+      for (; size - i >= L::count; i += L::count)
+      {
+        typename L::vector a;
+        load(a, data + i);
+        if (any(a == target))
+        {
+          break;
+        }
+      }
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+      if (read(data + i) == value)
+      {
+        return i;
+      }
+    }
+
+    return size;
+  }
+};
+
+struct Count
+{
+  template <std::size_t Bytes, typename T>
+  static CPP_TRAINING_SIMD_INLINE std::size_t run(const T* data, std::size_t size, T value) noexcept
+  {
+    std::size_t total = 0;
+    std::size_t i = 0;
+
+#if defined(CPP_TRAINING_SIMD_X86)
+    if constexpr (Bytes != 0)
+    {
+      using L = Lanes<T, Bytes>;
+
+      typename L::vector target;
+      broadcast(target, value);
+
+      // Subtracting a mask adds one to each matching lane. A lane as narrow as a byte holds 127
+      // matches at most, so the lanes are added up after that many vectors.
+      while (size - i >= L::count)
+      {
+        typename L::mask matches{};
+        for (std::size_t step = 0; step < 127 && size - i >= L::count; ++step, i += L::count)
+        {
+          typename L::vector a;
+          load(a, data + i);
+          matches -= (a == target);
+        }
+
+        for (std::size_t lane = 0; lane < L::count; ++lane)
+        {
+          total += static_cast<std::size_t>(matches[lane]);
+        }
+      }
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+      total += read(data + i) == value ? 1 : 0;
+    }
+
+    return total;
+  }
+};
+
+/// @brief Finds the smallest (or largest) value, then returns the first element equal to it, which
+/// is the element std::min_element (or std::max_element) returns. Comparisons with NaN are false,
+/// so NaNs are skipped; a leading NaN is the result, as it is for the standard algorithms.
+template <bool Largest>
+struct Extreme
+{
+  template <typename T>
+  static CPP_TRAINING_SIMD_INLINE bool better(T candidate, T best) noexcept
+  {
+    return Largest ? best < candidate : candidate < best;
+  }
+
+  template <std::size_t Bytes, typename T>
+  static CPP_TRAINING_SIMD_INLINE std::size_t run(const T* data, std::size_t size) noexcept
+  {
+    if (size == 0)
+    {
+      return 0;
+    }
+
+    T best = read(data);
+    if (!(best == best))
+    {
+      return 0;
+    }
+
+    std::size_t i = 0;
+
+#if defined(CPP_TRAINING_SIMD_X86)
+    if constexpr (Bytes != 0)
+    {
+      using L = Lanes<T, Bytes>;
+
+      if (size >= L::count)
+      {
+        typename L::vector best_lanes;
+        broadcast(best_lanes, best);
+
+        for (; size - i >= L::count; i += L::count)
+        {
+          typename L::vector a;
+          load(a, data + i);
+          // Casts between vectors of the same size reinterpret their bits
+          const typename L::mask take = Largest ? best_lanes < a : a < best_lanes;
+          best_lanes = (typename L::vector)((take & (typename L::mask)a) |
+                                            (~take & (typename L::mask)best_lanes));
+        }
+
+        for (std::size_t lane = 0; lane < L::count; ++lane)
+        {
+          if (better<T>(best_lanes[lane], best))
+          {
+            best = best_lanes[lane];
+          }
+        }
+      }
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+      const T candidate = read(data + i);
+      if (better(candidate, best))
+      {
+        best = candidate;
+      }
+    }
+
+    return Find::run<Bytes>(data, size, best);
+  }
+};
+
+struct Equal
+{
+  template <std::size_t Bytes, typename T>
+  static CPP_TRAINING_SIMD_INLINE bool run(const T* lhs, const T* rhs, std::size_t size) noexcept
+  {
+    std::size_t i = 0;
+
+#if defined(CPP_TRAINING_SIMD_X86)
+    if constexpr (Bytes != 0)
+    {
+      using L = Lanes<T, Bytes>;
+
+      for (; size - i >= 4 * L::count; i += 4 * L::count)
+      {
+        typename L::vector a, b, c, d, e, f, g, h;
+        load(a, lhs + i);
+        load(b, rhs + i);
+        load(c, lhs + i + L::count);
+        load(d, rhs + i + L::count);
+        load(e, lhs + i + 2 * L::count);
+        load(f, rhs + i + 2 * L::count);
+        load(g, lhs + i + 3 * L::count);
+        load(h, rhs + i + 3 * L::count);
+        if (any((a != b) | (c != d) | (e != f) | (g != h)))
+        {
+          return false;
+        }
+      }
+
+      for (; size - i >= L::count; i += L::count)
+      {
+        typename L::vector a, b;
+        load(a, lhs + i);
+        load(b, rhs + i);
+        if (any(a != b))
+        {
+          return false;
+        }
+      }
+    }
+#endif
+
+    for (; i < size; ++i)
+    {
+      if (!(read(lhs + i) == read(rhs + i)))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+// The string kernels compare whole vectors until one holds a difference or a terminator, as long
+// as the vectors stay within the pages the strings are in; they cross from one page to the next
+// byte by byte.
+
+struct StringEqual
+{
+  template <std::size_t Bytes>
+  static CPP_TRAINING_SIMD_INLINE bool run(const char* lhs, const char* rhs) noexcept
+  {
+    std::size_t i = 0;
+
+#if defined(CPP_TRAINING_SIMD_X86)
+    if constexpr (Bytes != 0 && ReadsPastStrings)
+    {
+      using L = Lanes<std::uint8_t, Bytes>;
+      const typename L::vector zero{};
+
+      for (;;)
+      {
+        const std::size_t end = i + std::min(page_room(lhs + i), page_room(rhs + i));
+        for (; end - i >= L::count; i += L::count)
+        {
+          typename L::vector a, b;
+          load_within_page(a, lhs + i);
+          load_within_page(b, rhs + i);
+          // Equal lanes keep their character and the others become zero, so one comparison with
+          // zero finds both differences and terminators
+          const auto kept = (typename L::vector)(a == b) & a;
+          if (const auto stop = lane_bits(kept == zero))
+          {
+            // The first difference or terminator decides
+            i += static_cast<std::size_t>(__builtin_ctz(stop));
+            return lhs[i] == rhs[i];
+          }
+        }
+
+        for (; i < end; ++i)
+        {
+          if (lhs[i] != rhs[i])
+          {
+            return false;
+          }
+          if (lhs[i] == '\0')
+          {
+            return true;
+          }
+        }
+      }
+    }
+#endif
+
+    for (;; ++i)
+    {
+      if (lhs[i] != rhs[i])
+      {
+        return false;
+      }
+      if (lhs[i] == '\0')
+      {
+        return true;
+      }
+    }
+  }
+};
+
+struct StringLength
+{
+  template <std::size_t Bytes>
+  static CPP_TRAINING_SIMD_INLINE std::size_t run(const char* string) noexcept
+  {
+    std::size_t i = 0;
+
+#if defined(CPP_TRAINING_SIMD_X86)
+    if constexpr (Bytes != 0 && ReadsPastStrings)
+    {
+      using L = Lanes<std::uint8_t, Bytes>;
+      const typename L::vector zero{};
+
+      for (;;)
+      {
+        const std::size_t end = i + page_room(string + i);
+        for (; end - i >= L::count; i += L::count)
+        {
+          typename L::vector a;
+          load_within_page(a, string + i);
+          if (const auto terminators = lane_bits(a == zero))
+          {
+            return i + static_cast<std::size_t>(__builtin_ctz(terminators));
+          }
+        }
+
+        for (; i < end; ++i)
+        {
+          if (string[i] == '\0')
+          {
+            return i;
+          }
+        }
+      }
+    }
+#endif
+
+    while (string[i] != '\0')
+    {
+      ++i;
+    }
+
+    return i;
+  }
+};
+
+// Odd constants with well-mixed bits, from wyhash
+constexpr std::uint64_t HashSecrets[] = {
+  0xa0761d6478bd642f, 0xe7037ed1a0b428db, 0x8ebc6af09c88c6e3, 0x589965cc75374cc3};
+
+/// @brief Multiplies two words into 128 bits and folds the halves together: every bit of either
+/// word reaches the middle bits of the result.
+CPP_TRAINING_SIMD_INLINE std::uint64_t multiply_fold(std::uint64_t a, std::uint64_t b) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+  __extension__ using Product = unsigned __int128;
+  const Product product = static_cast<Product>(a) * b;
+  return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+  const std::uint64_t a_low = a & 0xffffffff, a_high = a >> 32;
+  const std::uint64_t b_low = b & 0xffffffff, b_high = b >> 32;
+  const std::uint64_t low = a_low * b_low;
+  const std::uint64_t middle = a_high * b_low + (low >> 32);
+  const std::uint64_t middle2 = a_low * b_high + (middle & 0xffffffff);
+  const std::uint64_t high = a_high * b_high + (middle >> 32) + (middle2 >> 32);
+  return ((middle2 << 32) | (low & 0xffffffff)) ^ high;
+#endif
+}
+
+CPP_TRAINING_SIMD_INLINE std::uint64_t read_word(const char* source) noexcept
+{
+  std::uint64_t value;
+  std::memcpy(&value, source, sizeof value);
+  return value;
+}
+
+CPP_TRAINING_SIMD_INLINE std::uint64_t read_half_word(const char* source) noexcept
+{
+  std::uint32_t value;
+  std::memcpy(&value, source, sizeof value);
+  return value;
+}
+
+/// @brief A hash in the style of wyhash: each 128-bit multiplication mixes 16 bytes into the
+/// state, and long strings go through three independent states, so that the multiplications of
+/// one 48-byte step overlap. The hash needs no dispatch: the multiplications bound it, and vector
+/// units have no 64-bit multiply before AVX-512.
+std::uint64_t hash_bytes(const char* data, std::size_t size) noexcept
+{
+  const auto& secret = HashSecrets;
+  std::uint64_t seed = secret[0] ^ static_cast<std::uint64_t>(size);
+  std::size_t i = 0;
+
+  if (size >= 48)
+  {
+    std::uint64_t states[3] = {seed, seed, seed};
+    for (; size - i >= 48; i += 48)
+    {
+      for (std::size_t state = 0; state < 3; ++state)
+      {
+        const auto* block = data + i + 16 * state;
+        states[state] = multiply_fold(read_word(block) ^ secret[state + 1],
+                                      read_word(block + 8) ^ states[state]);
+      }
+    }
+    seed = states[0] ^ states[1] ^ states[2];
+  }
+
+  for (; size - i >= 16; i += 16)
+  {
+    seed = multiply_fold(read_word(data + i) ^ secret[1], read_word(data + i + 8) ^ seed);
+  }
+
+  // The last 1 to 15 bytes, read as (possibly overlapping) fixed-size pieces rather than with a
+  // memcpy() of variable size; the size in the seed tells the overlaps apart
+  if (i != size)
+  {
+    const auto* rest = data + i;
+    const auto rest_size = size - i;
+
+    std::uint64_t first;
+    std::uint64_t second = 0;
+    if (rest_size >= 4)
+    {
+      const auto step = (rest_size >> 3) << 2;
+      first = (read_half_word(rest) << 32) | read_half_word(rest + step);
+      second = (read_half_word(rest + rest_size - 4) << 32) |
+               read_half_word(rest + rest_size - 4 - step);
+    }
+    else
+    {
+      const auto byte = [rest](std::size_t index) {
+        return static_cast<std::uint64_t>(static_cast<unsigned char>(rest[index]));
+      };
+      first = (byte(0) << 16) | (byte(rest_size >> 1) << 8) | byte(rest_size - 1);
+    }
+
+    seed = multiply_fold(first ^ secret[1], second ^ seed);
+  }
+
+  return multiply_fold(seed ^ secret[2], static_cast<std::uint64_t>(size) ^ secret[3]);
+}
+
+#if defined(CPP_TRAINING_SIMD_X86)
+template <typename Kernel, typename... Args>
+__attribute__((target("avx2"))) auto run_avx2(Args... args) noexcept
+{
+  return Kernel::template run<32>(args...);
+}
+
+template <typename Kernel, typename... Args>
+__attribute__((target("sse2"))) auto run_sse2(Args... args) noexcept
+{
+  return Kernel::template run<16>(args...);
+}
+#endif
+
+std::atomic<InstructionSet>& active_instruction_set() noexcept
+{
+  static std::atomic<InstructionSet> active{best_instruction_set()};
+  return active;
+}
+
+template <typename Kernel, typename... Args>
+auto run(Args... args) noexcept
+{
+  switch (active_instruction_set().load(std::memory_order_relaxed))
+  {
+#if defined(CPP_TRAINING_SIMD_X86)
+  case InstructionSet::Avx2:
+    return run_avx2<Kernel>(args...);
+  case InstructionSet::Sse2:
+    return run_sse2<Kernel>(args...);
+#endif
+  default:
+    return Kernel::template run<0>(args...);
+  }
+}
+} // namespace
+
+InstructionSet best_instruction_set() noexcept
+{
+#if defined(CPP_TRAINING_SIMD_X86)
+  static const InstructionSet best = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+      return InstructionSet::Avx2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+      return InstructionSet::Sse2;
+    }
+    return InstructionSet::Scalar;
+  }();
+
+  return best;
+#else
+  return InstructionSet::Scalar;
+#endif
+}
+
+InstructionSet instruction_set() noexcept
+{
+  return active_instruction_set().load(std::memory_order_relaxed);
+}
+
+InstructionSet set_instruction_set(InstructionSet instruction_set) noexcept
+{
+  const auto best = best_instruction_set();
+  const auto chosen =
+    static_cast<int>(instruction_set) <= static_cast<int>(best) ? instruction_set : best;
+
+  active_instruction_set().store(chosen, std::memory_order_relaxed);
+  return chosen;
+}
+
+namespace detail
+{
+template <typename T>
+std::size_t find(const T* data, std::size_t size, T value) noexcept
+{
+  return run<Find>(data, size, value);
+}
+
+template <typename T>
+std::size_t count(const T* data, std::size_t size, T value) noexcept
+{
+  return run<Count>(data, size, value);
+}
+
+template <typename T>
+std::size_t min_element(const T* data, std::size_t size) noexcept
+{
+  return run<Extreme<false>>(data, size);
+}
+
+template <typename T>
+std::size_t max_element(const T* data, std::size_t size) noexcept
+{
+  return run<Extreme<true>>(data, size);
+}
+
+template <typename T>
+bool equal(const T* lhs, const T* rhs, std::size_t size) noexcept
+{
+  return run<Equal>(lhs, rhs, size);
+}
+
+#define CPP_TRAINING_SIMD_INSTANTIATE(T)                                                           \
+  template std::size_t find<T>(const T*, std::size_t, T) noexcept;                                 \
+  template std::size_t count<T>(const T*, std::size_t, T) noexcept;                                \
+  template std::size_t min_element<T>(const T*, std::size_t) noexcept;                             \
+  template std::size_t max_element<T>(const T*, std::size_t) noexcept;                             \
+  template bool equal<T>(const T*, const T*, std::size_t) noexcept;
+
+CPP_TRAINING_SIMD_INSTANTIATE(std::int8_t)
+CPP_TRAINING_SIMD_INSTANTIATE(std::uint8_t)
+CPP_TRAINING_SIMD_INSTANTIATE(std::int16_t)
+CPP_TRAINING_SIMD_INSTANTIATE(std::uint16_t)
+CPP_TRAINING_SIMD_INSTANTIATE(std::int32_t)
+CPP_TRAINING_SIMD_INSTANTIATE(std::uint32_t)
+CPP_TRAINING_SIMD_INSTANTIATE(std::int64_t)
+CPP_TRAINING_SIMD_INSTANTIATE(std::uint64_t)
+CPP_TRAINING_SIMD_INSTANTIATE(float)
+CPP_TRAINING_SIMD_INSTANTIATE(double)
+
+#undef CPP_TRAINING_SIMD_INSTANTIATE
+} // namespace detail
+
+bool string_equal(const char* lhs, const char* rhs) noexcept
+{
+  return lhs == rhs || run<StringEqual>(lhs, rhs);
+}
+
+bool string_equal(const char* lhs,
+                  std::size_t lhs_size,
+                  const char* rhs,
+                  std::size_t rhs_size) noexcept
+{
+  // memcmp() is vectorized already, and has fast paths for short sizes that the kernels lack
+  return lhs_size == rhs_size && (lhs_size == 0 || std::memcmp(lhs, rhs, lhs_size) == 0);
+}
+
+std::size_t string_length(const char* string) noexcept
+{
+  return run<StringLength>(string);
+}
+
+std::size_t string_hash(const char* string) noexcept
+{
+  return string_hash(string, string_length(string));
+}
+
+std::size_t string_hash(const char* data, std::size_t size) noexcept
+{
+  return static_cast<std::size_t>(hash_bytes(data, size));
+}
+} // namespace simd
+} // namespace CppTraining
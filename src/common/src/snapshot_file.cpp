@@ -0,0 +1,332 @@
+#include "snapshot_file.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "simd_algorithms.h"
+
+namespace CppTraining
+{
+namespace
+{
+constexpr char Magic[8] = {'C', 'P', 'P', 'T', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t Version = 1;
+constexpr std::uint32_t ByteOrder = 0x01020304;
+
+/// @brief The payload is written, and checksummed, this many bytes at a time.
+constexpr std::size_t ChunkSize = std::size_t{8} << 20;
+
+struct Header
+{
+  char magic[sizeof(Magic)];
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint64_t type_tag;
+  std::uint64_t element_size;
+  std::uint64_t alignment;
+  std::uint64_t count;
+  std::uint64_t checksum;
+  std::uint64_t payload_offset;
+};
+
+static_assert(sizeof(Header) == 64, "The snapshot header is part of the file format");
+
+[[noreturn]] void throw_errno(const char* what, int error = errno)
+{
+  throw std::system_error{error, std::generic_category(), what};
+}
+
+std::size_t payload_offset(std::size_t alignment) noexcept
+{
+  return std::max(sizeof(Header), alignment);
+}
+
+/// @brief Folds one chunk of the payload into the checksum, so that it can be computed a chunk
+/// at a time, while writing.
+std::uint64_t add_to_checksum(std::uint64_t checksum, const std::byte* chunk, std::size_t size)
+{
+  const auto hash = static_cast<std::uint64_t>(
+    simd::string_hash(reinterpret_cast<const char*>(chunk), size));
+  return (checksum ^ hash) * 0x9E3779B97F4A7C15ULL;
+}
+
+std::uint64_t checksum(const std::byte* payload, std::size_t size)
+{
+  std::uint64_t result = 0;
+  for (std::size_t offset = 0; offset < size; offset += ChunkSize)
+  {
+    result = add_to_checksum(result, payload + offset, std::min(ChunkSize, size - offset));
+  }
+  return result;
+}
+
+void write_all(int fd, const std::byte* data, std::size_t size)
+{
+  while (size != 0)
+  {
+    const auto written = ::write(fd, data, size);
+    if (written < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      throw_errno("Cannot write snapshot");
+    }
+
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+/// @brief Makes a rename in the directory holding path durable, so that after a crash the path
+/// names the file it was renamed to.
+void sync_parent_directory(const std::string& path)
+{
+  const auto slash = path.find_last_of('/');
+  const auto directory = slash == std::string::npos ? std::string{"."}
+                         : slash == 0               ? std::string{"/"}
+                                                    : path.substr(0, slash);
+
+  const int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    throw_errno("Cannot sync snapshot directory");
+  }
+
+  if (::fsync(fd) != 0)
+  {
+    const int error = errno;
+    ::close(fd);
+    throw_errno("Cannot sync snapshot directory", error);
+  }
+
+  ::close(fd);
+}
+} // namespace
+
+void write_snapshot(const std::string& path,
+                    const SnapshotLayout& layout,
+                    const void* data,
+                    std::size_t count)
+{
+  const auto temporary_path = path + ".tmp";
+  int fd = ::open(temporary_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0)
+  {
+    throw_errno("Cannot create snapshot");
+  }
+
+  try
+  {
+    Header header{};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.byte_order = ByteOrder;
+    header.type_tag = layout.type_tag;
+    header.element_size = layout.element_size;
+    header.alignment = layout.alignment;
+    header.count = count;
+    header.payload_offset = payload_offset(layout.alignment);
+
+    // The header goes in last, once the checksum is known; the gap before the payload reads as
+    // zeros
+    if (::lseek(fd, static_cast<off_t>(header.payload_offset), SEEK_SET) < 0)
+    {
+      throw_errno("Cannot write snapshot");
+    }
+
+    const auto* payload = static_cast<const std::byte*>(data);
+    const auto size = count * layout.element_size;
+    for (std::size_t offset = 0; offset < size; offset += ChunkSize)
+    {
+      const auto chunk_size = std::min(ChunkSize, size - offset);
+      header.checksum = add_to_checksum(header.checksum, payload + offset, chunk_size);
+      write_all(fd, payload + offset, chunk_size);
+    }
+
+    if (::pwrite(fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)))
+    {
+      throw_errno("Cannot write snapshot");
+    }
+
+    // The data must be on disk before the rename is, or a crash could leave the new name on a
+    // file whose payload never made it
+    if (::fsync(fd) != 0)
+    {
+      throw_errno("Cannot write snapshot");
+    }
+
+    if (::close(std::exchange(fd, -1)) != 0)
+    {
+      throw_errno("Cannot write snapshot");
+    }
+  }
+  catch (...)
+  {
+    if (fd >= 0)
+    {
+      ::close(fd);
+    }
+    ::unlink(temporary_path.c_str());
+    throw;
+  }
+
+  if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+  {
+    const int error = errno;
+    ::unlink(temporary_path.c_str());
+    throw_errno("Cannot replace snapshot", error);
+  }
+
+  sync_parent_directory(path);
+}
+
+SnapshotMapping::SnapshotMapping(const std::string& path,
+                                 const SnapshotLayout& layout,
+                                 SnapshotCheck check)
+{
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+  {
+    throw_errno("Cannot open snapshot");
+  }
+
+  struct stat status;
+  if (::fstat(fd, &status) != 0)
+  {
+    const int error = errno;
+    ::close(fd);
+    throw_errno("Cannot open snapshot", error);
+  }
+
+  const auto file_size = static_cast<std::size_t>(status.st_size);
+  if (file_size < sizeof(Header))
+  {
+    ::close(fd);
+    throw std::runtime_error("Not a snapshot file.");
+  }
+
+  // The mapping keeps the file open
+  auto address = ::mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  const int error = errno;
+  ::close(fd);
+  if (address == MAP_FAILED)
+  {
+    throw_errno("Cannot map snapshot", error);
+  }
+
+  address_ = address;
+  length_ = file_size;
+
+  try
+  {
+    Header header;
+    std::memcpy(&header, address_, sizeof(header));
+
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0)
+    {
+      throw std::runtime_error("Not a snapshot file.");
+    }
+
+    if (header.byte_order != ByteOrder)
+    {
+      throw std::runtime_error("Snapshot was written on a machine of another byte order.");
+    }
+
+    if (header.version != Version)
+    {
+      throw std::runtime_error("Unsupported snapshot version.");
+    }
+
+    if (header.type_tag != layout.type_tag || header.element_size != layout.element_size ||
+        header.alignment != layout.alignment)
+    {
+      throw std::runtime_error("Snapshot element type does not match.");
+    }
+
+    if (header.payload_offset != payload_offset(layout.alignment) ||
+        header.payload_offset > file_size ||
+        header.count > (file_size - header.payload_offset) / layout.element_size ||
+        header.payload_offset + header.count * layout.element_size != file_size)
+    {
+      throw std::runtime_error("Snapshot size does not match its header.");
+    }
+
+    const auto* payload = static_cast<const std::byte*>(address_) + header.payload_offset;
+    const auto size = static_cast<std::size_t>(header.count) * layout.element_size;
+    if (check == SnapshotCheck::Checksum && checksum(payload, size) != header.checksum)
+    {
+      throw std::runtime_error("Snapshot checksum does not match.");
+    }
+
+    count_ = static_cast<std::size_t>(header.count);
+    payload_ = count_ == 0 ? nullptr : payload;
+  }
+  catch (...)
+  {
+    release();
+    throw;
+  }
+}
+
+SnapshotMapping::SnapshotMapping(SnapshotMapping&& other) noexcept
+    : address_{std::exchange(other.address_, nullptr)}
+    , length_{std::exchange(other.length_, 0)}
+    , payload_{std::exchange(other.payload_, nullptr)}
+    , count_{std::exchange(other.count_, 0)}
+{
+}
+
+SnapshotMapping& SnapshotMapping::operator=(SnapshotMapping&& other) noexcept
+{
+  if (this != &other)
+  {
+    release();
+    address_ = std::exchange(other.address_, nullptr);
+    length_ = std::exchange(other.length_, 0);
+    payload_ = std::exchange(other.payload_, nullptr);
+    count_ = std::exchange(other.count_, 0);
+  }
+
+  return *this;
+}
+
+SnapshotMapping::~SnapshotMapping()
+{
+  release();
+}
+
+const void* SnapshotMapping::data() const noexcept
+{
+  return payload_;
+}
+
+std::size_t SnapshotMapping::count() const noexcept
+{
+  return count_;
+}
+
+void SnapshotMapping::release() noexcept
+{
+  if (address_ != nullptr)
+  {
+    ::munmap(address_, length_);
+    address_ = nullptr;
+  }
+
+  length_ = 0;
+  payload_ = nullptr;
+  count_ = 0;
+}
+} // namespace CppTraining
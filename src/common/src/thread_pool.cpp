@@ -0,0 +1,489 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+namespace CppTraining
+{
+namespace
+{
+// Rounds of yield-and-look an idle worker makes before it goes to sleep
+constexpr int SpinCount = 64;
+
+// Pieces of a parallel_for per worker when the caller leaves the grain size to the pool
+constexpr std::size_t PiecesPerWorker = 8;
+
+struct CurrentWorker
+{
+  const ThreadPool* pool;
+  std::size_t index;
+};
+
+thread_local CurrentWorker current_worker_{nullptr, 0};
+
+/// @brief xorshift64 for picking victims; it only needs to be cheap and not identical on every
+/// thread.
+std::size_t random_index(std::size_t count) noexcept
+{
+  thread_local std::uint64_t state =
+    std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+
+  return static_cast<std::size_t>(state % count);
+}
+
+/// @brief The CPUs this process may run on: its affinity mask on Linux, which a cpuset (taskset,
+/// docker --cpuset-cpus) may have narrowed to CPUs other than 0..N-1, and every CPU elsewhere.
+std::vector<std::size_t> allowed_cpus()
+{
+  std::vector<std::size_t> cpus;
+
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+  {
+    for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (CPU_ISSET(cpu, &mask))
+      {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+
+  if (cpus.empty())
+  {
+    for (std::size_t cpu = 0; cpu < std::max(1U, std::thread::hardware_concurrency()); ++cpu)
+    {
+      cpus.push_back(cpu);
+    }
+  }
+
+  return cpus;
+}
+
+void pin(std::thread& thread, std::size_t cpu)
+{
+#if defined(__linux__)
+  if (cpu >= CPU_SETSIZE)
+  {
+    throw std::system_error{EINVAL, std::generic_category(), "Cannot pin a worker thread"};
+  }
+
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  if (const int error = pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus))
+  {
+    throw std::system_error{error, std::generic_category(), "Cannot pin a worker thread"};
+  }
+#elif defined(_WIN32)
+  if (cpu >= 8 * sizeof(DWORD_PTR) ||
+      SetThreadAffinityMask(thread.native_handle(), DWORD_PTR{1} << cpu) == 0)
+  {
+    throw std::system_error{
+      static_cast<int>(GetLastError()), std::system_category(), "Cannot pin a worker thread"};
+  }
+#else
+  static_cast<void>(thread);
+  static_cast<void>(cpu);
+#endif
+}
+} // namespace
+
+struct ThreadPool::Worker
+{
+  WorkStealingDeque<Task*> tasks;
+  std::thread thread;
+};
+
+/// @brief One parallel_for call. It lives on the caller's stack, which returns only after the last
+/// piece has set done under the mutex.
+struct ThreadPool::Loop
+{
+  Loop(void* context, LoopBody body, std::size_t grain_size, std::size_t remaining)
+      : context{context}
+      , body{body}
+      , grain_size{grain_size}
+      , remaining{remaining}
+  {
+  }
+
+  void finish(std::size_t count) noexcept
+  {
+    if (remaining.fetch_sub(count, std::memory_order_acq_rel) == count)
+    {
+      std::lock_guard<std::mutex> lock{mutex};
+      done = true;
+      done_condition.notify_all();
+    }
+  }
+
+  void fail() noexcept
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    if (!exception)
+    {
+      exception = std::current_exception();
+    }
+    failed.store(true, std::memory_order_relaxed);
+  }
+
+  void* context;
+  LoopBody body;
+  std::size_t grain_size;
+
+  // Indices whose piece has not finished yet
+  std::atomic<std::size_t> remaining;
+  std::atomic<bool> failed{false};
+
+  std::mutex mutex;
+  std::condition_variable done_condition;
+  bool done{false};
+  std::exception_ptr exception;
+};
+
+class ThreadPool::RangeTask final : public Task
+{
+public:
+  RangeTask(ThreadPool& pool, Loop& loop, std::size_t first, std::size_t last)
+      : pool_{pool}
+      , loop_{loop}
+      , first_{first}
+      , last_{last}
+  {
+  }
+
+  void run() override
+  {
+    // Hand the upper half to whoever wants it until what is left is one piece. Thieves take the
+    // oldest, so the biggest, halves first.
+    while (last_ - first_ > loop_.grain_size)
+    {
+      const auto middle = first_ + (last_ - first_) / 2;
+      try
+      {
+        pool_.schedule(std::make_unique<RangeTask>(pool_, loop_, middle, last_));
+        last_ = middle;
+      }
+      catch (...)
+      {
+        // Out of memory: run the rest here instead
+        break;
+      }
+    }
+
+    if (!loop_.failed.load(std::memory_order_relaxed))
+    {
+      try
+      {
+        loop_.body(loop_.context, first_, last_);
+      }
+      catch (...)
+      {
+        loop_.fail();
+      }
+    }
+
+    loop_.finish(last_ - first_);
+  }
+
+private:
+  ThreadPool& pool_;
+  Loop& loop_;
+  std::size_t first_;
+  std::size_t last_;
+};
+
+ThreadPool::ThreadPool() : ThreadPool{ThreadPoolOptions{}} {}
+
+ThreadPool::ThreadPool(std::size_t worker_count)
+    : ThreadPool{ThreadPoolOptions{worker_count, false, {}}}
+{
+}
+
+ThreadPool::ThreadPool(ThreadPoolOptions options)
+{
+  auto count = options.worker_count;
+  if (count == 0)
+  {
+    count = std::max(1U, std::thread::hardware_concurrency());
+  }
+
+  if (options.pin_workers && options.cpus.empty())
+  {
+    options.cpus = allowed_cpus();
+  }
+
+  // Every deque exists before any worker starts looking for one to steal from
+  workers_.reserve(count);
+  for (std::size_t index = 0; index < count; ++index)
+  {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+
+  try
+  {
+    for (std::size_t index = 0; index < count; ++index)
+    {
+      start(index, options);
+    }
+  }
+  catch (...)
+  {
+    stop();
+    throw;
+  }
+}
+
+ThreadPool::~ThreadPool() { stop(); }
+
+ThreadPool& ThreadPool::global()
+{
+  // Never destroyed, so that detached threads and static destructors can still use it
+  static auto* pool = new ThreadPool{};
+  return *pool;
+}
+
+std::size_t ThreadPool::worker_count() const noexcept { return workers_.size(); }
+
+std::optional<std::size_t> ThreadPool::current_worker() const noexcept
+{
+  if (current_worker_.pool != this)
+  {
+    return std::nullopt;
+  }
+
+  return current_worker_.index;
+}
+
+void ThreadPool::start(std::size_t index, const ThreadPoolOptions& options)
+{
+  auto& thread = workers_[index]->thread;
+  thread = std::thread{[this, index] {
+    current_worker_ = {this, index};
+    work(index);
+  }};
+
+  if (options.pin_workers)
+  {
+    pin(thread, options.cpus[index % options.cpus.size()]);
+  }
+}
+
+void ThreadPool::stop() noexcept
+{
+  {
+    std::lock_guard<std::mutex> lock{sleep_mutex_};
+    stopping_.store(true, std::memory_order_release);
+  }
+  sleep_condition_.notify_all();
+
+  for (auto& worker : workers_)
+  {
+    if (worker->thread.joinable())
+    {
+      worker->thread.join();
+    }
+  }
+}
+
+void ThreadPool::work(std::size_t index)
+{
+  for (;;)
+  {
+    auto* task = find_task(index);
+    for (int spin = 0; task == nullptr && spin < SpinCount; ++spin)
+    {
+      std::this_thread::yield();
+      task = find_task(index);
+    }
+
+    if (task != nullptr)
+    {
+      run(task);
+      continue;
+    }
+
+    // Stopping only once every queue is empty, so that submitted tasks still run
+    if (stopping_.load(std::memory_order_acquire))
+    {
+      return;
+    }
+
+    // Announce the sleep before looking one last time. wake_sleeper() checks sleeping_ after
+    // queueing, so either that look finds the task or the epoch has moved on.
+    sleeping_.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::uint64_t epoch;
+    {
+      std::lock_guard<std::mutex> lock{sleep_mutex_};
+      epoch = epoch_;
+    }
+
+    task = find_task(index);
+    if (task == nullptr)
+    {
+      std::unique_lock<std::mutex> lock{sleep_mutex_};
+      sleep_condition_.wait(lock, [this, epoch] {
+        return epoch_ != epoch || stopping_.load(std::memory_order_relaxed);
+      });
+    }
+
+    sleeping_.fetch_sub(1, std::memory_order_relaxed);
+    if (task != nullptr)
+    {
+      run(task);
+    }
+  }
+}
+
+void ThreadPool::schedule(std::unique_ptr<Task> task)
+{
+  const auto worker = current_worker();
+  if (worker)
+  {
+    workers_[*worker]->tasks.push(task.get());
+  }
+  else
+  {
+    std::lock_guard<std::mutex> lock{shared_mutex_};
+    shared_tasks_.push_back(task.get());
+    shared_size_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Queued: from here on the task deletes itself in run()
+  static_cast<void>(task.release());
+  wake_sleeper();
+}
+
+void ThreadPool::wake_sleeper() noexcept
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleeping_.load(std::memory_order_relaxed) == 0)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock{sleep_mutex_};
+    ++epoch_;
+  }
+  sleep_condition_.notify_one();
+}
+
+ThreadPool::Task* ThreadPool::find_task(std::optional<std::size_t> worker) noexcept
+{
+  if (worker)
+  {
+    if (const auto task = workers_[*worker]->tasks.pop())
+    {
+      return *task;
+    }
+  }
+
+  if (shared_size_.load(std::memory_order_relaxed) != 0)
+  {
+    std::lock_guard<std::mutex> lock{shared_mutex_};
+    if (!shared_tasks_.empty())
+    {
+      auto* task = shared_tasks_.front();
+      shared_tasks_.pop_front();
+      shared_size_.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+
+  const auto count = workers_.size();
+  const auto start = random_index(count);
+  for (std::size_t offset = 0; offset < count; ++offset)
+  {
+    const auto victim = (start + offset) % count;
+    if (worker && victim == *worker)
+    {
+      continue;
+    }
+
+    if (const auto task = workers_[victim]->tasks.steal())
+    {
+      return *task;
+    }
+  }
+
+  return nullptr;
+}
+
+void ThreadPool::run(Task* task) noexcept
+{
+  task->run();
+  delete task;
+}
+
+void ThreadPool::run_loop(std::size_t first,
+                          std::size_t last,
+                          std::size_t grain_size,
+                          void* context,
+                          LoopBody body)
+{
+  const auto size = last - first;
+  if (grain_size == 0)
+  {
+    grain_size = std::max<std::size_t>(1, size / (PiecesPerWorker * worker_count()));
+  }
+
+  if (size <= grain_size)
+  {
+    body(context, first, last);
+    return;
+  }
+
+  Loop loop{context, body, grain_size, size};
+  RangeTask{*this, loop, first, last}.run();
+
+  // Help with the pieces instead of blocking. A worker keeps at it, since it may be the only one
+  // able to run what is in its own deque; another thread blocks once there is nothing to take.
+  const auto worker = current_worker();
+  while (loop.remaining.load(std::memory_order_acquire) != 0)
+  {
+    if (auto* task = find_task(worker))
+    {
+      run(task);
+    }
+    else if (worker)
+    {
+      std::this_thread::yield();
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  {
+    std::unique_lock<std::mutex> lock{loop.mutex};
+    loop.done_condition.wait(lock, [&loop] { return loop.done; });
+  }
+
+  if (loop.exception)
+  {
+    std::rethrow_exception(loop.exception);
+  }
+}
+} // namespace CppTraining
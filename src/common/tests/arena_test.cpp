@@ -0,0 +1,125 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <catch2/catch_all.hpp>
+
+#include "arena.h"
+#include "arena_allocator.h"
+#include "literal_operators.h"
+
+using namespace CppTraining;
+
+SCENARIO("Exercising Arena", "[arena]")
+{
+  GIVEN("An arena over a caller-supplied buffer")
+  {
+    alignas(std::max_align_t) std::byte buffer[256];
+    Arena arena{buffer, sizeof(buffer), 1024_z};
+
+    WHEN("Allocations fit in the buffer")
+    {
+      auto a = static_cast<std::byte*>(arena.allocate(10_z, 1_z));
+      auto b = static_cast<std::byte*>(arena.allocate(16_z, 16_z));
+
+      THEN("They are carved from the buffer with the requested alignment")
+      {
+        REQUIRE(a == buffer);
+        REQUIRE(b >= buffer + 10);
+        REQUIRE(b + 16 <= buffer + sizeof(buffer));
+        REQUIRE(reinterpret_cast<std::uintptr_t>(b) % 16 == 0);
+        REQUIRE(arena.bytes_allocated() == 26_z);
+        REQUIRE(arena.chunk_count() == 0_z);
+      }
+    }
+
+    WHEN("The buffer is exhausted")
+    {
+      arena.allocate(200_z);
+      auto p = static_cast<std::byte*>(arena.allocate(100_z));
+
+      THEN("A chunk is chained from the global allocator")
+      {
+        REQUIRE((p < buffer || p >= buffer + sizeof(buffer)));
+        REQUIRE(arena.chunk_count() == 1_z);
+      }
+
+      AND_WHEN("The arena is reset")
+      {
+        arena.reset();
+
+        THEN("Allocation starts over at the buffer and the chunk is kept")
+        {
+          REQUIRE(arena.allocate(8_z) == buffer);
+          REQUIRE(arena.bytes_allocated() == 8_z);
+          REQUIRE(arena.chunk_count() == 1_z);
+        }
+
+        THEN("The kept chunk is reused rather than allocating another")
+        {
+          arena.allocate(200_z);
+          REQUIRE(arena.allocate(100_z) == p);
+          REQUIRE(arena.chunk_count() == 1_z);
+        }
+      }
+
+      AND_WHEN("The arena is released")
+      {
+        arena.release();
+
+        THEN("The chunks are returned")
+        {
+          REQUIRE(arena.chunk_count() == 0_z);
+          REQUIRE(arena.allocate(8_z) == buffer);
+        }
+      }
+    }
+
+    WHEN("An allocation is larger than the chunk size")
+    {
+      arena.allocate(4096_z);
+
+      THEN("It gets a chunk of its own")
+      {
+        REQUIRE(arena.chunk_count() == 1_z);
+      }
+    }
+  }
+
+  GIVEN("An arena without a buffer")
+  {
+    Arena arena;
+
+    THEN("The first allocation chains a chunk")
+    {
+      REQUIRE(arena.allocate(1_z) != nullptr);
+      REQUIRE(arena.chunk_count() == 1_z);
+    }
+  }
+}
+
+SCENARIO("Exercising ArenaAllocator", "[arena]")
+{
+  GIVEN("Allocators over two arenas")
+  {
+    Arena one;
+    Arena two;
+
+    ArenaAllocator<std::int32_t> a{one};
+    ArenaAllocator<std::int32_t> b{two};
+    ArenaAllocator<double> rebound{a};
+
+    THEN("Allocators are equal exactly when they share an arena")
+    {
+      REQUIRE(a == rebound);
+      REQUIRE(a != b);
+    }
+
+    THEN("Allocations come from the allocator's arena")
+    {
+      auto p = a.allocate(4_z);
+      a.deallocate(p, 4_z);
+      REQUIRE(one.bytes_allocated() == 4_z * sizeof(std::int32_t));
+      REQUIRE(two.bytes_allocated() == 0_z);
+    }
+  }
+}
@@ -0,0 +1,41 @@
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_all.hpp>
+
+#include "default_equality.h"
+#include "default_hash.h"
+
+using namespace CppTraining;
+
+TEST_CASE("C strings compare and hash by their characters", "[DefaultHash]")
+{
+  char first[] = "lookup-table-key";
+  char second[] = "lookup-table-key";
+  const char* other = "lookup-table-kez";
+
+  REQUIRE(DefaultEquality<char*>{}(first, second));
+  REQUIRE(DefaultEquality<const char*>{}(first, second));
+  REQUIRE_FALSE(DefaultEquality<const char* const>{}(first, other));
+
+  REQUIRE(DefaultHash<char*>{}(first) == DefaultHash<char*>{}(second));
+  REQUIRE(DefaultHash<const char*>{}(first) == DefaultHash<char* const>{}(second));
+  REQUIRE(DefaultHash<const char*>{}(first) != DefaultHash<const char* const>{}(other));
+}
+
+TEST_CASE("Strings of known size hash like the C strings they hold", "[DefaultHash]")
+{
+  const char* key = "a somewhat longer key, to cover more than one 32-byte step";
+  const std::string string{key};
+  const std::string_view view{string};
+
+  REQUIRE(DefaultHash<std::string>{}(string) == DefaultHash<const char*>{}(key));
+  REQUIRE(DefaultHash<std::string_view>{}(view) == DefaultHash<const char*>{}(key));
+
+  REQUIRE(DefaultEquality<std::string_view>{}(view, std::string_view{key}));
+  REQUIRE_FALSE(DefaultEquality<std::string_view>{}(view, view.substr(1)));
+  REQUIRE_FALSE(DefaultEquality<std::string>{}(string, string + "!"));
+
+  // Other types keep std::hash
+  REQUIRE(DefaultHash<int>{}(42) == std::hash<int>{}(42));
+}
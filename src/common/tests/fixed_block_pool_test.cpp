@@ -0,0 +1,128 @@
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "fixed_block_pool.h"
+#include "literal_operators.h"
+
+using namespace CppTraining;
+
+SCENARIO("Exercising FixedBlockPool", "[fixed_block_pool]")
+{
+  GIVEN("A pool of 4-byte blocks with 8 blocks per chunk")
+  {
+    FixedBlockPool pool{sizeof(std::int32_t), alignof(std::int32_t), 8_z};
+
+    THEN("Blocks are large enough to hold a free list link")
+    {
+      REQUIRE(pool.block_size() == sizeof(void*));
+      REQUIRE(pool.blocks_in_use() == 0_z);
+      REQUIRE(pool.chunk_count() == 0_z);
+    }
+
+    WHEN("A chunk's worth of blocks is allocated")
+    {
+      std::vector<void*> blocks;
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        blocks.push_back(pool.allocate());
+      }
+
+      THEN("They are distinct, adjacent and come from a single chunk")
+      {
+        REQUIRE(std::set<void*>(blocks.begin(), blocks.end()).size() == 8_z);
+        REQUIRE(static_cast<std::byte*>(blocks.back()) ==
+                static_cast<std::byte*>(blocks.front()) + 7 * pool.block_size());
+        REQUIRE(pool.blocks_in_use() == 8_z);
+        REQUIRE(pool.chunk_count() == 1_z);
+      }
+
+      AND_WHEN("One more block is allocated")
+      {
+        blocks.push_back(pool.allocate());
+
+        THEN("A second chunk is added")
+        {
+          REQUIRE(pool.chunk_count() == 2_z);
+        }
+      }
+
+      AND_WHEN("A block is deallocated")
+      {
+        pool.deallocate(blocks[3]);
+
+        THEN("It is the next one handed out")
+        {
+          REQUIRE(pool.blocks_in_use() == 7_z);
+          REQUIRE(pool.allocate() == blocks[3]);
+          REQUIRE(pool.chunk_count() == 1_z);
+        }
+      }
+
+      for (auto block : blocks)
+      {
+        pool.deallocate(block);
+      }
+    }
+
+    WHEN("A null block is deallocated")
+    {
+      pool.deallocate(nullptr);
+
+      THEN("Nothing happens")
+      {
+        REQUIRE(pool.blocks_in_use() == 0_z);
+      }
+    }
+  }
+
+  GIVEN("A pool with over-aligned blocks")
+  {
+    FixedBlockPool pool{24_z, 64_z, 4_z};
+
+    THEN("Every block honours the alignment")
+    {
+      REQUIRE(pool.block_size() == 64_z);
+
+      std::vector<void*> blocks;
+      for (std::size_t i = 0; i < 10; ++i)
+      {
+        blocks.push_back(pool.allocate());
+        REQUIRE(reinterpret_cast<std::uintptr_t>(blocks.back()) % 64 == 0);
+      }
+
+      for (auto block : blocks)
+      {
+        pool.deallocate(block);
+      }
+    }
+  }
+
+  GIVEN("Two pools of the same block size")
+  {
+    FixedBlockPool one{sizeof(std::int32_t)};
+    FixedBlockPool two{sizeof(std::int32_t)};
+
+    WHEN("A block from one pool is returned to the other")
+    {
+      auto block = one.allocate();
+      two.deallocate(block);
+
+      THEN("The other pool hands it out again")
+      {
+        REQUIRE(two.allocate() == block);
+        one.deallocate(block);
+      }
+    }
+  }
+}
+
+TEST_CASE("thread_local_pool", "[fixed_block_pool]")
+{
+  auto& pool = thread_local_pool<sizeof(std::int32_t), alignof(std::int32_t)>();
+
+  REQUIRE(&pool == &thread_local_pool<sizeof(std::int32_t), alignof(std::int32_t)>());
+  REQUIRE(&pool != &thread_local_pool<sizeof(double), alignof(double)>());
+}
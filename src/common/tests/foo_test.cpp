@@ -1,5 +1,8 @@
+#include <utility>
+
 #include <catch2/catch_all.hpp>
 
+#include "fixed_block_pool.h"
 #include "foo.h"
 
 using namespace CppTraining;
@@ -59,6 +62,19 @@ SCENARIO("Exercising Foo", "[Foo]")
       }
     }
 
+    WHEN("A moved-from Foo is copy-assigned from a")
+    {
+      Foo b{100};
+      Foo c{std::move(b)};
+      b = a;
+
+      THEN("It holds a's value again")
+      {
+        REQUIRE(b.getData() == 42);
+        REQUIRE(c.getData() == 100);
+      }
+    }
+
     WHEN("Another Foo is move-assigned from a")
     {
       Foo b{100};
@@ -85,3 +101,21 @@ TEST_CASE("Explicit destruction of Foo")
   Foo* f = new Foo{42};
   delete f;
 }
+
+#if defined(CPP_TRAINING_FOO_USE_POOL)
+TEST_CASE("Foo draws its data from the thread's pool")
+{
+  auto& pool = thread_local_pool<sizeof(std::int32_t), alignof(std::int32_t)>();
+  const auto blocks_in_use = pool.blocks_in_use();
+
+  {
+    Foo a{42};
+    Foo b{a};
+    Foo c{std::move(b)};
+
+    REQUIRE(pool.blocks_in_use() == blocks_in_use + 2);
+  }
+
+  REQUIRE(pool.blocks_in_use() == blocks_in_use);
+}
+#endif
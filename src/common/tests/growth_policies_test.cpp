@@ -0,0 +1,99 @@
+#include <cstdint>
+
+#include <catch2/catch_all.hpp>
+
+#include "growth_policies.h"
+#include "literal_operators.h"
+
+using namespace CppTraining;
+
+TEST_CASE("DefaultGrowthPolicy doubles", "[growth_policy]")
+{
+  DefaultGrowthPolicy policy;
+  REQUIRE(policy(8_z, 8_z) == 8_z);
+}
+
+TEST_CASE("GeometricGrowthPolicy grows by the configured factor", "[growth_policy]")
+{
+  GeometricGrowthPolicy<> policy;
+  REQUIRE(policy(0_z, 0_z) == 1_z);
+  REQUIRE(policy(1_z, 1_z) == 1_z);
+  REQUIRE(policy(100_z, 100_z) == 50_z);
+
+  GeometricGrowthPolicy<5, 4> slow;
+  REQUIRE(slow(100_z, 100_z) == 25_z);
+}
+
+TEST_CASE("PageAlignedGrowthPolicy rounds large blocks to whole pages", "[growth_policy]")
+{
+  PageAlignedGrowthPolicy<std::uint64_t> policy;
+
+  SECTION("Small blocks double")
+  {
+    REQUIRE(policy(0_z, 0_z) == 1_z);
+    REQUIRE(policy(16_z, 16_z) == 16_z);
+  }
+
+  SECTION("Large blocks end on a page boundary")
+  {
+    const auto capacity = 700_z;
+    const auto new_capacity = capacity + policy(capacity, capacity);
+    REQUIRE(new_capacity * sizeof(std::uint64_t) % 4096 == 0_z);
+    REQUIRE(new_capacity >= capacity * 2);
+  }
+}
+
+TEST_CASE("Size classes", "[growth_policy]")
+{
+  SECTION("jemalloc")
+  {
+    REQUIRE(JemallocSizeClasses::round_up(1_z) == 8_z);
+    REQUIRE(JemallocSizeClasses::round_up(17_z) == 32_z);
+    REQUIRE(JemallocSizeClasses::round_up(128_z) == 128_z);
+    REQUIRE(JemallocSizeClasses::round_up(129_z) == 160_z);
+    REQUIRE(JemallocSizeClasses::round_up(256_z) == 256_z);
+    REQUIRE(JemallocSizeClasses::round_up(257_z) == 320_z);
+    REQUIRE(JemallocSizeClasses::round_up(4097_z) == 5120_z);
+  }
+
+  SECTION("glibc")
+  {
+    REQUIRE(GlibcSizeClasses::round_up(1_z) == 24_z);
+    REQUIRE(GlibcSizeClasses::round_up(24_z) == 24_z);
+    REQUIRE(GlibcSizeClasses::round_up(25_z) == 40_z);
+    REQUIRE(GlibcSizeClasses::round_up(100_z) == 104_z);
+  }
+}
+
+TEST_CASE("SizeClassGrowthPolicy fills the allocator's size class", "[growth_policy]")
+{
+  SizeClassGrowthPolicy<std::uint32_t> policy;
+
+  // 2 * 36 elements * 4 bytes = 288 bytes, which jemalloc rounds up to 320 bytes (80 elements)
+  REQUIRE(policy(36_z, 36_z) == 44_z);
+
+  SizeClassGrowthPolicy<std::uint64_t, GlibcSizeClasses> glibc;
+
+  // 2 * 2 elements * 8 bytes = 32 bytes, which glibc rounds up to 40 bytes (5 elements)
+  REQUIRE(glibc(2_z, 2_z) == 3_z);
+}
+
+TEST_CASE("CappedLinearGrowthPolicy switches to linear growth", "[growth_policy]")
+{
+  CappedLinearGrowthPolicy<1024, 100> policy;
+  REQUIRE(policy(0_z, 0_z) == 1_z);
+  REQUIRE(policy(512_z, 512_z) == 512_z);
+  REQUIRE(policy(1024_z, 1024_z) == 100_z);
+  REQUIRE(policy(5000_z, 5000_z) == 100_z);
+}
+
+TEST_CASE("HugePageGrowthPolicy rounds large blocks to whole huge pages", "[growth_policy]")
+{
+  HugePageGrowthPolicy<std::uint64_t> policy;
+  const auto capacity = 300'000_z;
+  const auto new_capacity = capacity + policy(capacity, capacity);
+  REQUIRE(new_capacity * sizeof(std::uint64_t) % (2_z << 20) == 0_z);
+  REQUIRE(new_capacity >= capacity * 2);
+
+  REQUIRE(policy(16_z, 16_z) == 16_z);
+}
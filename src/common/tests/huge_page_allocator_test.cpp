@@ -0,0 +1,132 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include "allocator_extensions.h"
+#include "huge_page_allocator.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t PageElements = huge_pages::PageSize / sizeof(std::uint64_t);
+
+#if defined(__linux__)
+bool isPageAligned(const void* p)
+{
+  return reinterpret_cast<std::uintptr_t>(p) % huge_pages::PageSize == 0;
+}
+#endif
+
+void fill(std::uint64_t* p, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    p[i] = i * 3;
+  }
+}
+
+bool holds(const std::uint64_t* p, std::size_t count)
+{
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    if (p[i] != i * 3)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("HugePageAllocator provides reallocate", "[allocator][huge_pages]")
+{
+  STATIC_REQUIRE(allocator_extension_traits<HugePageAllocator<int>>::has_reallocate);
+  STATIC_REQUIRE(std::allocator_traits<HugePageAllocator<int>>::is_always_equal::value);
+  REQUIRE(HugePageAllocator<int>{} == HugePageAllocator<std::string>{});
+}
+
+SCENARIO("Exercising HugePageAllocator", "[allocator][huge_pages]")
+{
+  HugePageAllocator<std::uint64_t> allocator;
+
+  GIVEN("A block smaller than a huge page")
+  {
+    std::size_t size = 1000;
+    auto p = allocator.allocate(size);
+    fill(p, size);
+
+    THEN("It comes from the heap")
+    {
+      REQUIRE_FALSE(huge_pages::is_mapped(size * sizeof(std::uint64_t)));
+      REQUIRE(holds(p, size));
+    }
+
+    WHEN("It is reallocated past the threshold and back")
+    {
+      p = allocator.reallocate(p, size, 3 * PageElements);
+      size = 3 * PageElements;
+      REQUIRE(holds(p, 1000));
+      fill(p, size);
+
+      p = allocator.reallocate(p, size, 2000);
+      size = 2000;
+
+      THEN("The contents survive both moves")
+      {
+        REQUIRE(holds(p, size));
+      }
+    }
+
+    allocator.deallocate(p, size);
+  }
+
+  GIVEN("A block of several huge pages")
+  {
+    const auto count = 3 * PageElements + 5;
+    auto size = count;
+    auto p = allocator.allocate(size);
+    fill(p, size);
+
+#if defined(__linux__)
+    THEN("It is aligned to a huge page")
+    {
+      REQUIRE(isPageAligned(p));
+    }
+#endif
+
+    WHEN("It grows many times over")
+    {
+      for (int i = 0; i < 6; ++i)
+      {
+        p = allocator.reallocate(p, size, 2 * size);
+        size *= 2;
+      }
+
+      THEN("Its contents are kept and it stays aligned")
+      {
+        REQUIRE(holds(p, count));
+#if defined(__linux__)
+        REQUIRE(isPageAligned(p));
+#endif
+        fill(p, size);
+        REQUIRE(holds(p, size));
+      }
+
+      AND_WHEN("It shrinks again")
+      {
+        p = allocator.reallocate(p, size, PageElements + 1);
+        size = PageElements + 1;
+
+        THEN("What is left is intact")
+        {
+          REQUIRE(holds(p, size));
+        }
+      }
+    }
+
+    allocator.deallocate(p, size);
+  }
+}
@@ -0,0 +1,166 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "allocation_stats.h"
+#include "allocator_extensions.h"
+#include "instrumented_allocator.h"
+#include "malloc_allocator.h"
+
+using namespace CppTraining;
+
+TEST_CASE("InstrumentedAllocator forwards the inner allocator's traits", "[allocator][stats]")
+{
+  using Plain = InstrumentedAllocator<std::int32_t>;
+  using Malloc = InstrumentedAllocator<std::int32_t, MallocAllocator<std::int32_t>>;
+
+  STATIC_REQUIRE(allocator_extension_traits<Plain>::has_on_growth);
+  STATIC_REQUIRE_FALSE(allocator_extension_traits<Plain>::has_reallocate);
+  STATIC_REQUIRE_FALSE(allocator_extension_traits<Plain>::has_expand_in_place);
+  STATIC_REQUIRE(allocator_extension_traits<Malloc>::has_reallocate);
+  STATIC_REQUIRE(allocator_extension_traits<Malloc>::has_expand_in_place);
+  STATIC_REQUIRE(std::allocator_traits<Plain>::is_always_equal::value);
+  STATIC_REQUIRE(
+    std::is_same_v<std::allocator_traits<Malloc>::rebind_alloc<double>,
+                   InstrumentedAllocator<double, MallocAllocator<double>>>);
+}
+
+SCENARIO("Recording allocations in an AllocationSite", "[allocator][stats]")
+{
+  GIVEN("An allocator recording in a fresh registry")
+  {
+    AllocationStatsRegistry registry;
+    auto& site = registry.site("integers");
+    InstrumentedAllocator<std::int32_t> allocator{site};
+
+    WHEN("Blocks are allocated and one of them is freed")
+    {
+      auto small = allocator.allocate(4);
+      auto large = allocator.allocate(1000);
+      allocator.deallocate(large, 1000);
+
+      THEN("The counts, bytes and peak reflect every request")
+      {
+        const auto stats = site.snapshot();
+        REQUIRE(stats.name == "integers");
+        REQUIRE(stats.allocations == 2);
+        REQUIRE(stats.deallocations == 1);
+        REQUIRE(stats.bytes_allocated == 4016);
+        REQUIRE(stats.bytes_deallocated == 4000);
+        REQUIRE(stats.live_bytes == 16);
+        REQUIRE(stats.peak_live_bytes == 4016);
+      }
+
+      THEN("Each request lands in the bucket of its power-of-two size")
+      {
+        const auto stats = site.snapshot();
+        REQUIRE(stats.size_histogram[AllocationSite::size_bucket(16)] == 1);
+        REQUIRE(stats.size_histogram[AllocationSite::size_bucket(4000)] == 1);
+        REQUIRE(AllocationSiteStats::bucket_limit(AllocationSite::size_bucket(16)) == 16);
+        REQUIRE(AllocationSiteStats::bucket_limit(AllocationSite::size_bucket(4000)) == 4096);
+      }
+
+      allocator.deallocate(small, 4);
+    }
+
+    WHEN("A rebound copy of the allocator allocates")
+    {
+      std::allocator_traits<InstrumentedAllocator<std::int32_t>>::rebind_alloc<double> rebound{
+        allocator};
+      rebound.deallocate(rebound.allocate(2), 2);
+
+      THEN("It records in the same site")
+      {
+        REQUIRE(registry.find("integers")->allocations == 1);
+        REQUIRE(registry.find("integers")->bytes_allocated == 2 * sizeof(double));
+      }
+    }
+
+    WHEN("A container reports that it grew")
+    {
+      allocator.on_growth(4, 4, 8);
+
+      THEN("The growth event and the capacity it added are recorded")
+      {
+        const auto stats = site.snapshot();
+        REQUIRE(stats.growth_events == 1);
+        REQUIRE(stats.growth_bytes == 16);
+      }
+    }
+
+    WHEN("Several threads allocate through the same site")
+    {
+      constexpr std::size_t ThreadCount = 4;
+      constexpr std::size_t AllocationsPerThread = 10'000;
+
+      std::vector<std::thread> threads;
+      for (std::size_t t = 0; t < ThreadCount; ++t)
+      {
+        threads.emplace_back([allocator]() mutable {
+          for (std::size_t i = 0; i < AllocationsPerThread; ++i)
+          {
+            allocator.deallocate(allocator.allocate(8), 8);
+          }
+        });
+      }
+      for (auto& thread : threads)
+      {
+        thread.join();
+      }
+
+      THEN("No allocation is lost")
+      {
+        const auto stats = site.snapshot();
+        REQUIRE(stats.allocations == ThreadCount * AllocationsPerThread);
+        REQUIRE(stats.deallocations == ThreadCount * AllocationsPerThread);
+        REQUIRE(stats.live_bytes == 0);
+        REQUIRE(stats.peak_live_bytes >= 32);
+        REQUIRE(stats.peak_live_bytes <= static_cast<std::int64_t>(32 * ThreadCount));
+      }
+    }
+  }
+}
+
+SCENARIO("Querying an AllocationStatsRegistry", "[stats]")
+{
+  GIVEN("A registry with two sites")
+  {
+    AllocationStatsRegistry registry;
+    InstrumentedAllocator<std::int32_t> parser{registry.site("orders \"parser\"")};
+    InstrumentedAllocator<std::int32_t> cache{registry.site("cache")};
+    auto p = parser.allocate(3);
+    cache.deallocate(cache.allocate(1), 1);
+
+    THEN("Looking a site up by name returns the same site")
+    {
+      REQUIRE(&registry.site("cache") == &cache.site());
+      REQUIRE(registry.find("cache")->allocations == 1);
+      REQUIRE_FALSE(registry.find("unknown").has_value());
+    }
+
+    THEN("A snapshot lists every site in name order")
+    {
+      const auto sites = registry.snapshot();
+      REQUIRE(sites.size() == 2);
+      REQUIRE(sites[0].name == "cache");
+      REQUIRE(sites[1].name == "orders \"parser\"");
+      REQUIRE(sites[1].live_bytes == 12);
+    }
+
+    THEN("The JSON dump holds every site's counters")
+    {
+      const auto json = registry.to_json();
+      REQUIRE(json.find("\"name\": \"orders \\\"parser\\\"\"") != std::string::npos);
+      REQUIRE(json.find("\"live_bytes\": 12") != std::string::npos);
+      REQUIRE(json.find("{\"max_bytes\": 16, \"count\": 1}") != std::string::npos);
+    }
+
+    parser.deallocate(p, 3);
+  }
+}
@@ -0,0 +1,89 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include "allocator_extensions.h"
+#include "malloc_allocator.h"
+
+using namespace CppTraining;
+
+TEST_CASE("Allocator extensions are detected", "[allocator]")
+{
+  STATIC_REQUIRE(allocator_extension_traits<MallocAllocator<int>>::has_reallocate);
+  STATIC_REQUIRE(allocator_extension_traits<MallocAllocator<int>>::has_expand_in_place);
+  STATIC_REQUIRE_FALSE(allocator_extension_traits<std::allocator<int>>::has_reallocate);
+  STATIC_REQUIRE_FALSE(allocator_extension_traits<std::allocator<int>>::has_expand_in_place);
+}
+
+SCENARIO("Exercising MallocAllocator", "[allocator]")
+{
+  GIVEN("A block of 16 integers")
+  {
+    MallocAllocator<std::int32_t> allocator;
+    auto p = allocator.allocate(16);
+    for (std::int32_t i = 0; i < 16; ++i)
+    {
+      p[i] = i;
+    }
+
+    WHEN("The block is reallocated to a larger size")
+    {
+      p = allocator.reallocate(p, 16, 4096);
+
+      THEN("The original contents are preserved")
+      {
+        for (std::int32_t i = 0; i < 16; ++i)
+        {
+          REQUIRE(p[i] == i);
+        }
+      }
+    }
+
+    WHEN("The block is expanded in place")
+    {
+      const auto old_p = p;
+      const bool expanded = allocator.expand_in_place(p, 16, 17);
+
+      THEN("The block never moves")
+      {
+        REQUIRE(p == old_p);
+        if (expanded)
+        {
+          p[16] = 16;
+          REQUIRE(p[15] == 15);
+        }
+      }
+    }
+
+#if !defined(_MSC_VER)
+    WHEN("The block is expanded in place without _expand")
+    {
+      THEN("It reports failure, even if malloc left room after the block")
+      {
+        REQUIRE_FALSE(allocator.expand_in_place(p, 16, 17));
+      }
+    }
+#endif
+
+    WHEN("Expanding in place would need far more memory than the block has")
+    {
+      THEN("It reports failure")
+      {
+        REQUIRE_FALSE(allocator.expand_in_place(p, 16, 1'000'000));
+      }
+    }
+
+    allocator.deallocate(p, 16);
+  }
+
+  GIVEN("Two allocators of different types")
+  {
+    THEN("They always compare equal")
+    {
+      REQUIRE(MallocAllocator<int>{} == MallocAllocator<std::string>{});
+      REQUIRE_FALSE(MallocAllocator<int>{} != MallocAllocator<std::string>{});
+    }
+  }
+}
@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#if defined(__unix__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "simd_algorithms.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr simd::InstructionSet InstructionSets[] = {
+  simd::InstructionSet::Scalar, simd::InstructionSet::Sse2, simd::InstructionSet::Avx2};
+
+/// @brief Runs check once for every instruction set this CPU supports, then restores the original.
+template <typename Check>
+void forEachInstructionSet(Check check)
+{
+  const auto original = simd::instruction_set();
+  for (auto instruction_set : InstructionSets)
+  {
+    if (simd::set_instruction_set(instruction_set) == instruction_set)
+    {
+      check();
+    }
+  }
+  simd::set_instruction_set(original);
+}
+
+/// @brief Small values, so that every search has matches, ties and misses.
+template <typename T>
+std::vector<T> makeValues(std::size_t count)
+{
+  std::mt19937 engine{11};
+  std::uniform_int_distribution<int> distribution{0, 40};
+
+  std::vector<T> values(count);
+  for (auto& value : values)
+  {
+    value = static_cast<T>(distribution(engine));
+  }
+
+  return values;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("SIMD kernels agree with the standard algorithms",
+                   "[simd]",
+                   std::int8_t,
+                   std::uint8_t,
+                   std::int16_t,
+                   std::uint16_t,
+                   std::int32_t,
+                   std::uint32_t,
+                   std::int64_t,
+                   std::uint64_t,
+                   float,
+                   double,
+                   char,
+                   long long)
+{
+  STATIC_REQUIRE(simd::is_supported_v<TestType>);
+
+  // Offsets into the buffer move the arrays off any vector alignment; sizes straddle every
+  // vector width and the four-vector steps
+  const auto buffer = makeValues<TestType>(1100);
+  const std::size_t sizes[] = {
+    0, 1, 2, 3, 5, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 129, 1027};
+
+  forEachInstructionSet([&] {
+    for (std::size_t offset = 0; offset < 4; ++offset)
+    {
+      for (auto size : sizes)
+      {
+        const TestType* data = buffer.data() + offset;
+        const auto end = data + size;
+        CAPTURE(simd::instruction_set(), offset, size);
+
+        for (const auto value : {TestType{0}, TestType{17}, TestType{41}})
+        {
+          REQUIRE(simd::find(data, size, value) ==
+                  static_cast<std::size_t>(std::find(data, end, value) - data));
+          REQUIRE(simd::count(data, size, value) ==
+                  static_cast<std::size_t>(std::count(data, end, value)));
+        }
+
+        REQUIRE(simd::min_element(data, size) ==
+                static_cast<std::size_t>(std::min_element(data, end) - data));
+        REQUIRE(simd::max_element(data, size) ==
+                static_cast<std::size_t>(std::max_element(data, end) - data));
+
+        std::vector<TestType> copy(data, end);
+        REQUIRE(simd::equal(data, copy.data(), size));
+        if (size != 0)
+        {
+          copy[size - 1] = TestType{99};
+          REQUIRE_FALSE(simd::equal(data, copy.data(), size));
+          copy[size - 1] = data[size - 1];
+          copy[0] = TestType{99};
+          REQUIRE_FALSE(simd::equal(data, copy.data(), size));
+        }
+      }
+    }
+  });
+}
+
+TEST_CASE("SIMD count does not overflow narrow lanes", "[simd]")
+{
+  const std::vector<std::uint8_t> values(100'003, std::uint8_t{7});
+
+  forEachInstructionSet([&] {
+    CAPTURE(simd::instruction_set());
+    REQUIRE(simd::count(values.data(), values.size(), 7) == values.size());
+  });
+}
+
+TEST_CASE("SIMD kernels treat NaN and signed zeros like the standard algorithms", "[simd]")
+{
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+
+  forEachInstructionSet([&] {
+    CAPTURE(simd::instruction_set());
+
+    std::vector<double> values(40, 3.0);
+    values[1] = nan;
+    values[17] = 0.5;
+    values[33] = nan;
+    values[38] = 9.0;
+
+    REQUIRE(simd::min_element(values.data(), values.size()) == 17);
+    REQUIRE(simd::max_element(values.data(), values.size()) == 38);
+    REQUIRE(simd::find(values.data(), values.size(), nan) == values.size());
+    REQUIRE(simd::count(values.data(), values.size(), nan) == 0);
+    REQUIRE_FALSE(simd::equal(values.data(), values.data(), values.size()));
+
+    values[0] = nan;
+    REQUIRE(simd::min_element(values.data(), values.size()) == 0);
+    REQUIRE(simd::max_element(values.data(), values.size()) == 0);
+
+    const std::vector<double> zeros(20, 1.0);
+    auto signed_zeros = zeros;
+    signed_zeros[5] = 0.0;
+    signed_zeros[9] = -0.0;
+    REQUIRE(simd::min_element(signed_zeros.data(), signed_zeros.size()) == 5);
+    REQUIRE(simd::find(signed_zeros.data(), signed_zeros.size(), -0.0) == 5);
+  });
+}
+
+TEST_CASE("SIMD instruction set selection", "[simd]")
+{
+  STATIC_REQUIRE_FALSE(simd::is_supported_v<bool>);
+  STATIC_REQUIRE_FALSE(simd::is_supported_v<long double>);
+  STATIC_REQUIRE_FALSE(simd::is_supported_v<std::string>);
+
+  const auto original = simd::instruction_set();
+  REQUIRE(original == simd::best_instruction_set());
+
+  REQUIRE(simd::set_instruction_set(simd::InstructionSet::Scalar) ==
+          simd::InstructionSet::Scalar);
+  REQUIRE(simd::instruction_set() == simd::InstructionSet::Scalar);
+
+  // Asking for more than the CPU has settles for the best it does have
+  REQUIRE(simd::set_instruction_set(simd::InstructionSet::Avx2) == simd::best_instruction_set());
+
+  simd::set_instruction_set(original);
+}
+
+TEST_CASE("SIMD string kernels agree with strcmp and strlen", "[simd]")
+{
+  // Strings of every length up to a few vectors, differing at every position, at every offset
+  // from a vector boundary
+  std::string buffer(200, '\0');
+  std::string other(200, '\0');
+
+  forEachInstructionSet([&] {
+    for (std::size_t offset = 0; offset < 4; ++offset)
+    {
+      for (std::size_t length = 0; length < 100; ++length)
+      {
+        CAPTURE(simd::instruction_set(), offset, length);
+
+        char* lhs = buffer.data() + offset;
+        char* rhs = other.data() + 3 - offset;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+          lhs[i] = rhs[i] = static_cast<char>('a' + i % 26);
+        }
+        lhs[length] = rhs[length] = '\0';
+
+        REQUIRE(simd::string_length(lhs) == length);
+        REQUIRE(simd::string_equal(lhs, rhs));
+        REQUIRE(simd::string_equal(lhs, length, rhs, length));
+        REQUIRE(simd::string_hash(lhs) == simd::string_hash(rhs, length));
+
+        for (std::size_t i = 0; i < length; i += 7)
+        {
+          rhs[i] = 'Z';
+          REQUIRE_FALSE(simd::string_equal(lhs, rhs));
+          REQUIRE_FALSE(simd::string_equal(lhs, length, rhs, length));
+          REQUIRE(simd::string_hash(lhs) != simd::string_hash(rhs));
+          rhs[i] = lhs[i];
+        }
+
+        // A prefix is not equal, although the characters it has match
+        rhs[length] = 'x';
+        rhs[length + 1] = '\0';
+        REQUIRE_FALSE(simd::string_equal(lhs, rhs));
+        REQUIRE_FALSE(simd::string_equal(rhs, lhs));
+        REQUIRE_FALSE(simd::string_equal(lhs, length, rhs, length + 1));
+        REQUIRE(simd::string_hash(lhs) != simd::string_hash(rhs));
+      }
+    }
+  });
+}
+
+TEST_CASE("SIMD string hashes do not depend on the instruction set", "[simd]")
+{
+  const std::string text = "The quick brown fox jumps over the lazy dog, twice over";
+  const auto expected = simd::string_hash(text.c_str());
+
+  forEachInstructionSet([&] {
+    CAPTURE(simd::instruction_set());
+    REQUIRE(simd::string_hash(text.c_str()) == expected);
+    REQUIRE(simd::string_hash(text.data(), text.size()) == expected);
+  });
+
+  // Trailing zeros change the hash through the size
+  REQUIRE(simd::string_hash("ab", 2) != simd::string_hash("ab\0", 3));
+  REQUIRE(simd::string_hash(nullptr, 0) == simd::string_hash(""));
+}
+
+#if defined(__unix__)
+TEST_CASE("SIMD string kernels never read into the next page", "[simd]")
+{
+  // Two pages, the second of which faults when touched; every string ends right before it
+  const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  void* mapping =
+    mmap(nullptr, 2 * page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  REQUIRE(mapping != MAP_FAILED);
+  REQUIRE(mprotect(static_cast<char*>(mapping) + page_size, page_size, PROT_NONE) == 0);
+
+  char* page_end = static_cast<char*>(mapping) + page_size;
+  std::memset(mapping, 'q', page_size);
+  page_end[-1] = '\0';
+
+  const std::string copy(100, 'q');
+
+  forEachInstructionSet([&] {
+    for (std::size_t length = 0; length < 100; ++length)
+    {
+      CAPTURE(simd::instruction_set(), length);
+      const char* string = page_end - 1 - length;
+
+      REQUIRE(simd::string_length(string) == length);
+      REQUIRE(simd::string_equal(string, copy.c_str() + copy.size() - length));
+      REQUIRE_FALSE(simd::string_equal(string, string - 1));
+      REQUIRE(simd::string_hash(string) == simd::string_hash(copy.data(), length));
+    }
+  });
+
+  munmap(mapping, 2 * page_size);
+}
+#endif
@@ -0,0 +1,315 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <catch2/catch_all.hpp>
+
+#include "literal_operators.h"
+#include "thread_pool.h"
+#include "work_stealing_deque.h"
+
+using namespace CppTraining;
+
+namespace
+{
+/// @brief CPU 0 may be outside the process's cpuset (taskset, docker --cpuset-cpus).
+std::size_t firstAllowedCpu()
+{
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+  {
+    for (std::size_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (CPU_ISSET(cpu, &mask))
+      {
+        return cpu;
+      }
+    }
+  }
+#endif
+  return 0;
+}
+} // namespace
+
+SCENARIO("Exercising WorkStealingDeque", "[work_stealing_deque]")
+{
+  GIVEN("A deque with room for 4 items")
+  {
+    WorkStealingDeque<int> deque{3};
+
+    THEN("The capacity is rounded up to a power of two and the deque is empty")
+    {
+      REQUIRE(deque.capacity() == 4_z);
+      REQUIRE(deque.empty());
+      REQUIRE_FALSE(deque.pop());
+      REQUIRE_FALSE(deque.steal());
+    }
+
+    WHEN("Items are pushed")
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        deque.push(i);
+      }
+
+      THEN("The owner pops the newest and thieves steal the oldest")
+      {
+        REQUIRE(deque.size() == 3_z);
+        REQUIRE(deque.pop() == 2);
+        REQUIRE(deque.steal() == 0);
+        REQUIRE(deque.pop() == 1);
+        REQUIRE(deque.empty());
+        REQUIRE_FALSE(deque.pop());
+      }
+    }
+
+    WHEN("More items are pushed than fit")
+    {
+      deque.push(-1);
+      REQUIRE(deque.steal() == -1);
+      for (int i = 0; i < 10; ++i)
+      {
+        deque.push(i);
+      }
+
+      THEN("The deque grows and keeps the items in order")
+      {
+        REQUIRE(deque.capacity() == 16_z);
+        REQUIRE(deque.size() == 10_z);
+        REQUIRE(deque.steal() == 0);
+        REQUIRE(deque.pop() == 9);
+        REQUIRE(deque.steal() == 1);
+      }
+    }
+  }
+
+  GIVEN("An owner pushing and popping while thieves steal")
+  {
+    constexpr int Count = 100'000;
+    WorkStealingDeque<int> deque{2};
+    std::vector<std::atomic<int>> taken(Count);
+    std::atomic<bool> done{false};
+
+    auto take = [&](int item) { taken[static_cast<std::size_t>(item)].fetch_add(1); };
+
+    std::vector<std::thread> thieves;
+    for (int i = 0; i < 3; ++i)
+    {
+      thieves.emplace_back([&] {
+        while (!done.load())
+        {
+          if (const auto item = deque.steal())
+          {
+            take(*item);
+          }
+        }
+      });
+    }
+
+    for (int i = 0; i < Count; ++i)
+    {
+      deque.push(i);
+      if (i % 3 == 0)
+      {
+        if (const auto item = deque.pop())
+        {
+          take(*item);
+        }
+      }
+    }
+    while (const auto item = deque.pop())
+    {
+      take(*item);
+    }
+
+    done.store(true);
+    for (auto& thief : thieves)
+    {
+      thief.join();
+    }
+
+    THEN("Every item is taken exactly once")
+    {
+      REQUIRE(std::all_of(taken.begin(), taken.end(), [](const auto& count) {
+        return count.load() == 1;
+      }));
+    }
+  }
+}
+
+SCENARIO("Exercising ThreadPool", "[thread_pool]")
+{
+  GIVEN("A pool of 4 workers")
+  {
+    ThreadPool pool{4};
+
+    THEN("It has them and the test thread is not one of them")
+    {
+      REQUIRE(pool.worker_count() == 4_z);
+      REQUIRE_FALSE(pool.current_worker());
+    }
+
+    WHEN("Functions are submitted")
+    {
+      auto answer = pool.submit([] { return 42; });
+      auto worker = pool.submit([&pool] { return pool.current_worker(); });
+      auto failure = pool.submit([] { throw std::runtime_error{"failed"}; });
+
+      THEN("Their futures hold what they returned or threw")
+      {
+        REQUIRE(answer.get() == 42);
+        REQUIRE(worker.get().value() < 4_z);
+        REQUIRE_THROWS_AS(failure.get(), std::runtime_error);
+      }
+    }
+
+    WHEN("parallel_for runs over a range")
+    {
+      std::vector<std::atomic<int>> visits(10'000);
+      pool.parallel_for(100, visits.size(), [&](std::size_t i) { visits[i].fetch_add(1); }, 7);
+
+      THEN("It visits every index in the range once")
+      {
+        REQUIRE(std::all_of(visits.begin(), visits.begin() + 100, [](const auto& count) {
+          return count.load() == 0;
+        }));
+        REQUIRE(std::all_of(visits.begin() + 100, visits.end(), [](const auto& count) {
+          return count.load() == 1;
+        }));
+      }
+    }
+
+    WHEN("parallel_for_ranges picks the grain size")
+    {
+      std::atomic<std::size_t> covered{0};
+      std::atomic<std::size_t> largest{0};
+      pool.parallel_for_ranges(0, 100'000, [&](std::size_t first, std::size_t last) {
+        covered.fetch_add(last - first);
+        auto seen = largest.load();
+        while (seen < last - first && !largest.compare_exchange_weak(seen, last - first))
+        {
+        }
+      });
+
+      THEN("The subranges cover the range and give each worker several of them")
+      {
+        REQUIRE(covered.load() == 100'000_z);
+        REQUIRE(largest.load() <= 100'000_z / 4 / 8);
+      }
+    }
+
+    WHEN("parallel_for calls are nested")
+    {
+      std::vector<std::atomic<int>> sums(64);
+      pool.parallel_for(
+        0,
+        sums.size(),
+        [&](std::size_t i) {
+          pool.parallel_for(0, 1000, [&](std::size_t j) { sums[i].fetch_add(int(j)); }, 10);
+        },
+        1);
+
+      THEN("Every inner loop completes")
+      {
+        REQUIRE(std::all_of(sums.begin(), sums.end(), [](const auto& sum) {
+          return sum.load() == 999 * 1000 / 2;
+        }));
+      }
+    }
+
+    WHEN("The body of a parallel_for throws")
+    {
+      std::atomic<int> calls{0};
+      auto loop = [&] {
+        pool.parallel_for(
+          0,
+          1000,
+          [&](std::size_t i) {
+            calls.fetch_add(1);
+            if (i == 500)
+            {
+              throw std::out_of_range{"500"};
+            }
+          },
+          1);
+      };
+
+      THEN("The exception reaches the caller and the pool keeps working")
+      {
+        REQUIRE_THROWS_AS(loop(), std::out_of_range);
+        REQUIRE(calls.load() <= 1000);
+        REQUIRE(pool.submit([] { return 1; }).get() == 1);
+      }
+    }
+  }
+
+  GIVEN("A pool that is destroyed with tasks still queued")
+  {
+    std::atomic<int> runs{0};
+    {
+      ThreadPool pool{2};
+      for (int i = 0; i < 100; ++i)
+      {
+        static_cast<void>(pool.submit([&runs] { runs.fetch_add(1); }));
+      }
+    }
+
+    THEN("Every task ran first")
+    {
+      REQUIRE(runs.load() == 100);
+    }
+  }
+
+#if defined(__linux__) || defined(_WIN32)
+  GIVEN("A pool with its workers pinned to the first CPU the process may use")
+  {
+    ThreadPoolOptions options;
+    options.worker_count = 2;
+    options.pin_workers = true;
+    options.cpus = {firstAllowedCpu()};
+    ThreadPool pool{options};
+
+    THEN("They run tasks as usual")
+    {
+      std::vector<int> values(1000);
+      pool.parallel_for(0, values.size(), [&](std::size_t i) { values[i] = int(i); });
+      REQUIRE(std::accumulate(values.begin(), values.end(), 0) == 999 * 1000 / 2);
+    }
+  }
+
+  GIVEN("A pool pinned without a list of CPUs")
+  {
+    ThreadPoolOptions options;
+    options.worker_count = 3;
+    options.pin_workers = true;
+    ThreadPool pool{options};
+
+    THEN("Its workers are spread over the CPUs the process may use")
+    {
+      std::vector<int> values(1000);
+      pool.parallel_for(0, values.size(), [&](std::size_t i) { values[i] = int(i); });
+      REQUIRE(std::accumulate(values.begin(), values.end(), 0) == 999 * 1000 / 2);
+    }
+  }
+#endif
+
+  GIVEN("The global pool")
+  {
+    THEN("It has a worker per hardware thread")
+    {
+      REQUIRE(&ThreadPool::global() == &ThreadPool::global());
+      REQUIRE(ThreadPool::global().worker_count() ==
+              std::max<std::size_t>(1, std::thread::hardware_concurrency()));
+    }
+  }
+}
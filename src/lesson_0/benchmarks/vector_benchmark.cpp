@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "benchmark_elements.h"
+#include "foo.h"
+#include "throwing_copy.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 100'000;
+
+template <typename Container, typename T>
+Container makeContainer(const std::vector<T>& values)
+{
+  Container container;
+  container.reserve(values.size());
+  for (const auto& value : values)
+  {
+    container.push_back(value);
+  }
+
+  return container;
+}
+
+// The lesson 0 Vector has no iterators yet, so elements are visited by index and sorted through
+// pointers to its contiguous storage
+template <typename Container>
+auto* firstElement(Container& values)
+{
+  return &values[0];
+}
+
+template <typename Container, typename T>
+void benchmarkContainer(const char* container_name)
+{
+  using Element = BenchmarkElement<T>;
+
+  const std::string name = std::string{container_name} + "<" + Element::name + "> ";
+  const auto inputs = makeBenchmarkValues<T>(ElementCount);
+  const auto indices = makeBenchmarkIndices(ElementCount, ElementCount);
+  const auto source = makeContainer<Container>(inputs);
+
+  BENCHMARK(name + "push_back (regrow)")
+  {
+    Container values;
+    for (const auto& input : inputs)
+    {
+      values.push_back(input);
+    }
+    return values.size();
+  };
+
+  BENCHMARK(name + "push_back (reserved)")
+  {
+    Container values;
+    values.reserve(inputs.size());
+    for (const auto& input : inputs)
+    {
+      values.push_back(input);
+    }
+    return values.size();
+  };
+
+  BENCHMARK(name + "copy")
+  {
+    Container values{source};
+    return values.size();
+  };
+
+  BENCHMARK_ADVANCED(name + "move")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<Container> runs(static_cast<std::size_t>(meter.runs()), source);
+    meter.measure([&runs](int run) {
+      Container values{std::move(runs[static_cast<std::size_t>(run)])};
+      return values.size();
+    });
+  };
+
+  BENCHMARK(name + "iteration")
+  {
+    std::int64_t sum = 0;
+    for (std::size_t i = 0; i < source.size(); ++i)
+    {
+      sum += Element::key(source[i]);
+    }
+    return sum;
+  };
+
+  BENCHMARK(name + "random access")
+  {
+    std::int64_t sum = 0;
+    for (auto index : indices)
+    {
+      sum += Element::key(source[index]);
+    }
+    return sum;
+  };
+
+  BENCHMARK_ADVANCED(name + "std::sort")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<Container> runs(static_cast<std::size_t>(meter.runs()), source);
+    meter.measure([&runs](int run) {
+      auto& values = runs[static_cast<std::size_t>(run)];
+      auto first = firstElement(values);
+      std::sort(first, first + values.size(), Element::less);
+      return values.size();
+    });
+  };
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("lesson_0 Vector against std::vector",
+                   "[vector][benchmark]",
+                   int,
+                   Foo,
+                   std::string,
+                   ThrowingCopy)
+{
+  benchmarkContainer<std::vector<TestType>, TestType>("std::vector");
+  benchmarkContainer<Vector<TestType>, TestType>("Vector");
+}
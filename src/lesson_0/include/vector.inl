@@ -27,7 +27,7 @@ Vector<T>::Vector(std::initializer_list<value_type> values) : Vector(values.size
 }
 
 template <typename T>
-Vector<T>::Vector(const Vector& other) : Vector{other.capacity_}
+Vector<T>::Vector(const Vector& other) : Vector(other.capacity_)
 {
   if (capacity_ > 0_z)
   {
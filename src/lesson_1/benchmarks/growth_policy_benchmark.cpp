@@ -0,0 +1,238 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "growth_policies.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+/// @brief Tracks the bytes a workload holds from the allocator, including the moment during
+/// regrowth when the old and new blocks are both alive.
+template <typename T>
+class FootprintAllocator final
+{
+public:
+  using value_type = T;
+
+  FootprintAllocator() = default;
+  template <class U>
+  FootprintAllocator(const FootprintAllocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    live_bytes += n * sizeof(T);
+    peak_bytes = std::max(peak_bytes, live_bytes);
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept
+  {
+    live_bytes -= n * sizeof(T);
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  static void reset()
+  {
+    live_bytes = 0;
+    peak_bytes = 0;
+  }
+
+  static inline std::size_t live_bytes{0};
+  static inline std::size_t peak_bytes{0};
+};
+
+template <typename T, typename U>
+bool operator==(const FootprintAllocator<T>&, const FootprintAllocator<U>&) noexcept
+{
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const FootprintAllocator<T>&, const FootprintAllocator<U>&) noexcept
+{
+  return false;
+}
+
+using value_type = std::uint64_t;
+
+struct Workload
+{
+  const char* name;
+  std::size_t vector_count;
+  std::size_t elements_per_vector;
+};
+
+const Workload Workloads[] = {
+  {"10k vectors x 12", 10'000, 12},
+  {"100 vectors x 10k", 100, 10'000},
+  {"1 vector x 4M", 1, 4'000'000},
+};
+
+struct Footprint
+{
+  std::size_t peak_bytes;
+  std::size_t capacity_bytes;
+  std::size_t size_bytes;
+};
+
+template <typename Policy>
+Footprint runWorkload(const Workload& workload)
+{
+  using VectorType = Vector<value_type, FootprintAllocator<value_type>, Policy>;
+
+  std::vector<VectorType> vectors(workload.vector_count);
+  for (auto& values : vectors)
+  {
+    for (std::size_t i = 0; i < workload.elements_per_vector; ++i)
+    {
+      values.push_back(i);
+    }
+  }
+
+  Footprint footprint{FootprintAllocator<value_type>::peak_bytes, 0, 0};
+  for (const auto& values : vectors)
+  {
+    footprint.capacity_bytes += values.capacity() * sizeof(value_type);
+    footprint.size_bytes += values.size() * sizeof(value_type);
+  }
+
+  return footprint;
+}
+
+/// @brief Growth in peak resident set size (in KiB) of a child process that runs just this
+/// workload. Returns 0 where that cannot be measured.
+template <typename Policy>
+long peakRssKiB(const Workload& workload)
+{
+#if defined(__linux__)
+  // The child starts out with the parent's resident pages, so measure relative to those
+  long resident_pages = 0;
+  if (auto statm = std::fopen("/proc/self/statm", "r"))
+  {
+    long size_pages = 0;
+    if (std::fscanf(statm, "%ld %ld", &size_pages, &resident_pages) != 2)
+    {
+      resident_pages = 0;
+    }
+    std::fclose(statm);
+  }
+
+  const pid_t pid = fork();
+  if (pid == 0)
+  {
+    runWorkload<Policy>(workload);
+    _exit(0);
+  }
+
+  int status = 0;
+  rusage usage{};
+  if (pid < 0 || wait4(pid, &status, 0, &usage) != pid)
+  {
+    return 0;
+  }
+
+  return std::max(0L, usage.ru_maxrss - resident_pages * (sysconf(_SC_PAGESIZE) / 1024));
+#else
+  (void)workload;
+  return 0;
+#endif
+}
+
+template <typename Policy>
+void reportFootprint(const char* policy_name)
+{
+  for (const auto& workload : Workloads)
+  {
+    FootprintAllocator<value_type>::reset();
+    const auto footprint = runWorkload<Policy>(workload);
+    const auto wasted = footprint.capacity_bytes - footprint.size_bytes;
+
+    std::cout << std::left << std::setw(24) << policy_name << std::setw(20) << workload.name
+              << std::right << std::setw(14) << footprint.peak_bytes / 1024 << std::setw(14)
+              << peakRssKiB<Policy>(workload) << std::setw(12) << wasted / 1024 << std::setw(9)
+              << std::fixed << std::setprecision(1)
+              << 100.0 * static_cast<double>(wasted) / static_cast<double>(footprint.capacity_bytes)
+              << "%\n";
+  }
+}
+
+template <typename Policy>
+void benchmarkPolicy(const char* policy_name)
+{
+  for (const auto& workload : Workloads)
+  {
+    BENCHMARK(std::string{policy_name} + " / " + workload.name)
+    {
+      return runWorkload<Policy>(workload).size_bytes;
+    };
+  }
+}
+
+template <typename... Policies>
+struct PolicyList
+{
+};
+
+using Policies = PolicyList<DefaultGrowthPolicy,
+                            GeometricGrowthPolicy<>,
+                            PageAlignedGrowthPolicy<value_type>,
+                            SizeClassGrowthPolicy<value_type>,
+                            SizeClassGrowthPolicy<value_type, GlibcSizeClasses>,
+                            CappedLinearGrowthPolicy<>,
+                            HugePageGrowthPolicy<value_type>>;
+
+const char* const PolicyNames[] = {"Default (2x)",
+                                   "Geometric (1.5x)",
+                                   "PageAligned",
+                                   "SizeClass (jemalloc)",
+                                   "SizeClass (glibc)",
+                                   "CappedLinear (1M)",
+                                   "HugePage"};
+
+template <typename... Ts>
+void reportFootprints(PolicyList<Ts...>)
+{
+  std::size_t index = 0;
+  (reportFootprint<Ts>(PolicyNames[index++]), ...);
+}
+
+template <typename... Ts>
+void benchmarkPolicies(PolicyList<Ts...>)
+{
+  std::size_t index = 0;
+  (benchmarkPolicy<Ts>(PolicyNames[index++]), ...);
+}
+} // namespace
+
+TEST_CASE("Growth policy memory footprint", "[growth_policy][benchmark]")
+{
+  std::cout << std::left << std::setw(24) << "policy" << std::setw(20) << "workload" << std::right
+            << std::setw(14) << "peak KiB" << std::setw(14) << "peak RSS KiB" << std::setw(12)
+            << "wasted KiB" << std::setw(10) << "wasted" << '\n';
+
+  reportFootprints(Policies{});
+}
+
+TEST_CASE("Growth policy push_back throughput", "[growth_policy][benchmark]")
+{
+  benchmarkPolicies(Policies{});
+}
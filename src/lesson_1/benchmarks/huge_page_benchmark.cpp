@@ -0,0 +1,77 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "huge_page_allocator.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+// 512 MiB: far more than the TLB covers in 4 KiB pages, comfortably within it in 2 MiB pages
+constexpr std::size_t ElementCount = std::size_t{64} << 20;
+constexpr std::size_t GatherCount = 4'000'000;
+
+template <typename Allocator>
+Vector<std::uint64_t, Allocator> makeValues()
+{
+  Vector<std::uint64_t, Allocator> values;
+  values.resize(ElementCount);
+  for (std::size_t i = 0; i < ElementCount; ++i)
+  {
+    values[i] = i;
+  }
+  return values;
+}
+
+std::vector<std::size_t> makeIndices()
+{
+  std::mt19937_64 engine{42};
+  std::uniform_int_distribution<std::size_t> distribution{0, ElementCount - 1};
+
+  std::vector<std::size_t> indices(GatherCount);
+  for (auto& index : indices)
+  {
+    index = distribution(engine);
+  }
+  return indices;
+}
+
+template <typename Values>
+std::uint64_t gather(const Values& values, const std::vector<std::size_t>& indices)
+{
+  const auto* data = values.data();
+  std::uint64_t sum = 0;
+  for (const auto index : indices)
+  {
+    sum += data[index];
+  }
+  return sum;
+}
+} // namespace
+
+TEST_CASE("Random gather over 4 KiB and 2 MiB pages", "[huge_pages][benchmark]")
+{
+  const auto indices = makeIndices();
+
+  {
+    const auto values = makeValues<std::allocator<std::uint64_t>>();
+    BENCHMARK("std::allocator random gather") { return gather(values, indices); };
+  }
+
+  {
+    const auto values = makeValues<HugePageAllocator<std::uint64_t>>();
+    BENCHMARK("HugePageAllocator random gather") { return gather(values, indices); };
+  }
+
+  BENCHMARK("std::allocator build") { return makeValues<std::allocator<std::uint64_t>>().size(); };
+  BENCHMARK("HugePageAllocator build")
+  {
+    return makeValues<HugePageAllocator<std::uint64_t>>().size();
+  };
+}
@@ -0,0 +1,77 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "benchmark_elements.h"
+#include "foo.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 10'000;
+
+struct Position
+{
+  const char* name;
+  std::size_t numerator;
+  std::size_t denominator;
+};
+
+const Position Positions[] = {{"front", 0, 1}, {"middle", 1, 2}, {"back", 1, 1}};
+
+template <typename Container, typename T>
+Container makeContainer(const std::vector<T>& values)
+{
+  Container container;
+  container.reserve(values.size());
+  for (const auto& value : values)
+  {
+    container.push_back(value);
+  }
+
+  return container;
+}
+
+/// @brief Inserts a batch at the position and erases it again, so that the container's size (and
+/// so the cost of the shifts) stays the same from one run to the next.
+template <typename Container, typename T>
+void benchmarkContainer(const char* container_name)
+{
+  using Element = BenchmarkElement<T>;
+
+  const auto inputs = makeBenchmarkValues<T>(ElementCount);
+
+  for (std::size_t batch_size : {1, 16, 256})
+  {
+    const std::vector<T> batch(inputs.begin(), inputs.begin() + batch_size);
+
+    for (const auto& position : Positions)
+    {
+      const auto index = ElementCount * position.numerator / position.denominator;
+      auto values = makeContainer<Container>(inputs);
+
+      BENCHMARK(std::string{container_name} + "<" + Element::name + "> insert+erase " +
+                std::to_string(batch_size) + " at " + position.name)
+      {
+        auto first = values.insert(values.begin() + index, batch.begin(), batch.end());
+        values.erase(first, first + batch_size);
+        return values.size();
+      };
+    }
+  }
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("Vector insert/erase against std::vector",
+                   "[vector][benchmark]",
+                   int,
+                   Foo,
+                   std::string)
+{
+  benchmarkContainer<std::vector<TestType>, TestType>("std::vector");
+  benchmarkContainer<Vector<TestType>, TestType>("Vector");
+}
@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 1'000'000;
+
+template <typename Container>
+Container makeRandomValues(std::size_t count)
+{
+  std::mt19937 engine{42};
+  std::uniform_int_distribution<std::int32_t> distribution{0, 1'000'000};
+
+  Container values;
+  values.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    values.push_back(distribution(engine));
+  }
+
+  return values;
+}
+
+template <typename Container>
+void benchmarkIteration(const char* name)
+{
+  const auto source = makeRandomValues<Container>(ElementCount);
+  auto destination = source;
+
+  BENCHMARK(std::string{name} + " std::accumulate")
+  {
+    return std::accumulate(source.begin(), source.end(), std::int64_t{0});
+  };
+
+  BENCHMARK(std::string{name} + " std::find (miss)")
+  {
+    return std::find(source.begin(), source.end(), -1) == source.end();
+  };
+
+  BENCHMARK(std::string{name} + " std::transform")
+  {
+    std::transform(source.begin(), source.end(), destination.begin(), [](std::int32_t value) {
+      return value * 3 + 1;
+    });
+    return destination.back();
+  };
+
+  BENCHMARK_ADVANCED(std::string{name} + " std::sort")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<Container> runs(static_cast<std::size_t>(meter.runs()), source);
+    meter.measure([&runs](int run) {
+      auto& values = runs[static_cast<std::size_t>(run)];
+      std::sort(values.begin(), values.end());
+      return values.front();
+    });
+  };
+}
+} // namespace
+
+#if defined(CPP_TRAINING_UNCHECKED_ITERATORS)
+TEST_CASE("Unchecked Vector iterators against std::vector", "[vector_iterator][benchmark]")
+#else
+TEST_CASE("Checked Vector iterators against std::vector", "[vector_iterator][benchmark]")
+#endif
+{
+  benchmarkIteration<std::vector<std::int32_t>>("std::vector<int32_t>");
+  benchmarkIteration<Vector<std::int32_t>>("Vector<int32_t>");
+}
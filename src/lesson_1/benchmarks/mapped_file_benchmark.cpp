@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include "literal_operators.h"
+#include "mapped_file.h"
+#include "mapped_file_allocator.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t EntryCount = 4'000'000;
+
+struct Entry
+{
+  std::uint64_t key;
+  std::uint64_t value;
+};
+
+using Entries = Vector<Entry, MappedFileAllocator<Entry>>;
+
+/// @brief Stands in for the parsing and hashing that rebuilding a lookup table takes.
+Entry makeEntry(std::size_t i)
+{
+  const auto key = static_cast<std::uint64_t>(i) * 0x9E3779B97F4A7C15ULL;
+  return Entry{key, key ^ (key >> 29)};
+}
+
+Entries rebuild(const MappedFileAllocator<Entry>& allocator)
+{
+  Entries entries{0_z, allocator};
+  for (std::size_t i = 0; i < EntryCount; ++i)
+  {
+    entries.push_back(makeEntry(i));
+  }
+  return entries;
+}
+
+std::uint64_t sumKeys(const Entries& entries, std::size_t stride)
+{
+  std::uint64_t sum = 0;
+  for (std::size_t i = 0; i < entries.size(); i += stride)
+  {
+    sum += entries[i].key;
+  }
+  return sum;
+}
+} // namespace
+
+TEST_CASE("Warm start from a mapped file against a rebuild", "[mapped_file][benchmark]")
+{
+  const auto path =
+    (std::filesystem::temp_directory_path() / "cpp_training_mapped_file_benchmark.bin").string();
+  {
+    MappedFile file{path, MappedFile::Mode::Truncate};
+    MappedFileAllocator<Entry> allocator{file};
+    const auto entries = rebuild(allocator);
+    allocator.store_size(entries.size());
+  }
+
+  BENCHMARK("Rebuild on the heap") { return rebuild(MappedFileAllocator<Entry>{}).size(); };
+
+  BENCHMARK("Reopen the mapped file")
+  {
+    MappedFile file{path};
+    MappedFileAllocator<Entry> allocator{file};
+    const auto stored = allocator.adopt_stored();
+    const Entries entries{adopt_buffer, stored.data, stored.size, stored.capacity, allocator};
+    return entries.size();
+  };
+
+  // One read per page: the cost of faulting every page in, from the page cache
+  BENCHMARK("Reopen the mapped file and touch every page")
+  {
+    MappedFile file{path};
+    MappedFileAllocator<Entry> allocator{file};
+    const auto stored = allocator.adopt_stored();
+    const Entries entries{adopt_buffer, stored.data, stored.size, stored.capacity, allocator};
+    return sumKeys(entries, 4096 / sizeof(Entry));
+  };
+
+  std::remove(path.c_str());
+}
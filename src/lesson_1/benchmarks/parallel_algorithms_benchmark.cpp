@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_all.hpp>
+
+#include "parallel_algorithms.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 4'000'000;
+
+Vector<std::int64_t> makeRandomValues(std::size_t count)
+{
+  std::mt19937_64 engine{42};
+  std::uniform_int_distribution<std::int64_t> distribution{0, 1'000'000'000};
+
+  Vector<std::int64_t> values;
+  values.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    values.push_back(distribution(engine));
+  }
+
+  return values;
+}
+
+double work(std::int64_t value) { return std::sqrt(static_cast<double>(value)) * 1.0001; }
+
+/// @brief 1, 2, 4, ... workers, up to one per hardware thread.
+template <typename Benchmark>
+void forEachPoolSize(Benchmark benchmark)
+{
+  const auto hardware_threads = std::max(1U, std::thread::hardware_concurrency());
+  for (std::size_t workers = 1; workers <= hardware_threads; workers *= 2)
+  {
+    ThreadPool pool{workers};
+    benchmark(pool, " (" + std::to_string(workers) + " workers)");
+  }
+}
+} // namespace
+
+TEST_CASE("Parallel sort against std::sort", "[parallel_algorithms][benchmark]")
+{
+  const auto original = makeRandomValues(ElementCount);
+  auto values = original;
+
+  BENCHMARK_ADVANCED("std::sort over Vector iterators")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] {
+      values = original;
+      std::sort(values.begin(), values.end());
+      return values.front();
+    });
+  };
+
+  BENCHMARK_ADVANCED("std::sort over data()")(Catch::Benchmark::Chronometer meter)
+  {
+    meter.measure([&] {
+      values = original;
+      std::sort(values.data(), values.data() + values.size());
+      return values.front();
+    });
+  };
+
+  forEachPoolSize([&](ThreadPool& pool, const std::string& label) {
+    BENCHMARK_ADVANCED("parallel::sort" + label)(Catch::Benchmark::Chronometer meter)
+    {
+      meter.measure([&] {
+        values = original;
+        parallel::sort(values, std::less<>{}, pool);
+        return values.front();
+      });
+    };
+  });
+}
+
+TEST_CASE("Parallel for_each, transform, reduce and scan against std::",
+          "[parallel_algorithms][benchmark]")
+{
+  const auto values = makeRandomValues(ElementCount);
+  Vector<double> roots(ElementCount);
+  Vector<std::int64_t> sums(ElementCount);
+
+  BENCHMARK("std::transform")
+  {
+    roots.resize(values.size());
+    std::transform(values.data(), values.data() + values.size(), roots.data(), work);
+    return roots.back();
+  };
+
+  BENCHMARK("std::transform_reduce")
+  {
+    return std::transform_reduce(
+      values.data(), values.data() + values.size(), 0.0, std::plus<>{}, work);
+  };
+
+  BENCHMARK("std::inclusive_scan")
+  {
+    sums.resize(values.size());
+    std::inclusive_scan(values.data(), values.data() + values.size(), sums.data());
+    return sums.back();
+  };
+
+  forEachPoolSize([&](ThreadPool& pool, const std::string& label) {
+    BENCHMARK("parallel::for_each" + label)
+    {
+      std::int64_t maximum = 0;
+      parallel::for_each(
+        values,
+        [&maximum](std::int64_t value) {
+          if (work(value) < 0)
+          {
+            maximum = value;
+          }
+        },
+        pool);
+      return maximum;
+    };
+
+    BENCHMARK("parallel::transform" + label)
+    {
+      parallel::transform(values, roots, work, pool);
+      return roots.back();
+    };
+
+    BENCHMARK("parallel::transform_reduce" + label)
+    {
+      return parallel::transform_reduce(values, 0.0, std::plus<>{}, work, pool);
+    };
+
+    BENCHMARK("parallel::inclusive_scan" + label)
+    {
+      parallel::inclusive_scan(values, sums, std::plus<>{}, pool);
+      return sums.back();
+    };
+  });
+}
+
+TEST_CASE("Parallel first-touch resize against resize", "[parallel_algorithms][benchmark]")
+{
+  // Fresh storage each time, so that the page faults are part of what is measured
+  constexpr std::size_t ResizeCount = 32'000'000;
+
+  BENCHMARK("resize")
+  {
+    Vector<std::int64_t> values;
+    values.resize(ResizeCount);
+    return values.back();
+  };
+
+  forEachPoolSize([&](ThreadPool& pool, const std::string& label) {
+    BENCHMARK("resize(parallel_tag)" + label)
+    {
+      Vector<std::int64_t> values;
+      values.resize(ResizeCount, parallel_tag, pool);
+      return values.back();
+    };
+
+    BENCHMARK("reserve(parallel_tag), then resize(parallel_tag)" + label)
+    {
+      Vector<std::int64_t> values;
+      values.reserve(ResizeCount, parallel_tag, pool);
+      values.resize(ResizeCount, parallel_tag, pool);
+      return values.back();
+    };
+  });
+}
@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 10'000;
+constexpr std::size_t PayloadSize = 64;
+
+/// @brief An element that owns a heap payload, so that copying it costs an allocation and a
+/// 512-byte copy while moving it costs a few pointer stores. Only a noexcept move may be used to
+/// relocate it; otherwise the containers copy it to keep the strong exception guarantee.
+template <bool NoexceptMove>
+class Heavy final
+{
+public:
+  explicit Heavy(std::size_t seed) : payload_(PayloadSize, seed) {}
+  Heavy(const Heavy& other) : payload_{other.payload_} { ++copies; }
+  Heavy(Heavy&& other) noexcept(NoexceptMove) : payload_{std::move(other.payload_)} {}
+  Heavy& operator=(const Heavy&) = default;
+  Heavy& operator=(Heavy&&) = default;
+  ~Heavy() = default;
+
+  std::uint64_t front() const { return payload_.front(); }
+
+  static inline std::size_t copies{0};
+
+private:
+  std::vector<std::uint64_t> payload_;
+};
+
+template <typename Container>
+std::uint64_t fill()
+{
+  Container values;
+  for (std::size_t i = 0; i < ElementCount; ++i)
+  {
+    values.push_back(typename Container::value_type{i});
+  }
+
+  return values.back().front();
+}
+
+template <typename Container>
+std::size_t countCopies()
+{
+  using element_type = typename Container::value_type;
+
+  element_type::copies = 0;
+  fill<Container>();
+  return element_type::copies;
+}
+
+template <bool NoexceptMove>
+void reportCopies(const char* name)
+{
+  std::cout << std::left << std::setw(24) << name << std::right << std::setw(14)
+            << countCopies<Vector<Heavy<NoexceptMove>>>() << std::setw(14)
+            << countCopies<std::vector<Heavy<NoexceptMove>>>() << '\n';
+}
+} // namespace
+
+TEST_CASE("Copies made while relocating heavy elements", "[vector][benchmark]")
+{
+  std::cout << "copies during " << ElementCount << " push_backs\n"
+            << std::left << std::setw(24) << "element" << std::right << std::setw(14) << "Vector"
+            << std::setw(14) << "std::vector" << '\n';
+
+  reportCopies<true>("Heavy (noexcept move)");
+  reportCopies<false>("Heavy (throwing move)");
+}
+
+TEST_CASE("Relocating heavy elements", "[vector][benchmark]")
+{
+  BENCHMARK("Vector / noexcept move")
+  {
+    return fill<Vector<Heavy<true>>>();
+  };
+
+  BENCHMARK("Vector / throwing move")
+  {
+    return fill<Vector<Heavy<false>>>();
+  };
+
+  BENCHMARK("std::vector / noexcept move")
+  {
+    return fill<std::vector<Heavy<true>>>();
+  };
+
+  BENCHMARK("std::vector / throwing move")
+  {
+    return fill<std::vector<Heavy<false>>>();
+  };
+}
@@ -0,0 +1,96 @@
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "segmented_vector.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 1 << 20;
+
+/// @brief Runs append(producer, count) on each of producers threads, which between them append
+/// ElementCount elements.
+template <typename Append>
+void produce(std::size_t producers, Append append)
+{
+  std::vector<std::thread> threads;
+  threads.reserve(producers);
+  for (std::size_t producer = 0; producer < producers; ++producer)
+  {
+    threads.emplace_back(append, producer, ElementCount / producers);
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+} // namespace
+
+TEST_CASE("Concurrent push_back against a mutex-guarded vector", "[segmented_vector][benchmark]")
+{
+  for (std::size_t producers = 1; producers <= 64; producers *= 2)
+  {
+    const auto label = " (" + std::to_string(producers) + " producers)";
+
+    BENCHMARK("SegmentedVector push_back" + label)
+    {
+      SegmentedVector<std::int64_t> values;
+      produce(producers, [&values](std::size_t producer, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          values.push_back(static_cast<std::int64_t>(producer + i));
+        }
+      });
+      return values.size();
+    };
+
+    BENCHMARK("SegmentedVector grow_by 64" + label)
+    {
+      SegmentedVector<std::int64_t> values;
+      produce(producers, [&values](std::size_t producer, std::size_t count) {
+        for (std::size_t i = 0; i < count; i += 64)
+        {
+          values.grow_by(64, static_cast<std::int64_t>(producer + i));
+        }
+      });
+      return values.size();
+    };
+
+    BENCHMARK("Vector push_back under a mutex" + label)
+    {
+      Vector<std::int64_t> values;
+      std::mutex mutex;
+      produce(producers, [&values, &mutex](std::size_t producer, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          std::lock_guard<std::mutex> lock{mutex};
+          values.push_back(static_cast<std::int64_t>(producer + i));
+        }
+      });
+      return values.size();
+    };
+
+    BENCHMARK("std::vector push_back under a mutex" + label)
+    {
+      std::vector<std::int64_t> values;
+      std::mutex mutex;
+      produce(producers, [&values, &mutex](std::size_t producer, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+          std::lock_guard<std::mutex> lock{mutex};
+          values.push_back(static_cast<std::int64_t>(producer + i));
+        }
+      });
+      return values.size();
+    };
+  }
+}
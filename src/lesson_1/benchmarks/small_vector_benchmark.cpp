@@ -0,0 +1,119 @@
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include "small_vector.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+/// @brief Counts the calls that reach the allocator.
+template <typename T>
+class CountingAllocator final
+{
+public:
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template <class U>
+  CountingAllocator(const CountingAllocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++allocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>{}.deallocate(p, n); }
+
+  static inline std::size_t allocations{0};
+};
+
+template <typename T, typename U>
+bool operator==(const CountingAllocator<T>&, const CountingAllocator<U>&) noexcept
+{
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const CountingAllocator<T>&, const CountingAllocator<U>&) noexcept
+{
+  return false;
+}
+
+constexpr std::size_t ContainerCount = 100'000;
+constexpr std::size_t InlineCapacity = 8;
+
+using value_type = std::int32_t;
+using VectorType = Vector<value_type, CountingAllocator<value_type>>;
+using SmallVectorType = SmallVector<value_type, InlineCapacity, CountingAllocator<value_type>>;
+
+/// @brief Builds and destroys ContainerCount containers of element_count elements each, the way
+/// short-lived per-request vectors are used.
+template <typename Container>
+std::int64_t buildContainers(std::size_t element_count)
+{
+  std::int64_t sum = 0;
+  for (std::size_t i = 0; i < ContainerCount; ++i)
+  {
+    Container values;
+    for (std::size_t j = 0; j < element_count; ++j)
+    {
+      values.push_back(static_cast<value_type>(j));
+    }
+
+    sum += values.back();
+  }
+
+  return sum;
+}
+
+template <typename Container>
+std::size_t countAllocations(std::size_t element_count)
+{
+  CountingAllocator<value_type>::allocations = 0;
+  buildContainers<Container>(element_count);
+  return CountingAllocator<value_type>::allocations;
+}
+} // namespace
+
+TEST_CASE("SmallVector allocation counts", "[small_vector][benchmark]")
+{
+  std::cout << "allocations per " << ContainerCount << " containers\n"
+            << std::left << std::setw(10) << "elements" << std::right << std::setw(14) << "Vector"
+            << std::setw(18) << "SmallVector<8>" << '\n';
+
+  for (std::size_t element_count : {1, 4, 8, 9, 16, 64})
+  {
+    std::cout << std::left << std::setw(10) << element_count << std::right << std::setw(14)
+              << countAllocations<VectorType>(element_count) << std::setw(18)
+              << countAllocations<SmallVectorType>(element_count) << '\n';
+  }
+}
+
+TEST_CASE("SmallVector push_back throughput", "[small_vector][benchmark]")
+{
+  for (std::size_t element_count : {4, 8, 16})
+  {
+    const auto suffix = " x " + std::to_string(element_count);
+
+    BENCHMARK("Vector" + suffix)
+    {
+      return buildContainers<VectorType>(element_count);
+    };
+
+    BENCHMARK("SmallVector<8>" + suffix)
+    {
+      return buildContainers<SmallVectorType>(element_count);
+    };
+  }
+}
@@ -0,0 +1,157 @@
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+#include <catch2/catch_all.hpp>
+
+#include "soa_vector.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t RecordCount = 1'000'000;
+
+/// @brief A 12-field, 80-byte trade record, the shape the analytics scans read one or two
+/// fields of.
+struct Trade
+{
+  std::int64_t id;
+  std::int64_t timestamp;
+  std::int64_t account;
+  std::int64_t instrument;
+  double price;
+  double quantity;
+  double fee;
+  double notional;
+  std::int32_t venue;
+  std::int32_t side;
+  std::int32_t flags;
+  std::int32_t trader;
+};
+
+using Trades = SoaVector<std::int64_t,
+                         std::int64_t,
+                         std::int64_t,
+                         std::int64_t,
+                         double,
+                         double,
+                         double,
+                         double,
+                         std::int32_t,
+                         std::int32_t,
+                         std::int32_t,
+                         std::int32_t>;
+
+Trade makeTrade(std::size_t i)
+{
+  const auto value = static_cast<std::int64_t>(i);
+  const auto small = static_cast<std::int32_t>(i % 1000);
+  return Trade{value,
+               value * 10,
+               value % 97,
+               value % 513,
+               100.0 + static_cast<double>(i % 50),
+               static_cast<double>(i % 7 + 1),
+               0.01,
+               0.0,
+               small % 8,
+               small % 2,
+               small,
+               small % 31};
+}
+} // namespace
+
+TEST_CASE("SoaVector column scans against Vector<struct>", "[soa_vector][benchmark]")
+{
+  Vector<Trade> rows;
+  Trades columns;
+  rows.reserve(RecordCount);
+  columns.reserve(RecordCount);
+  for (std::size_t i = 0; i < RecordCount; ++i)
+  {
+    const auto trade = makeTrade(i);
+    rows.push_back(trade);
+    columns.emplace_back(trade.id,
+                         trade.timestamp,
+                         trade.account,
+                         trade.instrument,
+                         trade.price,
+                         trade.quantity,
+                         trade.fee,
+                         trade.notional,
+                         trade.venue,
+                         trade.side,
+                         trade.flags,
+                         trade.trader);
+  }
+
+  BENCHMARK("Vector<struct> sum of one field")
+  {
+    double sum = 0.0;
+    for (const auto* trade = rows.data(); trade != rows.data() + rows.size(); ++trade)
+    {
+      sum += trade->price;
+    }
+    return sum;
+  };
+
+  BENCHMARK("SoaVector sum of one column")
+  {
+    double sum = 0.0;
+    for (const auto price : columns.column<4>())
+    {
+      sum += price;
+    }
+    return sum;
+  };
+
+  BENCHMARK("Vector<struct> sum of two fields multiplied")
+  {
+    double sum = 0.0;
+    for (const auto* trade = rows.data(); trade != rows.data() + rows.size(); ++trade)
+    {
+      sum += trade->price * trade->quantity;
+    }
+    return sum;
+  };
+
+  BENCHMARK("SoaVector sum of two columns multiplied")
+  {
+    const auto prices = columns.column<4>();
+    const auto quantities = columns.column<5>();
+    double sum = 0.0;
+    for (std::size_t i = 0; i < prices.size(); ++i)
+    {
+      sum += prices[i] * quantities[i];
+    }
+    return sum;
+  };
+
+  BENCHMARK("Vector<struct> whole-record access")
+  {
+    std::int64_t sum = 0;
+    for (const auto* trade = rows.data(); trade != rows.data() + rows.size(); ++trade)
+    {
+      sum += trade->id + trade->timestamp + trade->account + trade->instrument +
+             static_cast<std::int64_t>(trade->price + trade->quantity + trade->fee +
+                                       trade->notional) +
+             trade->venue + trade->side + trade->flags + trade->trader;
+    }
+    return sum;
+  };
+
+  BENCHMARK("SoaVector whole-record access")
+  {
+    std::int64_t sum = 0;
+    for (const auto& trade : columns)
+    {
+      sum += std::get<0>(trade) + std::get<1>(trade) + std::get<2>(trade) + std::get<3>(trade) +
+             static_cast<std::int64_t>(std::get<4>(trade) + std::get<5>(trade) +
+                                       std::get<6>(trade) + std::get<7>(trade)) +
+             std::get<8>(trade) + std::get<9>(trade) + std::get<10>(trade) + std::get<11>(trade);
+    }
+    return sum;
+  };
+}
@@ -0,0 +1,108 @@
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "stable_vector.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 1'000'000;
+constexpr std::size_t ReadCount = 1'000'000;
+
+template <typename Container>
+Container makeContainer()
+{
+  Container values;
+  for (std::size_t i = 0; i < ElementCount; ++i)
+  {
+    values.push_back(static_cast<std::int64_t>(i));
+  }
+  return values;
+}
+
+/// @brief Random indices, so that reads defeat the prefetcher.
+std::vector<std::size_t> makeIndices()
+{
+  std::mt19937_64 engine{42};
+  std::uniform_int_distribution<std::size_t> distribution{0, ElementCount - 1};
+
+  std::vector<std::size_t> indices(ReadCount);
+  for (auto& index : indices)
+  {
+    index = distribution(engine);
+  }
+  return indices;
+}
+
+template <typename Container>
+std::int64_t readAt(const Container& values, const std::vector<std::size_t>& indices)
+{
+  std::int64_t sum = 0;
+  for (const auto index : indices)
+  {
+    sum += values[index];
+  }
+  return sum;
+}
+
+template <typename Container>
+std::int64_t iterate(const Container& values)
+{
+  std::int64_t sum = 0;
+  for (const auto value : values)
+  {
+    sum += value;
+  }
+  return sum;
+}
+} // namespace
+
+TEST_CASE("StableVector against Vector and std::deque", "[stable_vector][benchmark]")
+{
+  BENCHMARK("Vector push_back") { return makeContainer<Vector<std::int64_t>>().size(); };
+  BENCHMARK("std::deque push_back") { return makeContainer<std::deque<std::int64_t>>().size(); };
+  BENCHMARK("StableVector push_back")
+  {
+    return makeContainer<StableVector<std::int64_t>>().size();
+  };
+
+  BENCHMARK("std::deque push_front")
+  {
+    std::deque<std::int64_t> values;
+    for (std::size_t i = 0; i < ElementCount; ++i)
+    {
+      values.push_front(static_cast<std::int64_t>(i));
+    }
+    return values.size();
+  };
+
+  BENCHMARK("StableVector push_front")
+  {
+    StableVector<std::int64_t> values;
+    for (std::size_t i = 0; i < ElementCount; ++i)
+    {
+      values.push_front(static_cast<std::int64_t>(i));
+    }
+    return values.size();
+  };
+
+  const auto indices = makeIndices();
+  const auto vector = makeContainer<Vector<std::int64_t>>();
+  const auto deque = makeContainer<std::deque<std::int64_t>>();
+  const auto stable_vector = makeContainer<StableVector<std::int64_t>>();
+
+  BENCHMARK("Vector random reads") { return readAt(vector, indices); };
+  BENCHMARK("std::deque random reads") { return readAt(deque, indices); };
+  BENCHMARK("StableVector random reads") { return readAt(stable_vector, indices); };
+
+  BENCHMARK("Vector iteration") { return iterate(vector); };
+  BENCHMARK("std::deque iteration") { return iterate(deque); };
+  BENCHMARK("StableVector iteration") { return iterate(stable_vector); };
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include "simd_algorithms.h"
+#include "vector.h"
+#include "vector_algorithms.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 1'000'000;
+
+Vector<std::int32_t> makeRandomValues(std::size_t count)
+{
+  std::mt19937 engine{42};
+  std::uniform_int_distribution<std::int32_t> distribution{0, 1'000'000};
+
+  Vector<std::int32_t> values;
+  values.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    values.push_back(distribution(engine));
+  }
+
+  return values;
+}
+
+const char* name(simd::InstructionSet instruction_set)
+{
+  switch (instruction_set)
+  {
+  case simd::InstructionSet::Avx2:
+    return "AVX2";
+  case simd::InstructionSet::Sse2:
+    return "SSE2";
+  default:
+    return "scalar";
+  }
+}
+} // namespace
+
+TEST_CASE("SIMD searches over Vector<int32_t> against the standard algorithms",
+          "[vector_algorithms][benchmark]")
+{
+  const auto values = makeRandomValues(ElementCount);
+  const auto copy = values;
+
+  // Every search misses or scans to the end, so each one reads all of the elements
+  BENCHMARK("std::find (miss)")
+  {
+    return std::find(values.begin(), values.end(), -1) == values.end();
+  };
+
+  BENCHMARK("std::find over data() (miss)")
+  {
+    return std::find(values.data(), values.data() + values.size(), -1);
+  };
+
+  BENCHMARK("std::count")
+  {
+    return std::count(values.begin(), values.end(), 17);
+  };
+
+  BENCHMARK("std::min_element")
+  {
+    return std::min_element(values.begin(), values.end()) == values.end();
+  };
+
+  BENCHMARK("std::equal")
+  {
+    return std::equal(values.begin(), values.end(), copy.begin());
+  };
+
+  const auto original = simd::instruction_set();
+  for (auto instruction_set :
+       {simd::InstructionSet::Scalar, simd::InstructionSet::Sse2, simd::InstructionSet::Avx2})
+  {
+    if (simd::set_instruction_set(instruction_set) != instruction_set)
+    {
+      continue;
+    }
+
+    const std::string suffix = std::string{" ("} + name(instruction_set) + ")";
+
+    BENCHMARK("find (miss)" + suffix)
+    {
+      return find(values, -1) == values.end();
+    };
+
+    BENCHMARK("count" + suffix)
+    {
+      return count(values, 17);
+    };
+
+    BENCHMARK("min_element" + suffix)
+    {
+      return min_element(values) == values.end();
+    };
+
+    BENCHMARK("operator==" + suffix)
+    {
+      return values == copy;
+    };
+  }
+  simd::set_instruction_set(original);
+}
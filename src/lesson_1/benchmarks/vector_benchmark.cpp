@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+#include <gsl/span>
+
+#include "benchmark_elements.h"
+#include "foo.h"
+#include "throwing_copy.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t ElementCount = 100'000;
+constexpr std::size_t BatchSize = 64;
+
+template <typename Container, typename T>
+Container makeContainer(const std::vector<T>& values)
+{
+  Container container;
+  container.reserve(values.size());
+  for (const auto& value : values)
+  {
+    container.push_back(value);
+  }
+
+  return container;
+}
+
+template <typename Container, typename T>
+void benchmarkContainer(const char* container_name)
+{
+  using Element = BenchmarkElement<T>;
+
+  const std::string name = std::string{container_name} + "<" + Element::name + "> ";
+  const auto inputs = makeBenchmarkValues<T>(ElementCount);
+  const auto indices = makeBenchmarkIndices(ElementCount, ElementCount);
+  const auto source = makeContainer<Container>(inputs);
+
+  BENCHMARK(name + "push_back (regrow)")
+  {
+    Container values;
+    for (const auto& input : inputs)
+    {
+      values.push_back(input);
+    }
+    return values.size();
+  };
+
+  BENCHMARK(name + "push_back (reserved)")
+  {
+    Container values;
+    values.reserve(inputs.size());
+    for (const auto& input : inputs)
+    {
+      values.push_back(input);
+    }
+    return values.size();
+  };
+
+  BENCHMARK(name + "emplace_back")
+  {
+    Container values;
+    for (const auto& input : inputs)
+    {
+      values.emplace_back(Element::argument(input));
+    }
+    return values.size();
+  };
+
+  BENCHMARK(name + "range constructor")
+  {
+    Container values(inputs.begin(), inputs.end());
+    return values.size();
+  };
+
+  // Many small vectors cut from one large buffer, as when ingesting parsed records
+  BENCHMARK(name + "range constructor (" + std::to_string(BatchSize) + "-element batches)")
+  {
+    std::size_t total = 0;
+    for (std::size_t offset = 0; offset + BatchSize <= inputs.size(); offset += BatchSize)
+    {
+      Container values(inputs.begin() + offset, inputs.begin() + offset + BatchSize);
+      total += values.size();
+    }
+    return total;
+  };
+
+  BENCHMARK(name + "copy")
+  {
+    Container values{source};
+    return values.size();
+  };
+
+  BENCHMARK_ADVANCED(name + "move")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<Container> runs(static_cast<std::size_t>(meter.runs()), source);
+    meter.measure([&runs](int run) {
+      Container values{std::move(runs[static_cast<std::size_t>(run)])};
+      return values.size();
+    });
+  };
+
+  BENCHMARK(name + "iteration")
+  {
+    std::int64_t sum = 0;
+    for (const auto& value : source)
+    {
+      sum += Element::key(value);
+    }
+    return sum;
+  };
+
+  // Contiguous access, as an I/O call or a C API would see the elements
+  BENCHMARK(name + "iteration (gsl::span)")
+  {
+    std::int64_t sum = 0;
+    for (const auto& value : gsl::span<const T>{source})
+    {
+      sum += Element::key(value);
+    }
+    return sum;
+  };
+
+  BENCHMARK(name + "random access")
+  {
+    std::int64_t sum = 0;
+    for (auto index : indices)
+    {
+      sum += Element::key(source[index]);
+    }
+    return sum;
+  };
+
+  BENCHMARK_ADVANCED(name + "std::sort")(Catch::Benchmark::Chronometer meter)
+  {
+    std::vector<Container> runs(static_cast<std::size_t>(meter.runs()), source);
+    meter.measure([&runs](int run) {
+      auto& values = runs[static_cast<std::size_t>(run)];
+      std::sort(values.begin(), values.end(), Element::less);
+      return values.size();
+    });
+  };
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("lesson_1 Vector against std::vector",
+                   "[vector][benchmark]",
+                   int,
+                   Foo,
+                   std::string,
+                   ThrowingCopy)
+{
+  benchmarkContainer<std::vector<TestType>, TestType>("std::vector");
+  benchmarkContainer<Vector<TestType>, TestType>("Vector");
+}
@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include "vector.h"
+#include "vector_snapshot.h"
+
+using namespace CppTraining;
+
+namespace
+{
+constexpr std::size_t QuoteCount = 1'000'000;
+
+struct Quote
+{
+  std::int64_t instrument;
+  double bid;
+  double ask;
+};
+
+/// @brief The checkpoint this replaces: one element at a time, through the iterators.
+void saveElementwise(const std::string& path, const Vector<Quote>& quotes)
+{
+  std::ofstream file{path, std::ios::binary};
+  const auto size = static_cast<std::uint64_t>(quotes.size());
+  file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+  for (const auto& quote : quotes)
+  {
+    file.write(reinterpret_cast<const char*>(&quote.instrument), sizeof(quote.instrument));
+    file.write(reinterpret_cast<const char*>(&quote.bid), sizeof(quote.bid));
+    file.write(reinterpret_cast<const char*>(&quote.ask), sizeof(quote.ask));
+  }
+}
+
+Vector<Quote> loadElementwise(const std::string& path)
+{
+  std::ifstream file{path, std::ios::binary};
+  std::uint64_t size = 0;
+  file.read(reinterpret_cast<char*>(&size), sizeof(size));
+
+  Vector<Quote> quotes;
+  quotes.reserve(static_cast<std::size_t>(size));
+  for (std::uint64_t i = 0; i < size; ++i)
+  {
+    Quote quote;
+    file.read(reinterpret_cast<char*>(&quote.instrument), sizeof(quote.instrument));
+    file.read(reinterpret_cast<char*>(&quote.bid), sizeof(quote.bid));
+    file.read(reinterpret_cast<char*>(&quote.ask), sizeof(quote.ask));
+    quotes.push_back(quote);
+  }
+  return quotes;
+}
+
+template <typename Quotes>
+double sumSpreads(const Quotes& quotes)
+{
+  double sum = 0.0;
+  for (const auto& quote : quotes)
+  {
+    sum += quote.ask - quote.bid;
+  }
+  return sum;
+}
+} // namespace
+
+TEST_CASE("Vector snapshots against element-wise serialization", "[vector_snapshot][benchmark]")
+{
+  const auto directory = std::filesystem::temp_directory_path();
+  const auto elementwise_path = (directory / "cpp_training_elementwise.bin").string();
+  const auto snapshot_path = (directory / "cpp_training_snapshot.bin").string();
+
+  Vector<Quote> quotes;
+  for (std::size_t i = 0; i < QuoteCount; ++i)
+  {
+    const auto price = 100.0 + static_cast<double>(i % 17);
+    quotes.push_back(Quote{static_cast<std::int64_t>(i), price, price + 0.5});
+  }
+
+  BENCHMARK("Save element-wise")
+  {
+    saveElementwise(elementwise_path, quotes);
+    return quotes.size();
+  };
+
+  BENCHMARK("Save snapshot")
+  {
+    save(snapshot_path, quotes);
+    return quotes.size();
+  };
+
+  BENCHMARK("Load element-wise and scan")
+  {
+    return sumSpreads(loadElementwise(elementwise_path));
+  };
+
+  BENCHMARK("load_view with checksum and scan")
+  {
+    return sumSpreads(load_view<Quote>(snapshot_path));
+  };
+
+  BENCHMARK("load_view without checksum and scan")
+  {
+    return sumSpreads(load_view<Quote>(snapshot_path, SnapshotCheck::HeaderOnly));
+  };
+
+  std::remove(elementwise_path.c_str());
+  std::remove(snapshot_path.c_str());
+}
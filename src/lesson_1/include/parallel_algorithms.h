@@ -0,0 +1,519 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.h"
+#include "vector.h"
+
+namespace CppTraining
+{
+namespace parallel
+{
+// Parallel versions of standard algorithms over a whole Vector, run on a ThreadPool: the global one
+// unless another is given. Like vector_algorithms.h they work on data() rather than the checked
+// iterators.
+//
+// The functions passed in are called from several threads at once, so they must be safe to call
+// concurrently. Reductions and scans group the elements differently from a sequential loop, so
+// their operation must be associative; it need not be commutative.
+
+namespace detail
+{
+// Chunks per worker for the algorithms that split the elements up front, so that a slow chunk
+// does not hold everybody else up
+constexpr std::size_t ChunksPerWorker = 4;
+
+// Below this many elements per chunk, the bookkeeping costs more than a second thread saves
+constexpr std::size_t MinimumChunkSize = 4096;
+
+inline std::size_t chunk_count(const ThreadPool& pool, std::size_t size)
+{
+  return std::max<std::size_t>(
+    1, std::min(pool.worker_count() * ChunksPerWorker, size / MinimumChunkSize));
+}
+
+/// @brief Where chunk index of count nearly equal chunks of size elements starts. Chunk index
+/// ends where chunk index + 1 starts.
+inline std::size_t chunk_begin(std::size_t size, std::size_t count, std::size_t index)
+{
+  return size / count * index + std::min(index, size % count);
+}
+
+/// @brief Calls function(chunk, first, last) for each of count chunks of [0, size), in parallel.
+template <typename Function>
+void for_each_chunk(ThreadPool& pool, std::size_t size, std::size_t count, Function function)
+{
+  pool.parallel_for(
+    0,
+    count,
+    [&](std::size_t chunk) {
+      function(chunk, chunk_begin(size, count, chunk), chunk_begin(size, count, chunk + 1));
+    },
+    1);
+}
+
+template <typename T, typename Result, typename Reduce, typename Transform>
+Result transform_reduce(const T* data,
+                        std::size_t size,
+                        Result init,
+                        Reduce reduce,
+                        Transform transform,
+                        ThreadPool& pool)
+{
+  const auto chunks = chunk_count(pool, size);
+  std::vector<std::optional<Result>> partials(chunks);
+
+  for_each_chunk(pool, size, chunks, [&](std::size_t chunk, std::size_t first, std::size_t last) {
+    if (first == last)
+    {
+      return;
+    }
+
+    Result partial(transform(data[first]));
+    for (auto i = first + 1; i < last; ++i)
+    {
+      partial = reduce(std::move(partial), transform(data[i]));
+    }
+    partials[chunk].emplace(std::move(partial));
+  });
+
+  for (auto& partial : partials)
+  {
+    if (partial)
+    {
+      init = reduce(std::move(init), std::move(*partial));
+    }
+  }
+
+  return init;
+}
+
+/// @brief The three-pass scan: each chunk's total, then serially the running total each chunk
+/// starts from, then each chunk's scan from its starting total. output may be input.
+template <bool Inclusive, typename T, typename U, typename Operation>
+void scan(const T* input,
+          U* output,
+          std::size_t size,
+          std::optional<U> init,
+          Operation operation,
+          ThreadPool& pool)
+{
+  if (size == 0)
+  {
+    return;
+  }
+
+  const auto chunks = chunk_count(pool, size);
+  std::vector<std::optional<U>> totals(chunks);
+
+  for_each_chunk(pool, size, chunks, [&](std::size_t chunk, std::size_t first, std::size_t last) {
+    // Nothing starts from the last chunk's total
+    if (chunk + 1 == chunks)
+    {
+      return;
+    }
+
+    U total(input[first]);
+    for (auto i = first + 1; i < last; ++i)
+    {
+      total = operation(std::move(total), input[i]);
+    }
+    totals[chunk].emplace(std::move(total));
+  });
+
+  std::vector<std::optional<U>> starts(chunks);
+  starts[0] = std::move(init);
+  for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+  {
+    if (starts[chunk - 1])
+    {
+      starts[chunk].emplace(operation(*starts[chunk - 1], std::move(*totals[chunk - 1])));
+    }
+    else
+    {
+      starts[chunk] = std::move(totals[chunk - 1]);
+    }
+  }
+
+  for_each_chunk(pool, size, chunks, [&](std::size_t chunk, std::size_t first, std::size_t last) {
+    auto running = std::move(starts[chunk]);
+    auto i = first;
+    if constexpr (Inclusive)
+    {
+      if (!running)
+      {
+        running.emplace(input[i]);
+        output[i++] = *running;
+      }
+
+      for (; i < last; ++i)
+      {
+        *running = operation(std::move(*running), input[i]);
+        output[i] = *running;
+      }
+    }
+    else
+    {
+      for (; i < last; ++i)
+      {
+        // Read before writing, in case output is input
+        U value(input[i]);
+        output[i] = *running;
+        *running = operation(std::move(*running), std::move(value));
+      }
+    }
+  });
+}
+
+/// @brief Uninitialized storage for a merge sort's second copy of the elements.
+template <typename T>
+class SortBuffer final
+{
+public:
+  explicit SortBuffer(std::size_t size) : data_{std::allocator<T>{}.allocate(size)}, size_{size}
+  {
+  }
+
+  SortBuffer(const SortBuffer&) = delete;
+  SortBuffer(SortBuffer&&) = delete;
+  SortBuffer& operator=(const SortBuffer&) = delete;
+  SortBuffer& operator=(SortBuffer&&) = delete;
+
+  ~SortBuffer()
+  {
+    if (constructed_)
+    {
+      std::destroy(data_, data_ + size_);
+    }
+    std::allocator<T>{}.deallocate(data_, size_);
+  }
+
+  T* data() const noexcept { return data_; }
+
+  /// @brief Called once every element has been constructed.
+  void set_constructed() noexcept { constructed_ = true; }
+
+private:
+  T* data_;
+  std::size_t size_;
+  bool constructed_{false};
+};
+
+/// @brief How many of the first index elements of a stable merge of the sorted ranges
+/// [lhs, lhs + lhs_size) and [rhs, rhs + rhs_size) come from lhs. Equal elements are taken from
+/// lhs first, as std::merge does.
+template <typename T, typename Compare>
+std::size_t merge_split(const T* lhs,
+                        std::size_t lhs_size,
+                        const T* rhs,
+                        std::size_t rhs_size,
+                        std::size_t index,
+                        Compare& compare)
+{
+  auto low = index > rhs_size ? index - rhs_size : 0;
+  auto high = std::min(index, lhs_size);
+  while (low < high)
+  {
+    const auto middle = low + (high - low) / 2;
+    if (!compare(rhs[index - middle - 1], lhs[middle]))
+    {
+      low = middle + 1;
+    }
+    else
+    {
+      high = middle;
+    }
+  }
+
+  return low;
+}
+
+/// @brief Moves the merge of source's sorted ranges [first, middle) and [middle, last) to the same
+/// positions in destination. The output is cut into pieces, and a binary search finds where each
+/// piece's inputs start, so that a single merge is split across the pool too.
+template <typename T, typename Compare>
+void merge(T* source,
+           std::size_t first,
+           std::size_t middle,
+           std::size_t last,
+           T* destination,
+           Compare& compare,
+           ThreadPool& pool)
+{
+  T* lhs = source + first;
+  T* rhs = source + middle;
+  const auto lhs_size = middle - first;
+  const auto rhs_size = last - middle;
+  const auto size = last - first;
+
+  const auto grain_size = std::max(MinimumChunkSize, size / (pool.worker_count() * 8));
+  const auto pieces = (size + grain_size - 1) / grain_size;
+
+  // Every split is found before any piece starts moving elements out from under the searches
+  std::vector<std::size_t> splits(pieces + 1);
+  for (std::size_t piece = 0; piece <= pieces; ++piece)
+  {
+    splits[piece] =
+      merge_split(lhs, lhs_size, rhs, rhs_size, std::min(piece * grain_size, size), compare);
+  }
+
+  pool.parallel_for(
+    0,
+    pieces,
+    [&](std::size_t piece) {
+      const auto output_first = piece * grain_size;
+      const auto output_last = std::min(output_first + grain_size, size);
+      const auto lhs_first = splits[piece];
+      const auto lhs_last = splits[piece + 1];
+
+      std::merge(std::make_move_iterator(lhs + lhs_first),
+                 std::make_move_iterator(lhs + lhs_last),
+                 std::make_move_iterator(rhs + output_first - lhs_first),
+                 std::make_move_iterator(rhs + output_last - lhs_last),
+                 destination + first + output_first,
+                 compare);
+    },
+    1);
+}
+
+/// @brief A merge sort: the chunks are sorted with std::sort in parallel, then merged in pairs,
+/// round after round, each merge itself split across the pool. The elements move back and forth
+/// between data and a buffer of the same size.
+template <typename T, typename Compare>
+void sort(T* data, std::size_t size, Compare compare, ThreadPool& pool)
+{
+  const auto chunks = chunk_count(pool, size);
+
+  // Filling the buffer with elements whose moves may throw could fail halfway, with no good way to
+  // undo it
+  if (chunks == 1 || !std::is_nothrow_move_constructible_v<T>)
+  {
+    std::sort(data, data + size, compare);
+    return;
+  }
+
+  SortBuffer<T> buffer{size};
+  for_each_chunk(pool, size, chunks, [&](std::size_t, std::size_t first, std::size_t last) {
+    std::uninitialized_move(data + first, data + last, buffer.data() + first);
+  });
+  buffer.set_constructed();
+
+  for_each_chunk(pool, size, chunks, [&](std::size_t, std::size_t first, std::size_t last) {
+    std::sort(buffer.data() + first, buffer.data() + last, compare);
+  });
+
+  std::vector<std::size_t> bounds(chunks + 1);
+  for (std::size_t chunk = 0; chunk <= chunks; ++chunk)
+  {
+    bounds[chunk] = chunk_begin(size, chunks, chunk);
+  }
+
+  T* source = buffer.data();
+  T* destination = data;
+  while (bounds.size() > 2)
+  {
+    const auto runs = bounds.size() - 1;
+    pool.parallel_for(
+      0,
+      (runs + 1) / 2,
+      [&](std::size_t pair) {
+        const auto first = bounds[2 * pair];
+        const auto middle = bounds[std::min(2 * pair + 1, runs)];
+        const auto last = bounds[std::min(2 * pair + 2, runs)];
+        merge(source, first, middle, last, destination, compare, pool);
+      },
+      1);
+
+    std::vector<std::size_t> merged;
+    for (std::size_t bound = 0; bound < bounds.size(); bound += 2)
+    {
+      merged.push_back(bounds[bound]);
+    }
+    if (merged.back() != size)
+    {
+      merged.push_back(size);
+    }
+    bounds = std::move(merged);
+    std::swap(source, destination);
+  }
+
+  if (source != data)
+  {
+    for_each_chunk(pool, size, chunks, [&](std::size_t, std::size_t first, std::size_t last) {
+      std::move(source + first, source + last, data + first);
+    });
+  }
+}
+} // namespace detail
+
+/// @brief Calls function(element) for every element.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename Function>
+void for_each(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+              Function function,
+              ThreadPool& pool = ThreadPool::global())
+{
+  T* data = values.data();
+  pool.parallel_for_ranges(0, values.size(), [&](std::size_t first, std::size_t last) {
+    for (auto i = first; i < last; ++i)
+    {
+      function(data[i]);
+    }
+  });
+}
+
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename Function>
+void for_each(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+              Function function,
+              ThreadPool& pool = ThreadPool::global())
+{
+  const T* data = values.data();
+  pool.parallel_for_ranges(0, values.size(), [&](std::size_t first, std::size_t last) {
+    for (auto i = first; i < last; ++i)
+    {
+      function(data[i]);
+    }
+  });
+}
+
+/// @brief Resizes output to input's size and sets output[i] = operation(input[i]). output may be
+/// input.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename U,
+          typename OutputAllocator,
+          typename OutputGrowthPolicy,
+          std::size_t OutputInlineCapacity,
+          typename Operation>
+void transform(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& input,
+               Vector<U, OutputAllocator, OutputGrowthPolicy, OutputInlineCapacity>& output,
+               Operation operation,
+               ThreadPool& pool = ThreadPool::global())
+{
+  output.resize(input.size());
+
+  const T* source = input.data();
+  U* destination = output.data();
+  pool.parallel_for_ranges(0, input.size(), [&](std::size_t first, std::size_t last) {
+    for (auto i = first; i < last; ++i)
+    {
+      destination[i] = operation(source[i]);
+    }
+  });
+}
+
+/// @brief init combined with transform(element) for every element, by reduce.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename Result,
+          typename Reduce,
+          typename Transform>
+Result transform_reduce(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+                        Result init,
+                        Reduce reduce,
+                        Transform transform,
+                        ThreadPool& pool = ThreadPool::global())
+{
+  return detail::transform_reduce(
+    values.data(), values.size(), std::move(init), reduce, transform, pool);
+}
+
+/// @brief init combined with every element, by operation: the sum, unless told otherwise.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename Result,
+          typename Reduce = std::plus<>>
+Result reduce(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+              Result init,
+              Reduce operation = Reduce{},
+              ThreadPool& pool = ThreadPool::global())
+{
+  return detail::transform_reduce(
+    values.data(),
+    values.size(),
+    std::move(init),
+    operation,
+    [](const T& value) -> const T& { return value; },
+    pool);
+}
+
+/// @brief Resizes output to input's size and sets output[i] to input[0] through input[i] combined
+/// by operation: the running sum, unless told otherwise. output may be input.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename U,
+          typename OutputAllocator,
+          typename OutputGrowthPolicy,
+          std::size_t OutputInlineCapacity,
+          typename Operation = std::plus<>>
+void inclusive_scan(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& input,
+                    Vector<U, OutputAllocator, OutputGrowthPolicy, OutputInlineCapacity>& output,
+                    Operation operation = Operation{},
+                    ThreadPool& pool = ThreadPool::global())
+{
+  output.resize(input.size());
+  detail::scan<true>(
+    input.data(), output.data(), input.size(), std::optional<U>{}, operation, pool);
+}
+
+/// @brief Resizes output to input's size and sets output[i] to init and input[0] through
+/// input[i - 1] combined by operation. output may be input.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename U,
+          typename OutputAllocator,
+          typename OutputGrowthPolicy,
+          std::size_t OutputInlineCapacity,
+          typename Operation = std::plus<>>
+void exclusive_scan(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& input,
+                    Vector<U, OutputAllocator, OutputGrowthPolicy, OutputInlineCapacity>& output,
+                    U init,
+                    Operation operation = Operation{},
+                    ThreadPool& pool = ThreadPool::global())
+{
+  output.resize(input.size());
+  detail::scan<false>(
+    input.data(), output.data(), input.size(), std::optional<U>{std::move(init)}, operation, pool);
+}
+
+/// @brief Sorts the elements, like std::sort: equal elements may be reordered, and if compare
+/// throws the elements are left valid but unspecified. Elements whose move constructor may throw
+/// are sorted with std::sort on the calling thread.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename Compare = std::less<>>
+void sort(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+          Compare compare = Compare{},
+          ThreadPool& pool = ThreadPool::global())
+{
+  detail::sort(values.data(), values.size(), compare, pool);
+}
+} // namespace parallel
+} // namespace CppTraining
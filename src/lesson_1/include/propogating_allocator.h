@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
 namespace CppTraining
 {
 template <typename T>
@@ -22,9 +28,30 @@ public:
   PropagatingAllocator& operator=(PropagatingAllocator&&) noexcept = default;
   ~PropagatingAllocator() = default;
 
-  T* allocate(std::size_t n) { return reinterpret_cast<T*>(::operator new(n * sizeof(T))); }
+  T* allocate(std::size_t n)
+  {
+    auto p = std::malloc(n * sizeof(T));
+    if (p == nullptr)
+    {
+      throw std::bad_alloc();
+    }
+
+    return static_cast<T*>(p);
+  }
+
+  void deallocate(T* p, std::size_t) noexcept { std::free(p); }
+
+  // Allocator extension (see allocator_extensions.h): lets Vector grow with realloc
+  T* reallocate(T* p, std::size_t, std::size_t new_count)
+  {
+    auto result = std::realloc(static_cast<void*>(p), new_count * sizeof(T));
+    if (result == nullptr)
+    {
+      throw std::bad_alloc();
+    }
 
-  void deallocate(T* p, std::size_t) noexcept { ::operator delete(p); }
+    return static_cast<T*>(result);
+  }
 
   std::uint32_t getId() const { return id_; }
 
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "default_growth_policy.h"
+#include "ebo_storage.h"
+
+namespace CppTraining
+{
+/// @brief An append-only vector that many threads can grow at once, in the spirit of
+/// tbb::concurrent_vector. Elements live in segments that are never moved or freed until the
+/// vector is cleared or destroyed, so references, pointers and iterators stay valid while other
+/// threads append.
+///
+/// push_back(), emplace_back() and grow_by() claim their indices with a single atomic add and take
+/// no locks; the thread that first needs a segment allocates it. The growth policy sizes the
+/// segments the way it sizes a Vector's blocks: the first segment holds first_segment_capacity
+/// elements (rounded up to a power of two, at least 2) and each later one adds what the policy
+/// returns for the capacity so far. With DefaultGrowthPolicy the segments double, and finding an
+/// element's segment takes a couple of bit operations; with other policies it takes a binary
+/// search.
+///
+/// Safe to call concurrently: the appending functions, reserve(), size(), empty(), operator[],
+/// at() and the iterators. An element may only be read once the call that appended it has
+/// returned (and the reader has synchronized with that thread), so a size() seen while others are
+/// appending may count elements still under construction. clear() and the destructor must not run
+/// concurrently with anything. The allocator must be safe to use from several threads at once.
+///
+/// If constructing an element throws, the indices claimed by that call become a hole: they count
+/// towards size() but hold no elements, and must not be accessed.
+template <typename T,
+          typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = DefaultGrowthPolicy>
+class CPP_TRAINING_EMPTY_BASES SegmentedVector final : private detail::EboStorage<Allocator, 0>
+{
+  template <bool Const>
+  class BasicIterator;
+
+public:
+  using size_type = std::size_t;
+  using value_type = T;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using rvalue_reference = value_type&&;
+
+  using allocator_type = Allocator;
+  using allocator_traits = std::allocator_traits<Allocator>;
+
+  using growth_policy_type = GrowthPolicy;
+
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+
+  static constexpr size_type DefaultFirstSegmentCapacity = 16;
+
+  /// @brief The most segments a vector can have, which bounds its capacity when the growth policy
+  /// does not grow geometrically.
+  static constexpr size_type MaxSegmentCount = 4096;
+
+  explicit SegmentedVector(size_type first_segment_capacity = DefaultFirstSegmentCapacity,
+                           const allocator_type& allocator = allocator_type{},
+                           growth_policy_type growth_policy = growth_policy_type{});
+
+  // Other threads may hold references into the segments, so they never move
+  SegmentedVector(const SegmentedVector&) = delete;
+  SegmentedVector(SegmentedVector&&) = delete;
+  SegmentedVector& operator=(const SegmentedVector&) = delete;
+  SegmentedVector& operator=(SegmentedVector&&) = delete;
+  ~SegmentedVector() noexcept;
+
+  reference operator[](size_type index);
+  const_reference operator[](size_type index) const;
+  reference at(size_type index);
+  const_reference at(size_type index) const;
+
+  /// @brief The number of indices claimed so far, including elements still being constructed.
+  size_type size() const noexcept;
+  bool empty() const noexcept;
+
+  /// @brief The largest size the segment table allows.
+  size_type max_size() const noexcept;
+
+  /// @brief Allocates the segments for the first capacity elements now, rather than on first use.
+  void reserve(size_type capacity);
+
+  /// @brief Destroys every element but keeps the segments.
+  void clear() noexcept;
+
+  template <typename... Args>
+  Iterator emplace_back(Args&&... args);
+  Iterator push_back(const_reference value);
+  Iterator push_back(rvalue_reference value);
+
+  /// @brief Appends count contiguous elements, value-initialized or copied from value, and returns
+  /// an iterator to the first of them. Elements other threads append meanwhile go before or after
+  /// the whole range.
+  Iterator grow_by(size_type count);
+  Iterator grow_by(size_type count, const_reference value);
+
+  Iterator begin() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  Iterator end() noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cend() const noexcept;
+
+private:
+  using allocator_storage = detail::EboStorage<Allocator, 0>;
+
+  allocator_type& allocator() noexcept;
+
+  size_type segment_of(size_type index) const noexcept;
+
+  /// @brief The storage for segment, allocated by whichever thread gets here first.
+  value_type* segment_data(size_type segment);
+  value_type* element(size_type index) const noexcept;
+
+  /// @brief Claims count indices and calls construct(slot) for each, segment by segment. If a
+  /// construction throws, the elements constructed so far are destroyed and the indices become a
+  /// hole.
+  template <typename Construct>
+  Iterator append(size_type count, Construct construct);
+  void add_hole(size_type first, size_type last);
+
+  void destroy_elements() noexcept;
+
+  // Where each segment starts, followed by the capacity of them all. Fixed at construction, so
+  // readers need no synchronization to use it.
+  std::vector<size_type> segment_starts_;
+  std::unique_ptr<std::atomic<value_type*>[]> segments_;
+  size_type first_segment_shift_;
+
+  // Indices whose construction failed, as [first, last) pairs
+  std::mutex holes_mutex_;
+  std::vector<std::pair<size_type, size_type>> holes_;
+
+  // Every append hits this, so it gets a cache line of its own
+  alignas(64) std::atomic<size_type> size_{0};
+};
+
+/// @brief Iterates by index, looking up the segment on every access.
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <bool Const>
+class SegmentedVector<T, Allocator, GrowthPolicy>::BasicIterator final
+{
+  friend SegmentedVector;
+  friend class BasicIterator<!Const>;
+
+  using container_type = std::conditional_t<Const, const SegmentedVector, SegmentedVector>;
+
+public:
+  using size_type = SegmentedVector::size_type;
+  using value_type = SegmentedVector::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<Const, const value_type&, value_type&>;
+  using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+  using iterator_category = std::random_access_iterator_tag;
+
+  BasicIterator() = default;
+
+  /// @brief An Iterator converts to a ConstIterator.
+  template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+  BasicIterator(const BasicIterator<OtherConst>& other)
+      : container_{other.container_}
+      , index_{other.index_}
+  {
+  }
+
+  reference operator*() const
+  {
+    if (container_ == nullptr)
+    {
+      throw std::runtime_error("Unassociated iterator.");
+    }
+
+    return (*container_)[index_];
+  }
+
+  pointer operator->() const { return std::addressof(**this); }
+  reference operator[](difference_type offset) const { return *(*this + offset); }
+
+  BasicIterator& operator++()
+  {
+    ++index_;
+    return *this;
+  }
+
+  BasicIterator operator++(int)
+  {
+    auto previous = *this;
+    ++index_;
+    return previous;
+  }
+
+  BasicIterator& operator--()
+  {
+    --index_;
+    return *this;
+  }
+
+  BasicIterator operator--(int)
+  {
+    auto previous = *this;
+    --index_;
+    return previous;
+  }
+
+  BasicIterator& operator+=(difference_type offset)
+  {
+    index_ = static_cast<size_type>(static_cast<difference_type>(index_) + offset);
+    return *this;
+  }
+
+  BasicIterator& operator-=(difference_type offset) { return *this += -offset; }
+
+  friend BasicIterator operator+(BasicIterator iterator, difference_type offset)
+  {
+    return iterator += offset;
+  }
+
+  friend BasicIterator operator+(difference_type offset, BasicIterator iterator)
+  {
+    return iterator += offset;
+  }
+
+  friend BasicIterator operator-(BasicIterator iterator, difference_type offset)
+  {
+    return iterator -= offset;
+  }
+
+  friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+  }
+
+  friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return lhs.container_ == rhs.container_ && lhs.index_ == rhs.index_;
+  }
+
+  friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return lhs.index_ < rhs.index_;
+  }
+
+  friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) { return rhs < lhs; }
+
+  friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+private:
+  BasicIterator(container_type& container, size_type index)
+      : container_{&container}
+      , index_{index}
+  {
+  }
+
+  container_type* container_{nullptr};
+  size_type index_{0};
+};
+} // namespace CppTraining
+
+#include "segmented_vector.inl"
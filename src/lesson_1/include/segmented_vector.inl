@@ -0,0 +1,364 @@
+#include "segmented_vector.h"
+
+#include <algorithm>
+
+namespace CppTraining
+{
+namespace detail
+{
+/// @brief The index of the highest set bit. value must not be zero.
+inline std::size_t floor_log2(std::size_t value) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(63 - __builtin_clzll(static_cast<unsigned long long>(value)));
+#else
+  std::size_t log = 0;
+  while (value >>= 1)
+  {
+    ++log;
+  }
+  return log;
+#endif
+}
+} // namespace detail
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+SegmentedVector<T, Allocator, GrowthPolicy>::SegmentedVector(size_type first_segment_capacity,
+                                                             const allocator_type& allocator,
+                                                             growth_policy_type growth_policy)
+    : allocator_storage{allocator}
+{
+  size_type capacity = 2;
+  while (capacity < first_segment_capacity)
+  {
+    capacity *= 2;
+  }
+  first_segment_shift_ = detail::floor_log2(capacity);
+
+  // The whole table up front: with the segments' starts fixed, finding an element never races
+  // with a segment being added
+  const auto limit = allocator_traits::max_size(this->allocator());
+  segment_starts_.push_back(0);
+  segment_starts_.push_back(capacity);
+  while (segment_starts_.size() <= MaxSegmentCount && capacity < limit)
+  {
+    const auto increment = std::max<size_type>(1, growth_policy(capacity, capacity));
+    capacity = increment < limit - capacity ? capacity + increment : limit;
+    segment_starts_.push_back(capacity);
+  }
+
+  segments_ = std::make_unique<std::atomic<value_type*>[]>(segment_starts_.size() - 1);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+SegmentedVector<T, Allocator, GrowthPolicy>::~SegmentedVector() noexcept
+{
+  destroy_elements();
+
+  for (size_type segment = 0; segment + 1 < segment_starts_.size(); ++segment)
+  {
+    if (auto* data = segments_[segment].load(std::memory_order_relaxed))
+    {
+      allocator_traits::deallocate(allocator(),
+                                   data,
+                                   segment_starts_[segment + 1] - segment_starts_[segment]);
+    }
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+typename SegmentedVector<T, Allocator, GrowthPolicy>::reference
+SegmentedVector<T, Allocator, GrowthPolicy>::operator[](size_type index)
+{
+  if (index >= size())
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  return *element(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+typename SegmentedVector<T, Allocator, GrowthPolicy>::const_reference
+SegmentedVector<T, Allocator, GrowthPolicy>::operator[](size_type index) const
+{
+  if (index >= size())
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  return *element(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::reference
+SegmentedVector<T, Allocator, GrowthPolicy>::at(size_type index)
+{
+  return operator[](index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::const_reference
+SegmentedVector<T, Allocator, GrowthPolicy>::at(size_type index) const
+{
+  return operator[](index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::size_type
+SegmentedVector<T, Allocator, GrowthPolicy>::size() const noexcept
+{
+  return size_.load(std::memory_order_acquire);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline bool SegmentedVector<T, Allocator, GrowthPolicy>::empty() const noexcept
+{
+  return size() == 0;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::size_type
+SegmentedVector<T, Allocator, GrowthPolicy>::max_size() const noexcept
+{
+  return segment_starts_.back();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void SegmentedVector<T, Allocator, GrowthPolicy>::reserve(size_type capacity)
+{
+  if (capacity > max_size())
+  {
+    throw std::length_error("SegmentedVector capacity exceeds max_size().");
+  }
+
+  for (size_type segment = 0; segment_starts_[segment] < capacity; ++segment)
+  {
+    segment_data(segment);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void SegmentedVector<T, Allocator, GrowthPolicy>::clear() noexcept
+{
+  destroy_elements();
+  holes_.clear();
+  size_.store(0, std::memory_order_relaxed);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <typename... Args>
+typename SegmentedVector<T, Allocator, GrowthPolicy>::Iterator
+SegmentedVector<T, Allocator, GrowthPolicy>::emplace_back(Args&&... args)
+{
+  return append(1, [&](value_type* slot) {
+    allocator_traits::construct(allocator(), slot, std::forward<Args>(args)...);
+  });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::Iterator
+SegmentedVector<T, Allocator, GrowthPolicy>::push_back(const_reference value)
+{
+  return emplace_back(value);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::Iterator
+SegmentedVector<T, Allocator, GrowthPolicy>::push_back(rvalue_reference value)
+{
+  return emplace_back(std::move(value));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+typename SegmentedVector<T, Allocator, GrowthPolicy>::Iterator
+SegmentedVector<T, Allocator, GrowthPolicy>::grow_by(size_type count)
+{
+  return append(count,
+                [this](value_type* slot) { allocator_traits::construct(allocator(), slot); });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+typename SegmentedVector<T, Allocator, GrowthPolicy>::Iterator
+SegmentedVector<T, Allocator, GrowthPolicy>::grow_by(size_type count, const_reference value)
+{
+  return append(count,
+                [this, &value](value_type* slot) {
+                  allocator_traits::construct(allocator(), slot, value);
+                });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::Iterator
+SegmentedVector<T, Allocator, GrowthPolicy>::begin() noexcept
+{
+  return Iterator{*this, 0};
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::ConstIterator
+SegmentedVector<T, Allocator, GrowthPolicy>::begin() const noexcept
+{
+  return ConstIterator{*this, 0};
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::ConstIterator
+SegmentedVector<T, Allocator, GrowthPolicy>::cbegin() const noexcept
+{
+  return begin();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::Iterator
+SegmentedVector<T, Allocator, GrowthPolicy>::end() noexcept
+{
+  return Iterator{*this, size()};
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::ConstIterator
+SegmentedVector<T, Allocator, GrowthPolicy>::end() const noexcept
+{
+  return ConstIterator{*this, size()};
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::ConstIterator
+SegmentedVector<T, Allocator, GrowthPolicy>::cend() const noexcept
+{
+  return end();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::allocator_type&
+SegmentedVector<T, Allocator, GrowthPolicy>::allocator() noexcept
+{
+  return allocator_storage::get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::size_type
+SegmentedVector<T, Allocator, GrowthPolicy>::segment_of(size_type index) const noexcept
+{
+  if constexpr (std::is_same_v<GrowthPolicy, DefaultGrowthPolicy>)
+  {
+    // Segment k > 0 starts at first << (k - 1)
+    const auto first_mask = (size_type{1} << first_segment_shift_) - 1;
+    return detail::floor_log2(index | first_mask) + 1 - first_segment_shift_;
+  }
+  else
+  {
+    const auto next =
+      std::upper_bound(segment_starts_.begin() + 1, segment_starts_.end(), index);
+    return static_cast<size_type>(next - segment_starts_.begin()) - 1;
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+typename SegmentedVector<T, Allocator, GrowthPolicy>::value_type*
+SegmentedVector<T, Allocator, GrowthPolicy>::segment_data(size_type segment)
+{
+  auto* data = segments_[segment].load(std::memory_order_acquire);
+  if (data != nullptr)
+  {
+    return data;
+  }
+
+  // Threads that need the segment at the same time all allocate one; the first to publish it
+  // wins and the others give theirs back
+  const auto capacity = segment_starts_[segment + 1] - segment_starts_[segment];
+  auto* allocated = allocator_traits::allocate(allocator(), capacity);
+  if (segments_[segment].compare_exchange_strong(
+        data, allocated, std::memory_order_acq_rel, std::memory_order_acquire))
+  {
+    return allocated;
+  }
+
+  allocator_traits::deallocate(allocator(), allocated, capacity);
+  return data;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+inline typename SegmentedVector<T, Allocator, GrowthPolicy>::value_type*
+SegmentedVector<T, Allocator, GrowthPolicy>::element(size_type index) const noexcept
+{
+  const auto segment = segment_of(index);
+  return segments_[segment].load(std::memory_order_acquire) + (index - segment_starts_[segment]);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+template <typename Construct>
+typename SegmentedVector<T, Allocator, GrowthPolicy>::Iterator
+SegmentedVector<T, Allocator, GrowthPolicy>::append(size_type count, Construct construct)
+{
+  const auto first = size_.fetch_add(count, std::memory_order_relaxed);
+  const auto last = first + count;
+  if (first > max_size() || count > max_size() - first)
+  {
+    add_hole(first, last);
+    throw std::length_error("SegmentedVector size exceeds max_size().");
+  }
+
+  auto index = first;
+  try
+  {
+    while (index < last)
+    {
+      const auto segment = segment_of(index);
+      auto* data = segment_data(segment);
+      const auto segment_first = segment_starts_[segment];
+      const auto segment_last = std::min(last, segment_starts_[segment + 1]);
+      for (; index < segment_last; ++index)
+      {
+        construct(data + (index - segment_first));
+      }
+    }
+  }
+  catch (...)
+  {
+    for (auto constructed = first; constructed < index; ++constructed)
+    {
+      allocator_traits::destroy(allocator(), element(constructed));
+    }
+    add_hole(first, last);
+    throw;
+  }
+
+  return Iterator{*this, first};
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void SegmentedVector<T, Allocator, GrowthPolicy>::add_hole(size_type first, size_type last)
+{
+  std::lock_guard<std::mutex> lock{holes_mutex_};
+  holes_.emplace_back(first, last);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy>
+void SegmentedVector<T, Allocator, GrowthPolicy>::destroy_elements() noexcept
+{
+  if constexpr (!std::is_trivially_destructible_v<value_type>)
+  {
+    std::sort(holes_.begin(), holes_.end());
+    auto hole = holes_.begin();
+
+    const auto size = std::min(size_.load(std::memory_order_relaxed), max_size());
+    for (size_type index = 0; index < size; ++index)
+    {
+      while (hole != holes_.end() && hole->second <= index)
+      {
+        ++hole;
+      }
+
+      if (hole != holes_.end() && hole->first <= index)
+      {
+        index = std::min(hole->second, size) - 1;
+        continue;
+      }
+
+      allocator_traits::destroy(allocator(), element(index));
+    }
+  }
+}
+} // namespace CppTraining
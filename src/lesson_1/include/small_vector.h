@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "default_growth_policy.h"
+#include "vector.h"
+
+namespace CppTraining
+{
+/// @brief A Vector with room for N elements embedded in the object itself. It only allocates once
+/// it holds more than N elements, and shrink_to_fit() moves the elements back inline when they fit
+/// again. It has the same interface as Vector, so it can be dropped in wherever a Vector is used.
+///
+/// Unlike with Vector, moving or swapping a SmallVector whose elements are inline moves the
+/// elements themselves, so it invalidates iterators and is linear in N.
+template <typename T,
+          std::size_t N,
+          typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = DefaultGrowthPolicy>
+using SmallVector = Vector<T, Allocator, GrowthPolicy, N>;
+} // namespace CppTraining
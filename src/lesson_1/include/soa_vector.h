@@ -0,0 +1,302 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <gsl/span>
+
+#include "default_growth_policy.h"
+#include "vector.h"
+
+namespace CppTraining
+{
+/// @brief A vector of records stored as a structure of arrays: each field lives in its own
+/// contiguous column, a Vector of that field's type. A scan that reads one or two fields of a wide
+/// record then loads only those columns, instead of whole records of which it uses a fraction.
+///
+/// Allocator is rebound to each field type and every column grows by GrowthPolicy; since the
+/// columns grow together, they all have the same capacity. Use SoaVector<Fields...> for the
+/// default allocator and growth policy.
+///
+/// Elements are accessed through proxies: Reference is a std::tuple of references to the fields,
+/// so std::get<I>() and the tuple comparisons work on it, and assigning to it assigns the fields.
+/// The iterators are random access and work with std::sort. Because a proxy is returned by value,
+/// algorithms that move an element out of the vector (as std::sort does with its pivot) copy it
+/// instead; swaps still swap the fields in place.
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+class BasicSoaVector final
+{
+  static_assert(sizeof...(Fields) > 0, "A SoaVector needs at least one field");
+
+  template <typename Field>
+  using field_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Field>;
+  template <typename Field>
+  using column_of = Vector<Field, field_allocator<Field>, GrowthPolicy>;
+
+  template <bool Const>
+  class BasicReference;
+  template <bool Const>
+  class BasicIterator;
+
+public:
+  using size_type = std::size_t;
+  using value_type = std::tuple<Fields...>;
+
+  using allocator_type = Allocator;
+  using growth_policy_type = GrowthPolicy;
+
+  template <std::size_t I>
+  using field_type = std::tuple_element_t<I, value_type>;
+
+  /// @brief The Vector that holds field I.
+  template <std::size_t I>
+  using column_type = column_of<field_type<I>>;
+
+  using Reference = BasicReference<false>;
+  using ConstReference = BasicReference<true>;
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+
+  static constexpr size_type field_count = sizeof...(Fields);
+
+  explicit BasicSoaVector(size_type capacity = 0,
+                          const allocator_type& allocator = allocator_type{},
+                          growth_policy_type growth_policy = growth_policy_type{});
+
+  Reference operator[](size_type index);
+  ConstReference operator[](size_type index) const;
+  Reference at(size_type index);
+  ConstReference at(size_type index) const;
+  Reference front();
+  ConstReference front() const;
+  Reference back();
+  ConstReference back() const;
+
+  /// @brief Field I of every element, contiguous in memory.
+  template <std::size_t I>
+  gsl::span<field_type<I>> column() noexcept;
+  template <std::size_t I>
+  gsl::span<const field_type<I>> column() const noexcept;
+
+  size_type size() const noexcept;
+  size_type capacity() const noexcept;
+  bool empty() const noexcept;
+
+  void reserve(size_type capacity);
+  void resize(size_type size);
+  void clear();
+  void shrink_to_fit();
+
+  /// @brief Appends an element whose fields are constructed from one argument each. If
+  /// constructing a field throws, the fields already appended are removed again.
+  template <typename... Args>
+  Iterator emplace_back(Args&&... args);
+  Iterator push_back(const value_type& value);
+  Iterator push_back(value_type&& value);
+  void pop_back();
+
+  Iterator begin() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  Iterator end() noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cend() const noexcept;
+
+private:
+  using indices = std::index_sequence_for<Fields...>;
+
+  template <std::size_t... I>
+  Reference reference(size_type index, std::index_sequence<I...>) noexcept;
+  template <std::size_t... I>
+  ConstReference reference(size_type index, std::index_sequence<I...>) const noexcept;
+
+  /// @brief Appends std::get<I>(args) to column I, and so on for the columns after it, removing
+  /// it again if a later column throws.
+  template <std::size_t I, typename Tuple>
+  void emplace_fields(Tuple&& args);
+
+  std::tuple<column_of<Fields>...> columns_;
+};
+
+/// @brief A tuple of references to one element's fields. Assigning to it assigns the fields, and
+/// swapping two of them swaps the fields in place.
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+template <bool Const>
+class BasicSoaVector<Allocator, GrowthPolicy, Fields...>::BasicReference final
+    : public std::tuple<std::conditional_t<Const, const Fields&, Fields&>...>
+{
+  using base = std::tuple<std::conditional_t<Const, const Fields&, Fields&>...>;
+
+public:
+  using base::base;
+  using base::operator=;
+
+  BasicReference(const BasicReference&) = default;
+
+  /// @brief A Reference converts to a ConstReference.
+  template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+  BasicReference(const BasicReference<OtherConst>& other) : base{other}
+  {
+  }
+
+  // Assigns the fields rather than rebinding the references. A proxy is always an rvalue, so
+  // there is no separate move assignment: it would move out of elements that are only being read.
+  BasicReference& operator=(const BasicReference& other)
+  {
+    base::operator=(static_cast<const base&>(other));
+    return *this;
+  }
+
+  friend void swap(BasicReference lhs, BasicReference rhs)
+  {
+    static_cast<base&>(lhs).swap(static_cast<base&>(rhs));
+  }
+};
+
+/// @brief Iterates by index. Validated like Vector's iterators unless
+/// CPP_TRAINING_UNCHECKED_ITERATORS is defined.
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+template <bool Const>
+class BasicSoaVector<Allocator, GrowthPolicy, Fields...>::BasicIterator final
+{
+  friend BasicSoaVector;
+  friend class BasicIterator<!Const>;
+
+  using container_type = std::conditional_t<Const, const BasicSoaVector, BasicSoaVector>;
+
+public:
+  using size_type = BasicSoaVector::size_type;
+  using value_type = BasicSoaVector::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = BasicReference<Const>;
+  using pointer = void;
+  using iterator_category = std::random_access_iterator_tag;
+
+  BasicIterator() = default;
+
+  /// @brief An Iterator converts to a ConstIterator.
+  template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+  BasicIterator(const BasicIterator<OtherConst>& other)
+      : container_{other.container_}
+      , index_{other.index_}
+  {
+  }
+
+  reference operator*() const
+  {
+#if defined(CPP_TRAINING_UNCHECKED_ITERATORS)
+    return container_->reference(index_, indices{});
+#else
+    if (container_ == nullptr)
+    {
+      throw std::runtime_error("Unassociated iterator.");
+    }
+
+    return (*container_)[index_];
+#endif
+  }
+
+  reference operator[](difference_type offset) const { return *(*this + offset); }
+
+  BasicIterator& operator++()
+  {
+    ++index_;
+    return *this;
+  }
+
+  BasicIterator operator++(int)
+  {
+    auto previous = *this;
+    ++index_;
+    return previous;
+  }
+
+  BasicIterator& operator--()
+  {
+    --index_;
+    return *this;
+  }
+
+  BasicIterator operator--(int)
+  {
+    auto previous = *this;
+    --index_;
+    return previous;
+  }
+
+  BasicIterator& operator+=(difference_type offset)
+  {
+    index_ = static_cast<size_type>(static_cast<difference_type>(index_) + offset);
+    return *this;
+  }
+
+  BasicIterator& operator-=(difference_type offset) { return *this += -offset; }
+
+  friend BasicIterator operator+(BasicIterator iterator, difference_type offset)
+  {
+    return iterator += offset;
+  }
+
+  friend BasicIterator operator+(difference_type offset, BasicIterator iterator)
+  {
+    return iterator += offset;
+  }
+
+  friend BasicIterator operator-(BasicIterator iterator, difference_type offset)
+  {
+    return iterator -= offset;
+  }
+
+  friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+  }
+
+  friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return lhs.container_ == rhs.container_ && lhs.index_ == rhs.index_;
+  }
+
+  friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return lhs.index_ < rhs.index_;
+  }
+
+  friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) { return rhs < lhs; }
+
+  friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+private:
+  BasicIterator(container_type& container, size_type index)
+      : container_{&container}
+      , index_{index}
+  {
+  }
+
+  container_type* container_{nullptr};
+  size_type index_{0};
+};
+
+template <typename... Fields>
+using SoaVector = BasicSoaVector<std::allocator<std::byte>, DefaultGrowthPolicy, Fields...>;
+} // namespace CppTraining
+
+#include "soa_vector.inl"
@@ -0,0 +1,268 @@
+#include "soa_vector.h"
+
+namespace CppTraining
+{
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::BasicSoaVector(size_type capacity,
+                                                                   const allocator_type& allocator,
+                                                                   growth_policy_type growth_policy)
+    : columns_{column_of<Fields>{capacity, field_allocator<Fields>{allocator}, growth_policy}...}
+{
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Reference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::operator[](size_type index)
+{
+  if (index >= size())
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  return reference(index, indices{});
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstReference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::operator[](size_type index) const
+{
+  if (index >= size())
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  return reference(index, indices{});
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Reference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::at(size_type index)
+{
+  return operator[](index);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstReference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::at(size_type index) const
+{
+  return operator[](index);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Reference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::front()
+{
+  return operator[](0);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstReference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::front() const
+{
+  return operator[](0);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Reference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::back()
+{
+  return operator[](size() - 1);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstReference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::back() const
+{
+  return operator[](size() - 1);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+template <std::size_t I>
+inline gsl::span<
+  typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::template field_type<I>>
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::column() noexcept
+{
+  auto& column = std::get<I>(columns_);
+  return {column.data(), column.size()};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+template <std::size_t I>
+inline gsl::span<
+  const typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::template field_type<I>>
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::column() const noexcept
+{
+  const auto& column = std::get<I>(columns_);
+  return {column.data(), column.size()};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::size_type
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::size() const noexcept
+{
+  return std::get<0>(columns_).size();
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::size_type
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::capacity() const noexcept
+{
+  return std::get<0>(columns_).capacity();
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline bool BasicSoaVector<Allocator, GrowthPolicy, Fields...>::empty() const noexcept
+{
+  return size() == 0;
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Allocator, GrowthPolicy, Fields...>::reserve(size_type capacity)
+{
+  std::apply([capacity](auto&... columns) { (columns.reserve(capacity), ...); }, columns_);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Allocator, GrowthPolicy, Fields...>::resize(size_type size)
+{
+  const auto old_size = this->size();
+  try
+  {
+    std::apply([size](auto&... columns) { (columns.resize(size), ...); }, columns_);
+  }
+  catch (...)
+  {
+    // Shrinking back cannot throw, and keeps the columns the same length
+    std::apply([old_size](auto&... columns) { (columns.resize(old_size), ...); }, columns_);
+    throw;
+  }
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Allocator, GrowthPolicy, Fields...>::clear()
+{
+  std::apply([](auto&... columns) { (columns.clear(), ...); }, columns_);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Allocator, GrowthPolicy, Fields...>::shrink_to_fit()
+{
+  std::apply([](auto&... columns) { (columns.shrink_to_fit(), ...); }, columns_);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+template <typename... Args>
+typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Iterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::emplace_back(Args&&... args)
+{
+  static_assert(sizeof...(Args) == field_count, "emplace_back takes one argument per field");
+
+  emplace_fields<0>(std::forward_as_tuple(std::forward<Args>(args)...));
+  return Iterator{*this, size() - 1};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Iterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::push_back(const value_type& value)
+{
+  emplace_fields<0>(value);
+  return Iterator{*this, size() - 1};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Iterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::push_back(value_type&& value)
+{
+  emplace_fields<0>(std::move(value));
+  return Iterator{*this, size() - 1};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+void BasicSoaVector<Allocator, GrowthPolicy, Fields...>::pop_back()
+{
+  std::apply([](auto&... columns) { (columns.pop_back(), ...); }, columns_);
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Iterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::begin() noexcept
+{
+  return Iterator{*this, 0};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstIterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::begin() const noexcept
+{
+  return ConstIterator{*this, 0};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstIterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::cbegin() const noexcept
+{
+  return begin();
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Iterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::end() noexcept
+{
+  return Iterator{*this, size()};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstIterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::end() const noexcept
+{
+  return ConstIterator{*this, size()};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstIterator
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::cend() const noexcept
+{
+  return end();
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+template <std::size_t... I>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::Reference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::reference(size_type index,
+                                                              std::index_sequence<I...>) noexcept
+{
+  return Reference{std::get<I>(columns_).data()[index]...};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+template <std::size_t... I>
+inline typename BasicSoaVector<Allocator, GrowthPolicy, Fields...>::ConstReference
+BasicSoaVector<Allocator, GrowthPolicy, Fields...>::reference(size_type index,
+                                                              std::index_sequence<I...>) const
+  noexcept
+{
+  return ConstReference{std::get<I>(columns_).data()[index]...};
+}
+
+template <typename Allocator, typename GrowthPolicy, typename... Fields>
+template <std::size_t I, typename Tuple>
+void BasicSoaVector<Allocator, GrowthPolicy, Fields...>::emplace_fields(Tuple&& args)
+{
+  auto& column = std::get<I>(columns_);
+  column.emplace_back(std::get<I>(std::forward<Tuple>(args)));
+
+  if constexpr (I + 1 < field_count)
+  {
+    try
+    {
+      // Each call only moves from its own element of args
+      emplace_fields<I + 1>(std::forward<Tuple>(args));
+    }
+    catch (...)
+    {
+      column.pop_back();
+      throw;
+    }
+  }
+}
+} // namespace CppTraining
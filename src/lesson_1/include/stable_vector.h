@@ -0,0 +1,290 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "ebo_storage.h"
+
+namespace CppTraining
+{
+namespace detail
+{
+/// @brief Elements per block: as many as fit in 4 KiB, but at least 16, rounded down to a power of
+/// two so that finding an element's block is a shift and a mask.
+constexpr std::size_t stable_vector_block_size(std::size_t element_size) noexcept
+{
+  const auto fit = element_size < 4096 / 16 ? 4096 / element_size : 16;
+  std::size_t block_size = 16;
+  while (block_size * 2 <= fit)
+  {
+    block_size *= 2;
+  }
+  return block_size;
+}
+} // namespace detail
+
+/// @brief A vector whose elements never move. They live in fixed-size blocks reached through a
+/// table of block pointers, as in std::deque: growing allocates another block and at most copies
+/// the table, so push_back() and push_front() are O(1) and references and pointers to the
+/// elements stay valid until those elements are removed.
+///
+/// Like std::deque, push_front() and pop_front() renumber the elements, so they invalidate
+/// iterators (which refer to an index) but not references. A block is freed as soon as it is
+/// empty, except that one is kept spare so that pushing and popping across a block boundary does
+/// not allocate every time.
+template <typename T, typename Allocator = std::allocator<T>>
+class CPP_TRAINING_EMPTY_BASES StableVector final : private detail::EboStorage<Allocator, 0>
+{
+  template <bool Const>
+  class BasicIterator;
+
+public:
+  using size_type = std::size_t;
+  using value_type = T;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+  using rvalue_reference = value_type&&;
+
+  using allocator_type = Allocator;
+  using allocator_traits = std::allocator_traits<Allocator>;
+
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+
+  static constexpr size_type BlockSize = detail::stable_vector_block_size(sizeof(T));
+
+  explicit StableVector(const allocator_type& allocator = allocator_type{});
+  StableVector(std::initializer_list<value_type> values,
+               const allocator_type& allocator = allocator_type{});
+  StableVector(const StableVector& other);
+  StableVector(StableVector&& other) noexcept;
+
+  /// @brief If copying an element throws, this vector is left with the elements copied so far.
+  StableVector& operator=(const StableVector& other);
+
+  /// @brief Takes over other's blocks when the allocator moves with them (or all allocators are
+  /// equal). Otherwise the elements are moved into this vector's blocks one at a time.
+  StableVector& operator=(StableVector&& other) noexcept(
+    allocator_traits::propagate_on_container_move_assignment::value ||
+    allocator_traits::is_always_equal::value);
+  ~StableVector() noexcept;
+
+  reference operator[](size_type index);
+  const_reference operator[](size_type index) const;
+  reference at(size_type index);
+  const_reference at(size_type index) const;
+
+  reference front();
+  const_reference front() const;
+  reference back();
+  const_reference back() const;
+
+  size_type size() const noexcept;
+  bool empty() const noexcept;
+
+  /// @brief Destroys every element and frees every block but the spare one.
+  void clear() noexcept;
+
+  template <typename... Args>
+  Iterator emplace_back(Args&&... args);
+  Iterator push_back(const_reference value);
+  Iterator push_back(rvalue_reference value);
+  void pop_back();
+
+  template <typename... Args>
+  Iterator emplace_front(Args&&... args);
+  Iterator push_front(const_reference value);
+  Iterator push_front(rvalue_reference value);
+  void pop_front();
+
+  Iterator begin() noexcept;
+  ConstIterator begin() const noexcept;
+  ConstIterator cbegin() const noexcept;
+  Iterator end() noexcept;
+  ConstIterator end() const noexcept;
+  ConstIterator cend() const noexcept;
+
+private:
+  using allocator_storage = detail::EboStorage<Allocator, 0>;
+  using block_allocator_type = typename allocator_traits::template rebind_alloc<value_type*>;
+  using block_allocator_traits = std::allocator_traits<block_allocator_type>;
+
+  allocator_type& allocator() noexcept;
+  const allocator_type& allocator() const noexcept;
+
+  value_type* element(size_type index) const noexcept;
+
+  /// @brief Constructs an element at position (an index into the whole table), allocating its
+  /// block first if need be.
+  template <typename... Args>
+  void construct_at(size_type position, Args&&... args);
+
+  value_type* allocate_block();
+  void release_block(size_type block) noexcept;
+
+  /// @brief Makes room in the table for another block at either end by moving the blocks in use to
+  /// its middle. The table doubles first if they fill more than half of it.
+  void make_room();
+
+  void destroy_elements() noexcept;
+
+  /// @brief Frees every block, the spare one and the table itself.
+  void release_storage() noexcept;
+
+  /// @brief Takes over other's storage, which must be empty here, and leaves other empty.
+  void steal(StableVector& other) noexcept;
+
+  value_type** blocks_{nullptr};
+  size_type block_count_{0};
+  value_type* spare_block_{nullptr};
+
+  // The first element's position in the table (block * BlockSize + offset)
+  size_type start_{0};
+  size_type size_{0};
+};
+
+/// @brief Iterates by index, looking up the block on every access. Validated like Vector's
+/// iterators unless CPP_TRAINING_UNCHECKED_ITERATORS is defined.
+template <typename T, typename Allocator>
+template <bool Const>
+class StableVector<T, Allocator>::BasicIterator final
+{
+  friend StableVector;
+  friend class BasicIterator<!Const>;
+
+  using container_type = std::conditional_t<Const, const StableVector, StableVector>;
+
+public:
+  using size_type = StableVector::size_type;
+  using value_type = StableVector::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference = std::conditional_t<Const, const value_type&, value_type&>;
+  using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+  using iterator_category = std::random_access_iterator_tag;
+
+  BasicIterator() = default;
+
+  /// @brief An Iterator converts to a ConstIterator.
+  template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+  BasicIterator(const BasicIterator<OtherConst>& other)
+      : container_{other.container_}
+      , index_{other.index_}
+  {
+  }
+
+  reference operator*() const
+  {
+#if defined(CPP_TRAINING_UNCHECKED_ITERATORS)
+    return *container_->element(index_);
+#else
+    if (container_ == nullptr)
+    {
+      throw std::runtime_error("Unassociated iterator.");
+    }
+
+    return (*container_)[index_];
+#endif
+  }
+
+  pointer operator->() const { return std::addressof(**this); }
+  reference operator[](difference_type offset) const { return *(*this + offset); }
+
+  BasicIterator& operator++()
+  {
+    ++index_;
+    return *this;
+  }
+
+  BasicIterator operator++(int)
+  {
+    auto previous = *this;
+    ++index_;
+    return previous;
+  }
+
+  BasicIterator& operator--()
+  {
+    --index_;
+    return *this;
+  }
+
+  BasicIterator operator--(int)
+  {
+    auto previous = *this;
+    --index_;
+    return previous;
+  }
+
+  BasicIterator& operator+=(difference_type offset)
+  {
+    index_ = static_cast<size_type>(static_cast<difference_type>(index_) + offset);
+    return *this;
+  }
+
+  BasicIterator& operator-=(difference_type offset) { return *this += -offset; }
+
+  friend BasicIterator operator+(BasicIterator iterator, difference_type offset)
+  {
+    return iterator += offset;
+  }
+
+  friend BasicIterator operator+(difference_type offset, BasicIterator iterator)
+  {
+    return iterator += offset;
+  }
+
+  friend BasicIterator operator-(BasicIterator iterator, difference_type offset)
+  {
+    return iterator -= offset;
+  }
+
+  friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+  }
+
+  friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return lhs.container_ == rhs.container_ && lhs.index_ == rhs.index_;
+  }
+
+  friend bool operator!=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  friend bool operator<(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return lhs.index_ < rhs.index_;
+  }
+
+  friend bool operator>(const BasicIterator& lhs, const BasicIterator& rhs) { return rhs < lhs; }
+
+  friend bool operator<=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(rhs < lhs);
+  }
+
+  friend bool operator>=(const BasicIterator& lhs, const BasicIterator& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+private:
+  BasicIterator(container_type& container, size_type index)
+      : container_{&container}
+      , index_{index}
+  {
+  }
+
+  container_type* container_{nullptr};
+  size_type index_{0};
+};
+} // namespace CppTraining
+
+#include "stable_vector.inl"
@@ -0,0 +1,492 @@
+#include "stable_vector.h"
+
+#include <algorithm>
+
+namespace CppTraining
+{
+template <typename T, typename Allocator>
+StableVector<T, Allocator>::StableVector(const allocator_type& allocator)
+    : allocator_storage{allocator}
+{
+}
+
+template <typename T, typename Allocator>
+StableVector<T, Allocator>::StableVector(std::initializer_list<value_type> values,
+                                         const allocator_type& allocator)
+    : StableVector(allocator)
+{
+  for (const auto& value : values)
+  {
+    emplace_back(value);
+  }
+}
+
+template <typename T, typename Allocator>
+StableVector<T, Allocator>::StableVector(const StableVector& other)
+    : StableVector(allocator_traits::select_on_container_copy_construction(other.allocator()))
+{
+  for (size_type index = 0; index < other.size_; ++index)
+  {
+    emplace_back(*other.element(index));
+  }
+}
+
+template <typename T, typename Allocator>
+StableVector<T, Allocator>::StableVector(StableVector&& other) noexcept
+    : allocator_storage{other.allocator()}
+{
+  steal(other);
+}
+
+template <typename T, typename Allocator>
+StableVector<T, Allocator>& StableVector<T, Allocator>::operator=(const StableVector& other)
+{
+  if (this == &other)
+  {
+    return *this;
+  }
+
+  clear();
+  if constexpr (allocator_traits::propagate_on_container_copy_assignment::value)
+  {
+    if (!(allocator() == other.allocator()))
+    {
+      release_storage();
+    }
+    allocator() = other.allocator();
+  }
+
+  for (size_type index = 0; index < other.size_; ++index)
+  {
+    emplace_back(*other.element(index));
+  }
+
+  return *this;
+}
+
+template <typename T, typename Allocator>
+StableVector<T, Allocator>& StableVector<T, Allocator>::operator=(StableVector&& other) noexcept(
+  allocator_traits::propagate_on_container_move_assignment::value ||
+  allocator_traits::is_always_equal::value)
+{
+  if (this == &other)
+  {
+    return *this;
+  }
+
+  if (allocator_traits::propagate_on_container_move_assignment::value ||
+      allocator() == other.allocator())
+  {
+    destroy_elements();
+    release_storage();
+    if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+    {
+      allocator() = other.allocator();
+    }
+    steal(other);
+    return *this;
+  }
+
+  // The blocks belong to an allocator this vector cannot free them with
+  clear();
+  for (size_type index = 0; index < other.size_; ++index)
+  {
+    emplace_back(std::move(*other.element(index)));
+  }
+  other.clear();
+
+  return *this;
+}
+
+template <typename T, typename Allocator>
+StableVector<T, Allocator>::~StableVector() noexcept
+{
+  destroy_elements();
+  release_storage();
+}
+
+template <typename T, typename Allocator>
+typename StableVector<T, Allocator>::reference
+StableVector<T, Allocator>::operator[](size_type index)
+{
+  if (index >= size_)
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  return *element(index);
+}
+
+template <typename T, typename Allocator>
+typename StableVector<T, Allocator>::const_reference
+StableVector<T, Allocator>::operator[](size_type index) const
+{
+  if (index >= size_)
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  return *element(index);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::reference
+StableVector<T, Allocator>::at(size_type index)
+{
+  return operator[](index);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::const_reference
+StableVector<T, Allocator>::at(size_type index) const
+{
+  return operator[](index);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::reference StableVector<T, Allocator>::front()
+{
+  return operator[](0);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::const_reference
+StableVector<T, Allocator>::front() const
+{
+  return operator[](0);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::reference StableVector<T, Allocator>::back()
+{
+  return operator[](size_ - 1);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::const_reference
+StableVector<T, Allocator>::back() const
+{
+  return operator[](size_ - 1);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::size_type
+StableVector<T, Allocator>::size() const noexcept
+{
+  return size_;
+}
+
+template <typename T, typename Allocator>
+inline bool StableVector<T, Allocator>::empty() const noexcept
+{
+  return size_ == 0;
+}
+
+template <typename T, typename Allocator>
+void StableVector<T, Allocator>::clear() noexcept
+{
+  destroy_elements();
+  for (size_type block = 0; block < block_count_; ++block)
+  {
+    if (blocks_[block] != nullptr)
+    {
+      release_block(block);
+    }
+  }
+
+  size_ = 0;
+  start_ = block_count_ / 2 * BlockSize;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename StableVector<T, Allocator>::Iterator
+StableVector<T, Allocator>::emplace_back(Args&&... args)
+{
+  if (start_ + size_ == block_count_ * BlockSize)
+  {
+    make_room();
+  }
+
+  construct_at(start_ + size_, std::forward<Args>(args)...);
+  ++size_;
+
+  return Iterator{*this, size_ - 1};
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::Iterator
+StableVector<T, Allocator>::push_back(const_reference value)
+{
+  return emplace_back(value);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::Iterator
+StableVector<T, Allocator>::push_back(rvalue_reference value)
+{
+  return emplace_back(std::move(value));
+}
+
+template <typename T, typename Allocator>
+void StableVector<T, Allocator>::pop_back()
+{
+  if (size_ == 0)
+  {
+    return;
+  }
+
+  const auto position = start_ + --size_;
+  allocator_traits::destroy(allocator(), blocks_[position / BlockSize] + position % BlockSize);
+  if (position % BlockSize == 0 || size_ == 0)
+  {
+    release_block(position / BlockSize);
+  }
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename StableVector<T, Allocator>::Iterator
+StableVector<T, Allocator>::emplace_front(Args&&... args)
+{
+  if (start_ == 0)
+  {
+    make_room();
+  }
+
+  construct_at(start_ - 1, std::forward<Args>(args)...);
+  --start_;
+  ++size_;
+
+  return begin();
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::Iterator
+StableVector<T, Allocator>::push_front(const_reference value)
+{
+  return emplace_front(value);
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::Iterator
+StableVector<T, Allocator>::push_front(rvalue_reference value)
+{
+  return emplace_front(std::move(value));
+}
+
+template <typename T, typename Allocator>
+void StableVector<T, Allocator>::pop_front()
+{
+  if (size_ == 0)
+  {
+    return;
+  }
+
+  const auto position = start_++;
+  --size_;
+  allocator_traits::destroy(allocator(), blocks_[position / BlockSize] + position % BlockSize);
+  if (start_ % BlockSize == 0 || size_ == 0)
+  {
+    release_block(position / BlockSize);
+  }
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::begin() noexcept
+{
+  return Iterator{*this, 0};
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::ConstIterator
+StableVector<T, Allocator>::begin() const noexcept
+{
+  return ConstIterator{*this, 0};
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::ConstIterator
+StableVector<T, Allocator>::cbegin() const noexcept
+{
+  return begin();
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::Iterator StableVector<T, Allocator>::end() noexcept
+{
+  return Iterator{*this, size_};
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::ConstIterator
+StableVector<T, Allocator>::end() const noexcept
+{
+  return ConstIterator{*this, size_};
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::ConstIterator
+StableVector<T, Allocator>::cend() const noexcept
+{
+  return end();
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::allocator_type&
+StableVector<T, Allocator>::allocator() noexcept
+{
+  return allocator_storage::get();
+}
+
+template <typename T, typename Allocator>
+inline const typename StableVector<T, Allocator>::allocator_type&
+StableVector<T, Allocator>::allocator() const noexcept
+{
+  return allocator_storage::get();
+}
+
+template <typename T, typename Allocator>
+inline typename StableVector<T, Allocator>::value_type*
+StableVector<T, Allocator>::element(size_type index) const noexcept
+{
+  const auto position = start_ + index;
+  return blocks_[position / BlockSize] + position % BlockSize;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+void StableVector<T, Allocator>::construct_at(size_type position, Args&&... args)
+{
+  const auto block = position / BlockSize;
+  const bool allocated = blocks_[block] == nullptr;
+  if (allocated)
+  {
+    blocks_[block] = allocate_block();
+  }
+
+  try
+  {
+    allocator_traits::construct(
+      allocator(), blocks_[block] + position % BlockSize, std::forward<Args>(args)...);
+  }
+  catch (...)
+  {
+    if (allocated)
+    {
+      release_block(block);
+    }
+    throw;
+  }
+}
+
+template <typename T, typename Allocator>
+typename StableVector<T, Allocator>::value_type* StableVector<T, Allocator>::allocate_block()
+{
+  if (spare_block_ != nullptr)
+  {
+    return std::exchange(spare_block_, nullptr);
+  }
+
+  return allocator_traits::allocate(allocator(), BlockSize);
+}
+
+template <typename T, typename Allocator>
+void StableVector<T, Allocator>::release_block(size_type block) noexcept
+{
+  auto* data = std::exchange(blocks_[block], nullptr);
+  if (spare_block_ == nullptr)
+  {
+    spare_block_ = data;
+  }
+  else
+  {
+    allocator_traits::deallocate(allocator(), data, BlockSize);
+  }
+}
+
+template <typename T, typename Allocator>
+void StableVector<T, Allocator>::make_room()
+{
+  // Only blocks holding elements are allocated, and they are contiguous in the table
+  const auto first_block = start_ / BlockSize;
+  const auto used_blocks = size_ == 0 ? 0 : (start_ + size_ - 1) / BlockSize - first_block + 1;
+
+  // Keep at least as many free slots as used ones, so the table is rebuilt only after the
+  // elements have grown (or drifted) by a block per slot it has
+  auto block_count = std::max<size_type>(8, block_count_);
+  while (block_count < 2 * (used_blocks + 1))
+  {
+    block_count *= 2;
+  }
+
+  block_allocator_type block_allocator{allocator()};
+  auto* blocks = block_allocator_traits::allocate(block_allocator, block_count);
+  std::uninitialized_fill_n(blocks, block_count, nullptr);
+
+  const auto new_first_block = (block_count - used_blocks) / 2;
+  if (used_blocks > 0)
+  {
+    std::copy_n(blocks_ + first_block, used_blocks, blocks + new_first_block);
+  }
+
+  if (blocks_ != nullptr)
+  {
+    block_allocator_traits::deallocate(block_allocator, blocks_, block_count_);
+  }
+  blocks_ = blocks;
+  block_count_ = block_count;
+  start_ = new_first_block * BlockSize + start_ % BlockSize;
+}
+
+template <typename T, typename Allocator>
+void StableVector<T, Allocator>::destroy_elements() noexcept
+{
+  if constexpr (!std::is_trivially_destructible_v<value_type>)
+  {
+    for (size_type index = 0; index < size_; ++index)
+    {
+      allocator_traits::destroy(allocator(), element(index));
+    }
+  }
+}
+
+template <typename T, typename Allocator>
+void StableVector<T, Allocator>::release_storage() noexcept
+{
+  for (size_type block = 0; block < block_count_; ++block)
+  {
+    if (blocks_[block] != nullptr)
+    {
+      allocator_traits::deallocate(allocator(), blocks_[block], BlockSize);
+    }
+  }
+
+  if (spare_block_ != nullptr)
+  {
+    allocator_traits::deallocate(allocator(), spare_block_, BlockSize);
+  }
+
+  if (blocks_ != nullptr)
+  {
+    block_allocator_type block_allocator{allocator()};
+    block_allocator_traits::deallocate(block_allocator, blocks_, block_count_);
+  }
+
+  blocks_ = nullptr;
+  block_count_ = 0;
+  spare_block_ = nullptr;
+  start_ = 0;
+  size_ = 0;
+}
+
+template <typename T, typename Allocator>
+void StableVector<T, Allocator>::steal(StableVector& other) noexcept
+{
+  blocks_ = std::exchange(other.blocks_, nullptr);
+  block_count_ = std::exchange(other.block_count_, 0);
+  spare_block_ = std::exchange(other.spare_block_, nullptr);
+  start_ = std::exchange(other.start_, 0);
+  size_ = std::exchange(other.size_, 0);
+}
+} // namespace CppTraining
@@ -3,25 +3,126 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdint>
-#include <functional>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
+#include "allocator_extensions.h"
 #include "default_growth_policy.h"
+#include "ebo_storage.h"
+#include "inline_storage.h"
 #include "literal_operators.h"
+#include "simd_algorithms.h"
+#include "trivially_relocatable.h"
 
 namespace CppTraining
 {
-template <typename T, typename Allocator = std::allocator<T>>
+template <typename T,
+          typename Allocator = std::allocator<T>,
+          typename GrowthPolicy = DefaultGrowthPolicy,
+          std::size_t InlineCapacity = 0>
 class Vector;
 
-template <typename T, typename Allocator>
-void swap(Vector<T, Allocator>& lhs, Vector<T, Allocator>& rhs) noexcept;
+class ThreadPool;
 
-template <typename T, typename Allocator>
-class Vector final
+namespace detail
+{
+/// @brief Moving or swapping vectors hands over allocated blocks without touching the elements,
+/// but inline elements have to be moved one at a time, which is only safe when those moves cannot
+/// throw.
+template <typename T, std::size_t InlineCapacity>
+inline constexpr bool nothrow_inline_moves_v =
+  InlineCapacity == 0 ||
+  (std::is_nothrow_move_constructible_v<T> && std::is_nothrow_swappable_v<T>);
+
+template <typename Iterator>
+using iterator_category_t = typename std::iterator_traits<Iterator>::iterator_category;
+
+/// @brief Keeps the iterator-range overloads out of overload resolution for other arguments, e.g.
+/// so that insert(position, 3, 5) on a Vector<int> inserts three fives.
+template <typename Iterator>
+using require_input_iterator_t =
+  std::enable_if_t<std::is_convertible_v<iterator_category_t<Iterator>, std::input_iterator_tag>>;
+
+template <typename Iterator>
+inline constexpr bool is_forward_iterator_v =
+  std::is_convertible_v<iterator_category_t<Iterator>, std::forward_iterator_tag>;
+
+template <typename Iterator>
+using iterator_value_t = typename std::iterator_traits<Iterator>::value_type;
+
+/// @brief std::vector<bool> packs its elements into bits, so its iterators must never match.
+template <typename Value>
+using unpacked_vector_t = std::vector<std::conditional_t<std::is_same_v<Value, bool>, char, Value>>;
+
+/// @brief Iterators known to walk an array, so that a range of them can be copied with memcpy.
+/// C++17 has no contiguous iterator category, so besides pointers this names the iterators of
+/// std::vector and std::string, the usual sources of parsed buffers.
+template <typename Iterator, typename = void>
+struct is_contiguous_iterator : std::is_pointer<Iterator>
+{
+};
+
+template <typename Iterator>
+struct is_contiguous_iterator<Iterator, std::void_t<iterator_value_t<Iterator>>>
+    : std::bool_constant<
+        std::is_pointer_v<Iterator> ||
+        std::is_same_v<Iterator,
+                       typename unpacked_vector_t<iterator_value_t<Iterator>>::iterator> ||
+        std::is_same_v<Iterator,
+                       typename unpacked_vector_t<iterator_value_t<Iterator>>::const_iterator> ||
+        std::is_same_v<Iterator, std::string::iterator> ||
+        std::is_same_v<Iterator, std::string::const_iterator>>
+{
+};
+
+template <typename Iterator>
+inline constexpr bool is_contiguous_iterator_v = is_contiguous_iterator<Iterator>::value;
+
+/// @brief Parallel resize() and reserve() hand each thread whole pages of this size, so that every
+/// page is first touched by one thread, in chunks of at least FirstTouchMinimumChunk bytes.
+inline constexpr std::size_t FirstTouchPageSize = 4096;
+inline constexpr std::size_t FirstTouchMinimumChunk = 64 * FirstTouchPageSize;
+inline constexpr std::size_t FirstTouchChunksPerWorker = 4;
+} // namespace detail
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void swap(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& lhs,
+          Vector<T, Allocator, GrowthPolicy, InlineCapacity>& rhs)
+  noexcept(detail::nothrow_inline_moves_v<T, InlineCapacity>);
+
+/// @brief Selects the Vector constructor that takes over an existing block instead of copying it.
+struct AdoptBuffer
+{
+  explicit AdoptBuffer() = default;
+};
+
+inline constexpr AdoptBuffer adopt_buffer{};
+
+/// @brief Selects the resize() and reserve() overloads that split their work across the threads
+/// of a ThreadPool.
+struct ParallelTag
+{
+  explicit ParallelTag() = default;
+};
+
+inline constexpr ParallelTag parallel_tag{};
+
+/// @brief The allocator and growth policy are stored as (private) base classes so that stateless
+/// ones take up no space: with the defaults, sizeof(Vector) is three pointers.
+///
+/// A non-zero InlineCapacity embeds room for that many elements in the Vector itself, and the
+/// allocator is only used once the elements outgrow it (see SmallVector in small_vector.h).
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+class CPP_TRAINING_EMPTY_BASES Vector final : private detail::EboStorage<Allocator, 0>,
+                                              private detail::EboStorage<GrowthPolicy, 1>,
+                                              private detail::InlineStorage<T, InlineCapacity>
 {
 public:
   using size_type = std::size_t;
@@ -33,8 +134,178 @@ public:
   using allocator_type = Allocator;
   using allocator_traits = std::allocator_traits<Allocator>;
 
-  using growth_policy_type = std::function<std::size_t(std::size_t, std::size_t)>;
+  using growth_policy_type = GrowthPolicy;
+
+  static constexpr size_type inline_capacity = InlineCapacity;
 
+#if defined(CPP_TRAINING_UNCHECKED_ITERATORS)
+  /// @brief Pointer-based iterators without validation. Selected at build time for hot loops where
+  /// the checked iterators' branches and bounds checks prevent inlining and auto-vectorization.
+  class Iterator final
+  {
+    friend Vector;
+
+  public:
+    using size_type = Vector::size_type;
+    using value_type = Vector::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using pointer = value_type*;
+    using iterator_category = std::random_access_iterator_tag;
+
+    Iterator() = default;
+    Iterator(const Iterator&) = default;
+    Iterator(Iterator&&) noexcept = default;
+    Iterator& operator=(const Iterator&) = default;
+    Iterator& operator=(Iterator&&) noexcept = default;
+    ~Iterator() = default;
+
+    reference operator*() const { return *current_; }
+    pointer operator->() const { return current_; }
+
+    bool operator==(Iterator rhs) const { return current_ == rhs.current_; }
+    bool operator!=(Iterator rhs) const { return current_ != rhs.current_; }
+    bool operator<(Iterator rhs) const { return current_ < rhs.current_; }
+    bool operator>(Iterator rhs) const { return current_ > rhs.current_; }
+
+    Iterator& operator++()
+    {
+      ++current_;
+      return *this;
+    }
+
+    Iterator operator++(int) { return Iterator{current_++}; }
+
+    Iterator& operator--()
+    {
+      --current_;
+      return *this;
+    }
+
+    Iterator operator--(int) { return Iterator{current_--}; }
+
+    difference_type operator-(Iterator rhs) const { return current_ - rhs.current_; }
+
+    Iterator& operator+=(difference_type offset)
+    {
+      current_ += offset;
+      return *this;
+    }
+
+    Iterator& operator-=(difference_type offset)
+    {
+      current_ -= offset;
+      return *this;
+    }
+
+    reference operator[](size_type index) const { return current_[index]; }
+
+    friend Iterator operator+(const Iterator& position, difference_type offset)
+    {
+      return Iterator{position.current_ + offset};
+    }
+
+    friend Iterator operator+(difference_type offset, const Iterator& position)
+    {
+      return position + offset;
+    }
+
+    friend Iterator operator-(const Iterator& position, difference_type offset)
+    {
+      return Iterator{position.current_ - offset};
+    }
+
+  private:
+    Iterator(Vector& owner, size_type index) : current_{owner.data_ + index} {}
+    explicit Iterator(pointer current) : current_{current} {}
+
+    pointer current_{nullptr};
+  };
+
+  class ConstIterator final
+  {
+    friend Vector;
+
+  public:
+    using size_type = Vector::size_type;
+    using value_type = Vector::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using iterator_category = std::random_access_iterator_tag;
+
+    ConstIterator() = default;
+    ConstIterator(const Iterator& other) : current_{other.current_} {}
+    ConstIterator(const ConstIterator&) = default;
+    ConstIterator(ConstIterator&&) noexcept = default;
+    ConstIterator& operator=(const ConstIterator&) = default;
+    ConstIterator& operator=(ConstIterator&&) noexcept = default;
+    ~ConstIterator() = default;
+
+    reference operator*() const { return *current_; }
+    pointer operator->() const { return current_; }
+
+    bool operator==(ConstIterator rhs) const { return current_ == rhs.current_; }
+    bool operator!=(ConstIterator rhs) const { return current_ != rhs.current_; }
+    bool operator<(ConstIterator rhs) const { return current_ < rhs.current_; }
+    bool operator>(ConstIterator rhs) const { return current_ > rhs.current_; }
+
+    ConstIterator& operator++()
+    {
+      ++current_;
+      return *this;
+    }
+
+    ConstIterator operator++(int) { return ConstIterator{current_++}; }
+
+    ConstIterator& operator--()
+    {
+      --current_;
+      return *this;
+    }
+
+    ConstIterator operator--(int) { return ConstIterator{current_--}; }
+
+    difference_type operator-(ConstIterator rhs) const { return current_ - rhs.current_; }
+
+    ConstIterator& operator+=(difference_type offset)
+    {
+      current_ += offset;
+      return *this;
+    }
+
+    ConstIterator& operator-=(difference_type offset)
+    {
+      current_ -= offset;
+      return *this;
+    }
+
+    reference operator[](size_type index) const { return current_[index]; }
+
+    friend ConstIterator operator+(const ConstIterator& position, difference_type offset)
+    {
+      return ConstIterator{position.current_ + offset};
+    }
+
+    friend ConstIterator operator+(difference_type offset, const ConstIterator& position)
+    {
+      return position + offset;
+    }
+
+    friend ConstIterator operator-(const ConstIterator& position, difference_type offset)
+    {
+      return ConstIterator{position.current_ - offset};
+    }
+
+  private:
+    ConstIterator(const Vector& owner, size_type index) : current_{owner.data_ + index} {}
+    explicit ConstIterator(pointer current) : current_{current} {}
+
+    pointer current_{nullptr};
+  };
+#else
+  /// @brief Validating iterators (the default). Every dereference is bounds-checked through at()
+  /// and every operation rejects unassociated or unrelated iterators.
   class Iterator final
   {
     friend Vector;
@@ -181,23 +452,48 @@ public:
     const Vector* container_{nullptr};
     size_type index_{0_z};
   };
-
-  static_assert(std::is_copy_constructible<T>::value,
-                "Vector<T> requires copy-constructible value type");
+#endif
 
   explicit Vector(size_type capacity = 0_z,
                   const allocator_type& allocator = allocator_type{},
-                  growth_policy_type growth_policy = DefaultGrowthPolicy{});
+                  growth_policy_type growth_policy = growth_policy_type{});
   Vector(std::initializer_list<value_type> values,
          const allocator_type& alloc = allocator_type(),
-         growth_policy_type growth_policy = DefaultGrowthPolicy{});
+         growth_policy_type growth_policy = growth_policy_type{});
+
+  /// @brief Allocates once for forward iterators, and copies with memcpy when the source is
+  /// contiguous and the elements are trivially copyable.
+  template <typename InputIterator, typename = detail::require_input_iterator_t<InputIterator>>
+  Vector(InputIterator first,
+         InputIterator last,
+         const allocator_type& allocator = allocator_type{},
+         growth_policy_type growth_policy = growth_policy_type{});
+  /// @brief Takes ownership of a block of capacity elements, allocated by an allocator equal to
+  /// allocator, whose first size elements are constructed. Nothing is copied: the vector destroys
+  /// the elements and deallocates the block when it is done with them. A null data must come with
+  /// a capacity of zero.
+  Vector(AdoptBuffer,
+         value_type* data,
+         size_type size,
+         size_type capacity,
+         const allocator_type& allocator = allocator_type{},
+         growth_policy_type growth_policy = growth_policy_type{}) noexcept;
   Vector(const Vector& other);
-  Vector(Vector&& other) noexcept;
+  Vector(Vector&& other) noexcept(detail::nothrow_inline_moves_v<T, InlineCapacity>);
+
+  /// @brief If copying an element throws, this vector is left empty.
   Vector& operator=(const Vector& other);
-  Vector& operator=(Vector&& other) noexcept;
+
+  /// @brief Cannot throw when the allocator moves with the storage (or all allocators are equal).
+  /// Otherwise the elements are moved into this vector's storage one at a time.
+  Vector& operator=(Vector&& other) noexcept(
+    (allocator_traits::propagate_on_container_move_assignment::value ||
+     allocator_traits::is_always_equal::value) &&
+    detail::nothrow_inline_moves_v<T, InlineCapacity>);
   ~Vector() noexcept;
 
-  friend void swap<>(Vector& lhs, Vector& rhs) noexcept;
+  friend void swap<>(Vector& lhs, Vector& rhs)
+    noexcept(detail::nothrow_inline_moves_v<T, InlineCapacity>);
 
   reference operator[](size_type index);
   const_reference operator[](size_type index) const;
@@ -213,18 +509,70 @@ public:
   reference at(size_type index);
   const_reference at(size_type index) const;
 
+  /// @brief The elements, contiguous in memory, for I/O and C APIs. With size(), this is what lets
+  /// gsl::span view a vector without copying: `gsl::span<const T> view = values;` converts
+  /// implicitly.
+  value_type* data() noexcept;
+  const value_type* data() const noexcept;
+
   void reserve(size_type capacity);
   void resize(size_type size);
+
+  /// @brief Like reserve(), then writes to every page of the storage past size() from the pool's
+  /// threads. This prefaults the pages up front, instead of on first use. On a NUMA machine each
+  /// page lands on the node of the thread that touched it, not all on the caller's node. The
+  /// default pool needs thread_pool.h to be included.
+  template <typename Pool = ThreadPool>
+  void reserve(size_type capacity, ParallelTag, Pool& pool = Pool::global());
+
+  /// @brief Like resize(), but the new elements are value-initialized by the pool's threads, each
+  /// taking a run of whole pages, so that they are also the first to touch them. The allocator's
+  /// construct() is called concurrently. If a construction throws, every new element is destroyed
+  /// and the first exception is rethrown; the vector keeps its old size, but possibly a larger
+  /// capacity. Shrinking is done serially.
+  template <typename Pool = ThreadPool>
+  void resize(size_type size, ParallelTag, Pool& pool = Pool::global());
   void clear();
   void shrink_to_fit();
 
+  /// @brief Replaces the elements. The storage is reused when it is large enough, and otherwise
+  /// released before the one new block is allocated, so the old elements are never relocated.
+  template <typename InputIterator, typename = detail::require_input_iterator_t<InputIterator>>
+  void assign(InputIterator first, InputIterator last);
+  void assign(size_type count, const_reference value);
+  void assign(std::initializer_list<value_type> values);
+
   template <typename... Args>
   Iterator emplace_back(Args&&... args);
 
+  /// @brief Appends count elements, each constructed from args, after growing at most once.
+  /// Returns an iterator to the first of them.
+  template <typename... Args>
+  Iterator emplace_back_n(size_type count, const Args&... args);
+
+  /// @brief Appends a copy of every element of range (anything std::begin() and std::end() accept)
+  /// after growing at most once.
+  template <typename Range>
+  void append_range(const Range& range);
+
   Iterator push_back(const_reference value);
   Iterator push_back(rvalue_reference value);
   void pop_back();
 
+  // Inserting reallocates at most once, and the elements after position are shifted with memmove
+  // when they are trivially relocatable
+  template <typename... Args>
+  Iterator emplace(ConstIterator position, Args&&... args);
+  Iterator insert(ConstIterator position, const_reference value);
+  Iterator insert(ConstIterator position, rvalue_reference value);
+  Iterator insert(ConstIterator position, size_type count, const_reference value);
+  template <typename InputIterator, typename = detail::require_input_iterator_t<InputIterator>>
+  Iterator insert(ConstIterator position, InputIterator first, InputIterator last);
+  Iterator insert(ConstIterator position, std::initializer_list<value_type> values);
+
+  Iterator erase(ConstIterator position);
+  Iterator erase(ConstIterator first, ConstIterator last);
+
   Iterator begin() noexcept;
   ConstIterator begin() const noexcept;
   ConstIterator cbegin() const noexcept;
@@ -233,12 +581,103 @@ public:
   ConstIterator cend() const noexcept;
 
 private:
+  using allocator_storage = detail::EboStorage<Allocator, 0>;
+  using growth_policy_storage = detail::EboStorage<GrowthPolicy, 1>;
+  using inline_storage = detail::InlineStorage<T, InlineCapacity>;
+  using allocator_extensions = allocator_extension_traits<Allocator>;
+
+  allocator_type& allocator() noexcept;
+  const allocator_type& allocator() const noexcept;
+  growth_policy_type& growth_policy() noexcept;
+  const growth_policy_type& growth_policy() const noexcept;
+
+  /// @brief Whether data_ points at a block from the allocator rather than the inline storage (or
+  /// nothing).
+  bool owns_block() const noexcept;
+
+  /// @brief Returns any allocated block and falls back to the inline storage. There must be no
+  /// live elements.
+  void release_storage() noexcept;
+
+  /// @brief Takes other's elements, stealing its block when it has one and relocating them out of
+  /// its inline storage when it does not. This vector must be empty and own no block.
+  void take_storage(Vector& other) noexcept(detail::nothrow_inline_moves_v<T, InlineCapacity>);
+
+  bool resize_in_place(size_type new_capacity);
+
+  /// @brief Moves count elements to uninitialized storage at destination and destroys the
+  /// originals. Elements whose move may throw are copied instead (when they can be), so that if a
+  /// copy fails the partial copies are destroyed and every original is left untouched.
+  void relocate(value_type* source, size_type count, value_type* destination);
+
+  /// @brief Copy-constructs count elements into this vector's empty storage, which must have room
+  /// for them. If a copy throws, the copies made so far are destroyed.
+  void copy_elements(const value_type* source, size_type count);
+  void destroy_elements(value_type* first, size_type count) noexcept;
+
+  /// @brief Appends the elements of [first, last), growing at most once for forward iterators: to
+  /// exactly the size needed when the vector is empty (as when it is constructed or assigned) and
+  /// as the growth policy says otherwise. If a copy throws, the elements appended so far are
+  /// destroyed.
+  template <typename InputIterator>
+  void append(InputIterator first, InputIterator last);
+
+  /// @brief Splits the slots [first, last) into chunks starting at page boundaries, several per
+  /// worker of the pool, and returns the boundaries: first, then the start of each chunk, then
+  /// last.
+  template <typename Pool>
+  std::vector<size_type> page_chunks(size_type first, size_type last, const Pool& pool) const;
+
+  /// @brief The capacity to grow to when at least min_capacity is needed.
+  size_type next_capacity(size_type min_capacity) const;
+  size_type index_of(ConstIterator position) const;
+
+  /// @brief Opens a gap of count elements at index and fills it by calling construct(slot, i) for
+  /// each new element i. If a construction throws, the vector is left as it was.
+  template <typename Construct>
+  Iterator insert_with(size_type index, size_type count, Construct construct);
+
+  /// @brief Relocates count elements from index from to index to within the storage. The ranges may
+  /// overlap. Only for elements that relocate without throwing.
+  void move_elements(size_type from, size_type to, size_type count) noexcept;
+
+  /// @brief Like relocate(), but leaves a gap of count uninitialized elements at index in the
+  /// destination.
+  void relocate_with_gap(value_type* destination, size_type index, size_type count);
+
   size_type size_{0_z};
-  size_type capacity_{0_z};
-  value_type* data_{nullptr};
-  allocator_type allocator_{};
-  growth_policy_type growth_policy_;
+  size_type capacity_{InlineCapacity};
+  value_type* data_{inline_storage::data()};
 };
+
+/// @brief Element-wise comparison. Vectors of integers or floating-point numbers are compared with
+/// the SIMD kernels in simd_algorithms.h.
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool operator==(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& lhs,
+                const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& rhs);
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool operator!=(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& lhs,
+                const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& rhs);
+
+/// @brief Erases every element for which predicate returns true, keeping the others in order.
+/// Returns the number erased.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename Predicate>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+erase_if(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values, Predicate predicate);
+
+/// @brief Erases every element equal to value. Returns the number erased.
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename U>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+erase(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values, const U& value);
 } // namespace CppTraining
 
 #include "vector.inl"
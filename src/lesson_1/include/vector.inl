@@ -2,14 +2,18 @@
 
 namespace CppTraining
 {
-template <typename T, typename Allocator>
-inline Vector<T, Allocator>::Iterator::Iterator(Vector& owner, size_type index)
+#if !defined(CPP_TRAINING_UNCHECKED_ITERATORS)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::Iterator(
+  Vector& owner,
+  size_type index)
     : container_(&owner), index_(index)
 {
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::Iterator::reference Vector<T, Allocator>::Iterator::operator*() const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator*() const
 {
   if (container_ == nullptr)
   {
@@ -19,8 +23,9 @@ typename Vector<T, Allocator>::Iterator::reference Vector<T, Allocator>::Iterato
   return container_->at(index_);
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::Iterator::pointer Vector<T, Allocator>::Iterator::operator->() const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::pointer
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator->() const
 {
   if (container_ == nullptr)
   {
@@ -30,20 +35,22 @@ typename Vector<T, Allocator>::Iterator::pointer Vector<T, Allocator>::Iterator:
   return &(container_->at(index_));
 }
 
-template <typename T, typename Allocator>
-inline bool Vector<T, Allocator>::Iterator::operator==(Iterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator==(
+  Iterator rhs) const
 {
   return !(operator!=(rhs));
 }
 
-template <typename T, typename Allocator>
-inline bool Vector<T, Allocator>::Iterator::operator!=(Iterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator!=(
+  Iterator rhs) const
 {
   return container_ != rhs.container_ || index_ != rhs.index_;
 }
 
-template <typename T, typename Allocator>
-bool Vector<T, Allocator>::Iterator::operator<(Iterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator<(Iterator rhs) const
 {
   if (container_ == nullptr)
   {
@@ -58,8 +65,8 @@ bool Vector<T, Allocator>::Iterator::operator<(Iterator rhs) const
   return index_ < rhs.index_;
 }
 
-template <typename T, typename Allocator>
-bool Vector<T, Allocator>::Iterator::operator>(Iterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator>(Iterator rhs) const
 {
   if (container_ == nullptr)
   {
@@ -74,8 +81,9 @@ bool Vector<T, Allocator>::Iterator::operator>(Iterator rhs) const
   return index_ > rhs.index_;
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::Iterator& Vector<T, Allocator>::Iterator::operator++()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator++()
 {
   if (container_ == nullptr)
   {
@@ -87,16 +95,18 @@ typename Vector<T, Allocator>::Iterator& Vector<T, Allocator>::Iterator::operato
   return *this;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::Iterator Vector<T, Allocator>::Iterator::operator++(int)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator++(int)
 {
   Iterator temp{*this};
   operator++();
   return temp;
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::Iterator& Vector<T, Allocator>::Iterator::operator--()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator--()
 {
   if (container_ == nullptr)
   {
@@ -111,17 +121,18 @@ typename Vector<T, Allocator>::Iterator& Vector<T, Allocator>::Iterator::operato
   return *this;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::Iterator Vector<T, Allocator>::Iterator::operator--(int)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator--(int)
 {
   Iterator temp = *this;
   operator--();
   return temp;
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::Iterator::difference_type
-Vector<T, Allocator>::Iterator::operator-(Iterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::difference_type
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator-(Iterator rhs) const
 {
   if (container_ != rhs.container_)
   {
@@ -136,9 +147,9 @@ Vector<T, Allocator>::Iterator::operator-(Iterator rhs) const
   return index_ - rhs.index_;
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::Iterator&
-Vector<T, Allocator>::Iterator::operator+=(difference_type offset)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator+=(difference_type offset)
 {
   if (container_ == nullptr)
   {
@@ -158,16 +169,16 @@ Vector<T, Allocator>::Iterator::operator+=(difference_type offset)
   return *this;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::Iterator&
-Vector<T, Allocator>::Iterator::operator-=(difference_type offset)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator-=(difference_type offset)
 {
   return *this += -offset;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::Iterator::reference
-Vector<T, Allocator>::Iterator::operator[](size_type index) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator::operator[](size_type index) const
 {
   if (container_ == nullptr)
   {
@@ -177,21 +188,24 @@ Vector<T, Allocator>::Iterator::operator[](size_type index) const
   return container_->operator[](index);
 }
 
-template <typename T, typename Allocator>
-inline Vector<T, Allocator>::ConstIterator::ConstIterator(const Iterator& other)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::ConstIterator(
+  const Iterator& other)
     : container_(other.container_), index_(other.index_)
 {
 }
 
-template <typename T, typename Allocator>
-inline Vector<T, Allocator>::ConstIterator::ConstIterator(const Vector& owner, size_type index)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::ConstIterator(
+  const Vector& owner,
+  size_type index)
     : container_(&owner), index_(index)
 {
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::ConstIterator::reference
-Vector<T, Allocator>::ConstIterator::operator*() const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator*() const
 {
   if (container_ == nullptr)
   {
@@ -201,9 +215,9 @@ Vector<T, Allocator>::ConstIterator::operator*() const
   return container_->at(index_);
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::ConstIterator::pointer
-Vector<T, Allocator>::ConstIterator::operator->() const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::pointer
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator->() const
 {
   if (container_ == nullptr)
   {
@@ -213,20 +227,23 @@ Vector<T, Allocator>::ConstIterator::operator->() const
   return &(container_->at(index_));
 }
 
-template <typename T, typename Allocator>
-inline bool Vector<T, Allocator>::ConstIterator::operator==(ConstIterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator==(
+  ConstIterator rhs) const
 {
   return !(operator!=(rhs));
 }
 
-template <typename T, typename Allocator>
-inline bool Vector<T, Allocator>::ConstIterator::operator!=(ConstIterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator!=(
+  ConstIterator rhs) const
 {
   return container_ != rhs.container_ || index_ != rhs.index_;
 }
 
-template <typename T, typename Allocator>
-bool Vector<T, Allocator>::ConstIterator::operator<(ConstIterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator<(
+  ConstIterator rhs) const
 {
   if (container_ == nullptr)
   {
@@ -241,8 +258,9 @@ bool Vector<T, Allocator>::ConstIterator::operator<(ConstIterator rhs) const
   return index_ < rhs.index_;
 }
 
-template <typename T, typename Allocator>
-bool Vector<T, Allocator>::ConstIterator::operator>(ConstIterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator>(
+  ConstIterator rhs) const
 {
   if (container_ == nullptr)
   {
@@ -257,8 +275,9 @@ bool Vector<T, Allocator>::ConstIterator::operator>(ConstIterator rhs) const
   return index_ > rhs.index_;
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::ConstIterator& Vector<T, Allocator>::ConstIterator::operator++()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator++()
 {
   if (container_ == nullptr)
   {
@@ -270,17 +289,18 @@ typename Vector<T, Allocator>::ConstIterator& Vector<T, Allocator>::ConstIterato
   return *this;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::ConstIterator
-Vector<T, Allocator>::ConstIterator::operator++(int)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator++(int)
 {
   ConstIterator temp{*this};
   operator++();
   return temp;
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::ConstIterator& Vector<T, Allocator>::ConstIterator::operator--()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator--()
 {
   if (container_ == nullptr)
   {
@@ -295,18 +315,19 @@ typename Vector<T, Allocator>::ConstIterator& Vector<T, Allocator>::ConstIterato
   return *this;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::ConstIterator
-Vector<T, Allocator>::ConstIterator::operator--(int)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator--(int)
 {
   ConstIterator temp = *this;
   operator--();
   return temp;
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::ConstIterator::difference_type
-Vector<T, Allocator>::ConstIterator::operator-(ConstIterator rhs) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::difference_type
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator-(
+  ConstIterator rhs) const
 {
   if (container_ != rhs.container_)
   {
@@ -321,9 +342,10 @@ Vector<T, Allocator>::ConstIterator::operator-(ConstIterator rhs) const
   return index_ - rhs.index_;
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::ConstIterator&
-Vector<T, Allocator>::ConstIterator::operator+=(difference_type offset)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator+=(
+  difference_type offset)
 {
   if (container_ == nullptr)
   {
@@ -343,16 +365,17 @@ Vector<T, Allocator>::ConstIterator::operator+=(difference_type offset)
   return *this;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::ConstIterator&
-Vector<T, Allocator>::ConstIterator::operator-=(difference_type offset)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator-=(
+  difference_type offset)
 {
   return *this += -offset;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::ConstIterator::reference
-Vector<T, Allocator>::ConstIterator::operator[](size_type index) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator::operator[](size_type index) const
 {
   if (container_ == nullptr)
   {
@@ -362,148 +385,207 @@ Vector<T, Allocator>::ConstIterator::operator[](size_type index) const
   return container_->operator[](index);
 }
 
-template <typename T, typename Allocator>
-void swap(Vector<T, Allocator>& lhs, Vector<T, Allocator>& rhs) noexcept
+#endif
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void swap(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& lhs,
+          Vector<T, Allocator, GrowthPolicy, InlineCapacity>& rhs)
+  noexcept(detail::nothrow_inline_moves_v<T, InlineCapacity>)
 {
   using std::swap;
   using allocator_traits = std::allocator_traits<Allocator>;
 
-  swap(lhs.size_, rhs.size_);
-  swap(lhs.capacity_, rhs.capacity_);
-  swap(lhs.data_, rhs.data_);
+  if (&lhs == &rhs)
+  {
+    return;
+  }
+
+  // Without inline storage there are no inline elements, and the other branches would only make
+  // GCC warn about relocating from a null data_
+  if (InlineCapacity == 0_z || (lhs.owns_block() && rhs.owns_block()))
+  {
+    swap(lhs.size_, rhs.size_);
+    swap(lhs.capacity_, rhs.capacity_);
+    swap(lhs.data_, rhs.data_);
+  }
+  else if (lhs.owns_block() || rhs.owns_block())
+  {
+    // The inline elements move into the other vector's (unused) inline storage, and the block
+    // changes hands
+    auto& inline_vector = lhs.owns_block() ? rhs : lhs;
+    auto& block_vector = lhs.owns_block() ? lhs : rhs;
+
+    inline_vector.relocate(
+      inline_vector.data_, inline_vector.size_, block_vector.inline_storage::data());
+
+    inline_vector.data_ = block_vector.data_;
+    inline_vector.capacity_ = block_vector.capacity_;
+    block_vector.data_ = block_vector.inline_storage::data();
+    block_vector.capacity_ = InlineCapacity;
+
+    swap(lhs.size_, rhs.size_);
+  }
+  else
+  {
+    // Both sets of elements are inline: swap the common prefix and relocate the rest
+    auto& shorter = lhs.size_ < rhs.size_ ? lhs : rhs;
+    auto& longer = lhs.size_ < rhs.size_ ? rhs : lhs;
+
+    for (std::size_t i = 0_z; i < shorter.size_; ++i)
+    {
+      swap(shorter.data_[i], longer.data_[i]);
+    }
+
+    longer.relocate(
+      longer.data_ + shorter.size_, longer.size_ - shorter.size_, shorter.data_ + shorter.size_);
+
+    swap(lhs.size_, rhs.size_);
+  }
+
+  swap(lhs.growth_policy(), rhs.growth_policy());
 
   if (allocator_traits::propagate_on_container_swap::value)
   {
-    swap(lhs.allocator_, rhs.allocator_);
+    swap(lhs.allocator(), rhs.allocator());
   }
 }
 
-template <typename T, typename Allocator>
-Vector<T, Allocator>::Vector(size_type capacity,
-                             const allocator_type& allocator,
-                             growth_policy_type growth_policy)
-    : allocator_{allocator}, growth_policy_{std::move(growth_policy)}
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Vector(size_type capacity,
+                                                           const allocator_type& allocator,
+                                                           growth_policy_type growth_policy)
+    : allocator_storage{allocator}, growth_policy_storage{std::move(growth_policy)}
 {
   reserve(capacity);
 }
 
-template <typename T, typename Allocator>
-Vector<T, Allocator>::Vector(std::initializer_list<value_type> values,
-                             const allocator_type& allocator,
-                             growth_policy_type growth_policy)
-    : Vector(values.size(), allocator, growth_policy)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Vector(std::initializer_list<value_type> values,
+                                                           const allocator_type& allocator,
+                                                           growth_policy_type growth_policy)
+    : Vector(values.begin(), values.end(), allocator, std::move(growth_policy))
 {
-  for (const auto& value : values)
-  {
-    emplace_back(value);
-  }
 }
 
-template <typename T, typename Allocator>
-Vector<T, Allocator>::Vector(const Vector& other)
-    : capacity_{other.capacity_}
-    , allocator_{allocator_traits::select_on_container_copy_construction(other.allocator_)}
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename InputIterator, typename>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Vector(InputIterator first,
+                                                           InputIterator last,
+                                                           const allocator_type& allocator,
+                                                           growth_policy_type growth_policy)
+    : Vector(0_z, allocator, std::move(growth_policy))
 {
-  if (capacity_ > 0_z)
-  {
-    data_ = allocator_traits::allocate(allocator_, capacity_);
+  append(first, last);
+}
 
-    size_type i = 0_z;
-    try
-    {
-      for (; i < other.size_; ++i)
-      {
-        allocator_traits::construct(allocator_, data_ + i, other.data_[i]);
-      }
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Vector(
+  AdoptBuffer,
+  value_type* data,
+  size_type size,
+  size_type capacity,
+  const allocator_type& allocator,
+  growth_policy_type growth_policy) noexcept
+    : allocator_storage{allocator}, growth_policy_storage{std::move(growth_policy)}
+{
+  assert(size <= capacity && (data != nullptr || capacity == 0_z));
 
-      size_ = other.size_;
-    }
-    catch (...)
-    {
-      for (size_type j = 0_z; j < i; ++j)
-      {
-        allocator_traits::destroy(allocator_, data_ + i);
-      }
+  if (data != nullptr)
+  {
+    data_ = data;
+    size_ = size;
+    capacity_ = capacity;
+  }
+}
 
-      allocator_traits::deallocate(allocator_, data_, capacity_);
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Vector(const Vector& other)
+    : allocator_storage{allocator_traits::select_on_container_copy_construction(other.allocator())}
+    , growth_policy_storage{other.growth_policy()}
+{
+  reserve(other.capacity_);
 
-      throw;
-    }
+  try
+  {
+    copy_elements(other.data_, other.size_);
+  }
+  catch (...)
+  {
+    release_storage();
+    throw;
   }
 }
 
-template <typename T, typename Allocator>
-Vector<T, Allocator>::Vector(Vector&& other) noexcept
-    : size_{other.size_}
-    , capacity_{other.capacity_}
-    , data_{other.data_}
-    , allocator_{std::move(other.allocator_)}
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Vector(Vector&& other)
+  noexcept(detail::nothrow_inline_moves_v<T, InlineCapacity>)
+    : allocator_storage{std::move(other.allocator())}
+    , growth_policy_storage{std::move(other.growth_policy())}
 {
-  other.size_ = 0_z;
-  other.capacity_ = 0_z;
-  other.data_ = nullptr;
+  take_storage(other);
 }
 
-template <typename T, typename Allocator>
-Vector<T, Allocator>& Vector<T, Allocator>::operator=(const Vector& other)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::operator=(const Vector& other)
 {
   if (this != &other)
   {
     if (allocator_traits::propagate_on_container_copy_assignment::value)
     {
-      if (allocator_ != other.allocator_)
+      if (allocator() != other.allocator())
       {
         clear();
         shrink_to_fit();
       }
-      allocator_ = other.allocator_;
+      allocator() = other.allocator();
     }
 
+    growth_policy() = other.growth_policy();
+
     // Manual copy assignment
     clear();
     reserve(other.capacity_);
-    for (size_type i = 0_z; i < other.size_; ++i)
-    {
-      allocator_traits::construct(allocator_, data_ + i, other.data_[i]);
-    }
-
-    size_ = other.size_;
+    copy_elements(other.data_, other.size_);
   }
 
   return *this;
 }
 
-template <typename T, typename Allocator>
-Vector<T, Allocator>& Vector<T, Allocator>::operator=(Vector&& other) noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::operator=(Vector&& other) noexcept(
+  (allocator_traits::propagate_on_container_move_assignment::value ||
+   allocator_traits::is_always_equal::value) &&
+  detail::nothrow_inline_moves_v<T, InlineCapacity>)
 {
   if (this != &other)
   {
+    growth_policy() = std::move(other.growth_policy());
+
     if (allocator_traits::propagate_on_container_move_assignment::value)
     {
       // Safe to steal storage and allocator
       clear();
       shrink_to_fit();
 
-      allocator_ = std::move(other.allocator_);
-      data_ = other.data_;
-      size_ = other.size_;
-      capacity_ = other.capacity_;
+      allocator() = std::move(other.allocator());
+      take_storage(other);
     }
     else
     {
       // Allocator is not propagated and we must use our own allocator
-      if (allocator_ != other.allocator_)
+      if (allocator() != other.allocator())
       {
         clear();
         shrink_to_fit();
 
+        // The elements move across, but other's block can only go back to other's allocator
         reserve(other.size_);
-        for (size_type i = 0_z; i < other.size_; ++i)
-        {
-          allocator_traits::construct(allocator_, data_ + i, std::move(other.data_[i]));
-        }
+        relocate(other.data_, other.size_, data_);
+        size_ = std::exchange(other.size_, 0_z);
 
-        size_ = other.size_;
+        other.release_storage();
       }
       else
       {
@@ -511,36 +593,31 @@ Vector<T, Allocator>& Vector<T, Allocator>::operator=(Vector&& other) noexcept
         clear();
         shrink_to_fit();
 
-        data_ = other.data_;
-        size_ = other.size_;
-        capacity_ = other.capacity_;
+        take_storage(other);
       }
     }
-
-    other.data_ = nullptr;
-    other.size_ = 0_z;
-    other.capacity_ = 0_z;
   }
 
   return *this;
 }
 
-template <typename T, typename Allocator>
-Vector<T, Allocator>::~Vector() noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::~Vector() noexcept
 {
   for (size_type i = 0_z; i < size_; ++i)
   {
-    allocator_traits::destroy(allocator_, data_ + i);
+    allocator_traits::destroy(allocator(), data_ + i);
   }
 
-  if (data_ != nullptr)
+  if (owns_block())
   {
-    allocator_traits::deallocate(allocator_, data_, capacity_);
+    allocator_traits::deallocate(allocator(), data_, capacity_);
   }
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::reference Vector<T, Allocator>::operator[](size_type index)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::operator[](size_type index)
 {
   if (index >= size_)
   {
@@ -550,9 +627,9 @@ typename Vector<T, Allocator>::reference Vector<T, Allocator>::operator[](size_t
   return data_[index];
 }
 
-template <typename T, typename Allocator>
-typename Vector<T, Allocator>::const_reference
-Vector<T, Allocator>::operator[](size_type index) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::const_reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::operator[](size_type index) const
 {
   if (index >= size_)
   {
@@ -562,111 +639,143 @@ Vector<T, Allocator>::operator[](size_type index) const
   return data_[index];
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::size_type Vector<T, Allocator>::size() const noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size() const noexcept
 {
   return size_;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::size_type Vector<T, Allocator>::capacity() const noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::capacity() const noexcept
 {
   return capacity_;
 }
 
-template <typename T, typename Allocator>
-inline bool Vector<T, Allocator>::empty() const noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::empty() const noexcept
 {
   return size_ == 0_z;
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::reference Vector<T, Allocator>::front()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::front()
 {
   return operator[](0_z);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::const_reference Vector<T, Allocator>::front() const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::const_reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::front() const
 {
   return operator[](0_z);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::reference Vector<T, Allocator>::back()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::back()
 {
   return operator[](size_ - 1_z);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::const_reference Vector<T, Allocator>::back() const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::const_reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::back() const
 {
   return operator[](size_ - 1_z);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::reference Vector<T, Allocator>::at(size_type index)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::at(size_type index)
 {
   return operator[](index);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::const_reference
-Vector<T, Allocator>::at(size_type index) const
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::const_reference
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::at(size_type index) const
 {
   return operator[](index);
 }
 
-template <typename T, typename Allocator>
-void Vector<T, Allocator>::reserve(size_type new_capacity)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::value_type*
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::data() noexcept
+{
+  return data_;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline const typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::value_type*
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::data() const noexcept
+{
+  return data_;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::reserve(size_type new_capacity)
 {
   if (new_capacity > capacity_)
   {
-    // Allocate raw memory with the allocator
-    auto new_data = allocator_traits::allocate(allocator_, new_capacity);
+    const size_type old_capacity = capacity_;
 
-    for (size_type i = 0_z; i < size_; ++i)
+    if (!resize_in_place(new_capacity))
     {
-      allocator_traits::construct(allocator_, new_data + i, std::move(data_[i]));
-      allocator_traits::destroy(allocator_, data_ + i);
-    }
+      // Allocate raw memory with the allocator
+      auto new_data = allocator_traits::allocate(allocator(), new_capacity);
 
-    if (data_)
-    {
-      allocator_traits::deallocate(allocator_, data_, capacity_);
+      try
+      {
+        relocate(data_, size_, new_data);
+      }
+      catch (...)
+      {
+        allocator_traits::deallocate(allocator(), new_data, new_capacity);
+        throw;
+      }
+
+      release_storage();
+
+      data_ = new_data;
+      capacity_ = new_capacity;
     }
 
-    data_ = new_data;
-    capacity_ = new_capacity;
+    allocator_extensions::on_growth(allocator(), size_, old_capacity, capacity_);
   }
 }
 
-template <typename T, typename Allocator>
-void Vector<T, Allocator>::resize(size_type new_size)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::resize(size_type new_size)
 {
   if (new_size < size_)
   {
-    for (size_type i = new_size; i < size_; ++i)
-    {
-      allocator_traits::destroy(allocator_, data_ + i);
-    }
-
+    destroy_elements(data_ + new_size, size_ - new_size);
     size_ = new_size;
 
     if (new_size == 0)
     {
-      allocator_traits::deallocate(allocator_, data_, capacity_);
-      data_ = nullptr;
-      capacity_ = 0;
+      release_storage();
     }
   }
   else if (new_size > size_)
   {
     reserve(new_size);
 
-    for (size_type i = size_; i < new_size; ++i)
+    size_type i = size_;
+    try
+    {
+      for (; i < new_size; ++i)
+      {
+        allocator_traits::construct(allocator(), data_ + i);
+      }
+    }
+    catch (...)
     {
-      allocator_traits::construct(allocator_, data_ + i);
+      destroy_elements(data_ + size_, i - size_);
+      throw;
     }
 
     size_ = new_size;
@@ -675,8 +784,99 @@ void Vector<T, Allocator>::resize(size_type new_size)
   assert(capacity_ >= size_);
 }
 
-template <typename T, typename Allocator>
-void Vector<T, Allocator>::clear()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename Pool>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::reserve(size_type new_capacity,
+                                                                 ParallelTag,
+                                                                 Pool& pool)
+{
+  reserve(new_capacity);
+
+  const auto bounds = page_chunks(size_, capacity_, pool);
+  pool.parallel_for(
+    0,
+    bounds.size() - 1,
+    [this, &bounds](std::size_t chunk) {
+      // One byte per page is enough to fault it in. The bytes written are free storage, and each
+      // chunk writes only within its own slots.
+      const auto first = reinterpret_cast<std::uintptr_t>(data_ + bounds[chunk]);
+      const auto last = reinterpret_cast<std::uintptr_t>(data_ + bounds[chunk + 1]);
+      auto page = first;
+      while (page < last)
+      {
+        *reinterpret_cast<volatile unsigned char*>(page) = 0;
+        page = (page + detail::FirstTouchPageSize) & ~(detail::FirstTouchPageSize - 1);
+      }
+    },
+    1);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename Pool>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::resize(size_type new_size,
+                                                                ParallelTag,
+                                                                Pool& pool)
+{
+  if (new_size <= size_)
+  {
+    resize(new_size);
+    return;
+  }
+
+  reserve(new_size);
+
+  const auto bounds = page_chunks(size_, new_size, pool);
+  const auto chunks = bounds.size() - 1;
+  if (chunks == 1)
+  {
+    resize(new_size);
+    return;
+  }
+
+  // Set by each chunk once all its elements are constructed; a char per chunk, as the chunks
+  // finish on different threads
+  std::vector<char> constructed(chunks, 0);
+  try
+  {
+    pool.parallel_for(
+      0,
+      chunks,
+      [this, &bounds, &constructed](std::size_t chunk) {
+        auto i = bounds[chunk];
+        try
+        {
+          for (; i < bounds[chunk + 1]; ++i)
+          {
+            allocator_traits::construct(allocator(), data_ + i);
+          }
+        }
+        catch (...)
+        {
+          destroy_elements(data_ + bounds[chunk], i - bounds[chunk]);
+          throw;
+        }
+        constructed[chunk] = 1;
+      },
+      1);
+  }
+  catch (...)
+  {
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+      if (constructed[chunk] != 0)
+      {
+        destroy_elements(data_ + bounds[chunk], bounds[chunk + 1] - bounds[chunk]);
+      }
+    }
+    throw;
+  }
+
+  size_ = new_size;
+  assert(capacity_ >= size_);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::clear()
 {
   for (size_type i = 0_z; i < size_; ++i)
   {
@@ -686,64 +886,613 @@ void Vector<T, Allocator>::clear()
   size_ = 0_z;
 }
 
-template <typename T, typename Allocator>
-void Vector<T, Allocator>::shrink_to_fit()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::shrink_to_fit()
 {
   if (size_ == 0)
   {
-    if (data_)
-    {
-      allocator_traits::deallocate(allocator_, data_, capacity_);
-    }
-    data_ = nullptr;
-    capacity_ = 0_z;
+    release_storage();
   }
-  else if (size_ != capacity_)
+  else if (size_ != capacity_ && owns_block())
   {
-    auto new_data = allocator_traits::allocate(allocator_, size_);
+    if (size_ <= InlineCapacity)
+    {
+      // Move back into the inline storage
+      auto old_data = data_;
+      relocate(old_data, size_, inline_storage::data());
+      allocator_traits::deallocate(allocator(), old_data, capacity_);
+
+      data_ = inline_storage::data();
+      capacity_ = InlineCapacity;
+      return;
+    }
 
-    for (size_type i = 0; i < size_; ++i)
+    if (resize_in_place(size_))
     {
-      allocator_traits::construct(allocator_, new_data + i, std::move(data_[i]));
-      allocator_traits::destroy(allocator_, data_ + i);
+      return;
     }
 
-    allocator_traits::deallocate(allocator_, data_, capacity_);
+    auto new_data = allocator_traits::allocate(allocator(), size_);
+
+    try
+    {
+      relocate(data_, size_, new_data);
+    }
+    catch (...)
+    {
+      allocator_traits::deallocate(allocator(), new_data, size_);
+      throw;
+    }
+
+    allocator_traits::deallocate(allocator(), data_, capacity_);
     data_ = new_data;
     capacity_ = size_;
   }
 }
 
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::allocator_type&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::allocator() noexcept
+{
+  return allocator_storage::get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline const typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::allocator_type&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::allocator() const noexcept
+{
+  return allocator_storage::get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::growth_policy_type&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::growth_policy() noexcept
+{
+  return growth_policy_storage::get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline const typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::growth_policy_type&
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::growth_policy() const noexcept
+{
+  return growth_policy_storage::get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::owns_block() const noexcept
+{
+  // Without inline storage this is simply a null check
+  return data_ != inline_storage::data();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::release_storage() noexcept
+{
+  if (owns_block())
+  {
+    allocator_traits::deallocate(allocator(), data_, capacity_);
+  }
+
+  data_ = inline_storage::data();
+  capacity_ = InlineCapacity;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::take_storage(Vector& other)
+  noexcept(detail::nothrow_inline_moves_v<T, InlineCapacity>)
+{
+  if (other.owns_block())
+  {
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+  }
+  else if constexpr (InlineCapacity > 0)
+  {
+    // Without inline storage a vector that owns no block is empty. Compiling the relocation anyway
+    // makes GCC warn about the null data_ at -O2 and above.
+    relocate(other.data_, other.size_, data_);
+  }
+
+  size_ = other.size_;
+
+  other.data_ = other.inline_storage::data();
+  other.size_ = 0_z;
+  other.capacity_ = InlineCapacity;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool Vector<T, Allocator, GrowthPolicy, InlineCapacity>::resize_in_place(size_type new_capacity)
+{
+  if (!owns_block())
+  {
+    return false;
+  }
+
+  if constexpr (allocator_extensions::has_reallocate && is_trivially_relocatable_v<value_type>)
+  {
+    // The allocator may move the block (e.g. realloc/mremap); the elements travel with the bytes
+    data_ = allocator_extensions::reallocate(allocator(), data_, capacity_, new_capacity);
+    capacity_ = new_capacity;
+    return true;
+  }
+  else if (allocator_extensions::expand_in_place(allocator(), data_, capacity_, new_capacity))
+  {
+    capacity_ = new_capacity;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::relocate(value_type* source,
+                                                                  size_type count,
+                                                                  value_type* destination)
+{
+  if constexpr (is_trivially_relocatable_v<value_type>)
+  {
+    // One bulk copy; the source objects are abandoned without running their destructors
+    if (count > 0_z)
+    {
+      std::memcpy(static_cast<void*>(destination),
+                  static_cast<const void*>(source),
+                  count * sizeof(value_type));
+    }
+  }
+  else if constexpr (std::is_nothrow_move_constructible_v<value_type> ||
+                     !std::is_copy_constructible_v<value_type>)
+  {
+    // Nothing to roll back to: a throwing move of a move-only type leaves the source moved-from
+    for (size_type i = 0_z; i < count; ++i)
+    {
+      allocator_traits::construct(allocator(), destination + i, std::move(source[i]));
+      allocator_traits::destroy(allocator(), source + i);
+    }
+  }
+  else
+  {
+    // Copy everything first, so that the originals survive a failed copy
+    size_type i = 0_z;
+    try
+    {
+      for (; i < count; ++i)
+      {
+        allocator_traits::construct(allocator(), destination + i, std::as_const(source[i]));
+      }
+    }
+    catch (...)
+    {
+      destroy_elements(destination, i);
+      throw;
+    }
+
+    destroy_elements(source, count);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::copy_elements(const value_type* source,
+                                                                       size_type count)
+{
+  assert(size_ == 0_z && capacity_ >= count);
+
+  size_type i = 0_z;
+  try
+  {
+    for (; i < count; ++i)
+    {
+      allocator_traits::construct(allocator(), data_ + i, source[i]);
+    }
+  }
+  catch (...)
+  {
+    destroy_elements(data_, i);
+    throw;
+  }
+
+  size_ = count;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::destroy_elements(value_type* first,
+                                                                          size_type count) noexcept
+{
+  for (size_type i = 0_z; i < count; ++i)
+  {
+    allocator_traits::destroy(allocator(), first + i);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename InputIterator>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::append(InputIterator first,
+                                                                InputIterator last)
+{
+  if constexpr (detail::is_forward_iterator_v<InputIterator>)
+  {
+    const auto count = static_cast<size_type>(std::distance(first, last));
+    if (size_ + count > capacity_)
+    {
+      reserve(size_ == 0_z ? count : next_capacity(size_ + count));
+    }
+
+    if constexpr (detail::is_contiguous_iterator_v<InputIterator> &&
+                  std::is_same_v<detail::iterator_value_t<InputIterator>, value_type> &&
+                  std::is_trivially_copyable_v<value_type>)
+    {
+      if (count != 0_z)
+      {
+        std::memcpy(data_ + size_, std::addressof(*first), count * sizeof(value_type));
+      }
+    }
+    else
+    {
+      size_type i = 0_z;
+      try
+      {
+        for (; i < count; ++i, ++first)
+        {
+          allocator_traits::construct(allocator(), data_ + size_ + i, *first);
+        }
+      }
+      catch (...)
+      {
+        destroy_elements(data_ + size_, i);
+        throw;
+      }
+    }
+
+    size_ += count;
+  }
+  else
+  {
+    const size_type old_size = size_;
+    try
+    {
+      for (; first != last; ++first)
+      {
+        emplace_back(*first);
+      }
+    }
+    catch (...)
+    {
+      destroy_elements(data_ + old_size, size_ - old_size);
+      size_ = old_size;
+      throw;
+    }
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename Pool>
+std::vector<typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type>
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::page_chunks(size_type first,
+                                                               size_type last,
+                                                               const Pool& pool) const
+{
+  constexpr auto PageSize = detail::FirstTouchPageSize;
+
+  // Chunks are measured from the start of the page holding the first slot, so that all but the
+  // first begin on a page boundary
+  const auto begin = reinterpret_cast<std::uintptr_t>(data_ + first);
+  const auto page_start = begin & ~(PageSize - 1);
+  const auto bytes = reinterpret_cast<std::uintptr_t>(data_ + last) - page_start;
+  const auto workers = std::max<std::size_t>(pool.worker_count(), 1);
+  const auto target = std::max(bytes / (workers * detail::FirstTouchChunksPerWorker),
+                               detail::FirstTouchMinimumChunk);
+  const auto chunk_bytes = (target + PageSize - 1) / PageSize * PageSize;
+  const auto chunks = std::max<std::size_t>((bytes + chunk_bytes - 1) / chunk_bytes, 1);
+
+  // A slot belongs to the chunk its first byte is in
+  std::vector<size_type> bounds(chunks + 1, last);
+  bounds[0] = first;
+  for (std::size_t chunk = 1; chunk < chunks; ++chunk)
+  {
+    const auto offset = page_start + chunk * chunk_bytes - begin;
+    bounds[chunk] = std::min(last, first + (offset + sizeof(T) - 1) / sizeof(T));
+  }
+
+  return bounds;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::next_capacity(size_type min_capacity) const
+{
+  return std::max(min_capacity, capacity_ + std::max(1_z, growth_policy()(size_, capacity_)));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::index_of(ConstIterator position) const
+{
+#if defined(CPP_TRAINING_UNCHECKED_ITERATORS)
+  return static_cast<size_type>(position.current_ - data_);
+#else
+  if (position.container_ == nullptr)
+  {
+    throw std::runtime_error("Unassociated iterator.");
+  }
+
+  if (position.container_ != this)
+  {
+    throw std::runtime_error("Unrelated iterators.");
+  }
+
+  if (position.index_ > size_)
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  return position.index_;
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename Construct>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::insert_with(size_type index,
+                                                                size_type count,
+                                                                Construct construct)
+{
+  if (count == 0_z)
+  {
+    return {*this, index};
+  }
+
+  if (index == size_ && size_ + count <= capacity_)
+  {
+    // Appending: nothing has to shift
+    size_type i = 0_z;
+    try
+    {
+      for (; i < count; ++i)
+      {
+        construct(data_ + index + i, i);
+      }
+    }
+    catch (...)
+    {
+      destroy_elements(data_ + index, i);
+      throw;
+    }
+
+    size_ += count;
+    return {*this, index};
+  }
+
+  if constexpr (is_trivially_relocatable_v<value_type> ||
+                std::is_nothrow_move_constructible_v<value_type>)
+  {
+    if (size_ + count <= capacity_)
+    {
+      // Shift the tail up (one memmove for trivially relocatable elements) and fill the gap
+      move_elements(index, index + count, size_ - index);
+
+      size_type i = 0_z;
+      try
+      {
+        for (; i < count; ++i)
+        {
+          construct(data_ + index + i, i);
+        }
+      }
+      catch (...)
+      {
+        destroy_elements(data_ + index, i);
+        move_elements(index + count, index, size_ - index);
+        throw;
+      }
+
+      size_ += count;
+      return {*this, index};
+    }
+  }
+
+  // Build the result in a new block. The new elements are constructed first, while anything they
+  // refer to is still in place, and a shift that might throw never happens in place.
+  const size_type old_capacity = capacity_;
+  const size_type new_capacity =
+    size_ + count <= capacity_ ? capacity_ : next_capacity(size_ + count);
+  auto new_data = allocator_traits::allocate(allocator(), new_capacity);
+
+  size_type i = 0_z;
+  try
+  {
+    for (; i < count; ++i)
+    {
+      construct(new_data + index + i, i);
+    }
+
+    relocate_with_gap(new_data, index, count);
+  }
+  catch (...)
+  {
+    destroy_elements(new_data + index, i);
+    allocator_traits::deallocate(allocator(), new_data, new_capacity);
+    throw;
+  }
+
+  release_storage();
+
+  data_ = new_data;
+  capacity_ = new_capacity;
+  size_ += count;
+
+  if (new_capacity > old_capacity)
+  {
+    allocator_extensions::on_growth(allocator(), size_ - count, old_capacity, new_capacity);
+  }
+
+  return {*this, index};
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::move_elements(size_type from,
+                                                                       size_type to,
+                                                                       size_type count) noexcept
+{
+  if (count == 0_z || from == to)
+  {
+    return;
+  }
+
+  if constexpr (is_trivially_relocatable_v<value_type>)
+  {
+    std::memmove(static_cast<void*>(data_ + to),
+                 static_cast<const void*>(data_ + from),
+                 count * sizeof(value_type));
+  }
+  else
+  {
+    static_assert(std::is_nothrow_move_constructible_v<value_type>,
+                  "move_elements() needs elements that relocate without throwing");
+
+    // Walk away from the destination so that no element is overwritten before it has moved
+    for (size_type n = 0_z; n < count; ++n)
+    {
+      const size_type i = to > from ? count - 1_z - n : n;
+      allocator_traits::construct(allocator(), data_ + to + i, std::move(data_[from + i]));
+      allocator_traits::destroy(allocator(), data_ + from + i);
+    }
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::relocate_with_gap(value_type* destination,
+                                                                           size_type index,
+                                                                           size_type count)
+{
+  if constexpr (is_trivially_relocatable_v<value_type> ||
+                std::is_nothrow_move_constructible_v<value_type> ||
+                !std::is_copy_constructible_v<value_type>)
+  {
+    relocate(data_, index, destination);
+    relocate(data_ + index, size_ - index, destination + index + count);
+  }
+  else
+  {
+    // Copy both sides of the gap before destroying anything, so that a failed copy can be undone
+    auto target = [destination, index, count](size_type i) {
+      return destination + (i < index ? i : i + count);
+    };
+
+    size_type i = 0_z;
+    try
+    {
+      for (; i < size_; ++i)
+      {
+        allocator_traits::construct(allocator(), target(i), std::as_const(data_[i]));
+      }
+    }
+    catch (...)
+    {
+      for (size_type j = 0_z; j < i; ++j)
+      {
+        allocator_traits::destroy(allocator(), target(j));
+      }
+      throw;
+    }
+
+    destroy_elements(data_, size_);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename InputIterator, typename>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::assign(InputIterator first,
+                                                                InputIterator last)
+{
+  clear();
+
+  if constexpr (detail::is_forward_iterator_v<InputIterator>)
+  {
+    if (static_cast<size_type>(std::distance(first, last)) > capacity_)
+    {
+      // Let append() allocate exactly what is needed, without keeping the old block alive
+      release_storage();
+    }
+  }
+
+  append(first, last);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::assign(size_type count,
+                                                                const_reference value)
+{
+  // value may be one of the elements about to be destroyed
+  const value_type copy(value);
+  clear();
+
+  if (count > capacity_)
+  {
+    release_storage();
+    reserve(count);
+  }
+
+  emplace_back_n(count, copy);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline void
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::assign(std::initializer_list<value_type> values)
+{
+  assign(values.begin(), values.end());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
 template <typename... Args>
-typename Vector<T, Allocator>::Iterator Vector<T, Allocator>::emplace_back(Args&&... args)
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::emplace_back(Args&&... args)
 {
   if (size_ == capacity_)
   {
-    std::size_t capacity = capacity_ + std::max(1_z, growth_policy_(size_, capacity_));
-    reserve(capacity);
+    reserve(next_capacity(size_ + 1_z));
   }
 
-  allocator_traits::construct(allocator_, data_ + size_, std::forward<Args>(args)...);
+  allocator_traits::construct(allocator(), data_ + size_, std::forward<Args>(args)...);
   return {*this, size_++};
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::Iterator
-Vector<T, Allocator>::push_back(const_reference value)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename... Args>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::emplace_back_n(size_type count,
+                                                                   const Args&... args)
+{
+  // insert_with() builds the new elements before relocating the old ones, so args may refer to
+  // elements of this vector
+  return insert_with(size_, count, [this, &args...](value_type* slot, size_type) {
+    allocator_traits::construct(allocator(), slot, args...);
+  });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename Range>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::append_range(const Range& range)
+{
+  using std::begin;
+  using std::end;
+  append(begin(range), end(range));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::push_back(const_reference value)
 {
   return emplace_back(value);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::Iterator
-Vector<T, Allocator>::push_back(rvalue_reference value)
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::push_back(rvalue_reference value)
 {
   return emplace_back(std::move(value));
 }
 
-template <typename T, typename Allocator>
-void Vector<T, Allocator>::pop_back()
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void Vector<T, Allocator, GrowthPolicy, InlineCapacity>::pop_back()
 {
   if (size_ > 0)
   {
@@ -751,39 +1500,232 @@ void Vector<T, Allocator>::pop_back()
   }
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::Iterator Vector<T, Allocator>::begin() noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename... Args>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::emplace(ConstIterator position, Args&&... args)
+{
+  const size_type index = index_of(position);
+
+  // The arguments may refer to elements that are about to shift or be relocated, so build the
+  // element first, even at the end
+  value_type value(std::forward<Args>(args)...);
+  return insert_with(index, 1_z, [this, &value](value_type* slot, size_type) {
+    allocator_traits::construct(allocator(), slot, std::move(value));
+  });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::insert(ConstIterator position,
+                                                           const_reference value)
+{
+  return emplace(position, value);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::insert(ConstIterator position,
+                                                           rvalue_reference value)
+{
+  return emplace(position, std::move(value));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::insert(ConstIterator position,
+                                                           size_type count,
+                                                           const_reference value)
+{
+  const size_type index = index_of(position);
+  if (count == 0_z)
+  {
+    return {*this, index};
+  }
+
+  // value may be one of the elements that are about to shift
+  const value_type copy(value);
+  return insert_with(index, count, [this, &copy](value_type* slot, size_type) {
+    allocator_traits::construct(allocator(), slot, copy);
+  });
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+template <typename InputIterator, typename>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::insert(ConstIterator position,
+                                                           InputIterator first,
+                                                           InputIterator last)
+{
+  const size_type index = index_of(position);
+
+  if constexpr (detail::is_forward_iterator_v<InputIterator>)
+  {
+    const auto count = static_cast<size_type>(std::distance(first, last));
+    return insert_with(index, count, [this, &first](value_type* slot, size_type) {
+      allocator_traits::construct(allocator(), slot, *first);
+      ++first;
+    });
+  }
+  else
+  {
+    // A single pass cannot tell how many elements are coming, so gather them first
+    Vector values(0_z, allocator());
+    for (; first != last; ++first)
+    {
+      values.emplace_back(*first);
+    }
+
+    return insert_with(index, values.size_, [this, &values](value_type* slot, size_type i) {
+      allocator_traits::construct(allocator(), slot, std::move(values.data_[i]));
+    });
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::insert(ConstIterator position,
+                                                           std::initializer_list<value_type> values)
+{
+  return insert(position, values.begin(), values.end());
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::erase(ConstIterator position)
+{
+  const size_type index = index_of(position);
+  if (index == size_)
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  return erase(position, ConstIterator{*this, index + 1_z});
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::erase(ConstIterator first, ConstIterator last)
+{
+  const size_type index = index_of(first);
+  const size_type end = index_of(last);
+  if (end < index)
+  {
+    throw std::out_of_range("Index out of range.");
+  }
+
+  const size_type count = end - index;
+  if (count == 0_z)
+  {
+    return {*this, index};
+  }
+
+  if constexpr (is_trivially_relocatable_v<value_type>)
+  {
+    // The erased elements are destroyed and the tail slides down in one memmove
+    destroy_elements(data_ + index, count);
+    move_elements(end, index, size_ - end);
+  }
+  else
+  {
+    std::move(data_ + end, data_ + size_, data_ + index);
+    destroy_elements(data_ + size_ - count, count);
+  }
+
+  size_ -= count;
+  return {*this, index};
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::begin() noexcept
 {
   return Iterator(*this, 0);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::ConstIterator Vector<T, Allocator>::begin() const noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::begin() const noexcept
 {
   return ConstIterator(*this, 0);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::ConstIterator Vector<T, Allocator>::cbegin() const noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::cbegin() const noexcept
 {
   return ConstIterator(*this, 0);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::Iterator Vector<T, Allocator>::end() noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::end() noexcept
 {
   return Iterator(*this, size_);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::ConstIterator Vector<T, Allocator>::end() const noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::end() const noexcept
 {
   return ConstIterator(*this, size_);
 }
 
-template <typename T, typename Allocator>
-inline typename Vector<T, Allocator>::ConstIterator Vector<T, Allocator>::cend() const noexcept
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+Vector<T, Allocator, GrowthPolicy, InlineCapacity>::cend() const noexcept
 {
   return ConstIterator(*this, size_);
 }
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool operator==(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& lhs,
+                const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& rhs)
+{
+  if (lhs.size() != rhs.size())
+  {
+    return false;
+  }
+
+  if constexpr (simd::is_supported_v<T>)
+  {
+    return simd::equal(lhs.data(), rhs.data(), lhs.size());
+  }
+  else
+  {
+    return std::equal(lhs.data(), lhs.data() + lhs.size(), rhs.data());
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+inline bool operator!=(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& lhs,
+                       const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename Predicate>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+erase_if(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values, Predicate predicate)
+{
+  const auto first = std::remove_if(values.begin(), values.end(), std::move(predicate));
+  const auto count = static_cast<std::size_t>(values.end() - first);
+  values.erase(first, values.end());
+  return count;
+}
+
+template <typename T,
+          typename Allocator,
+          typename GrowthPolicy,
+          std::size_t InlineCapacity,
+          typename U>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+erase(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values, const U& value)
+{
+  return erase_if(values, [&value](const T& element) { return element == value; });
+}
 } // namespace CppTraining
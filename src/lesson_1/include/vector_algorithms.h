@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+#include "simd_algorithms.h"
+#include "vector.h"
+
+namespace CppTraining
+{
+// Linear searches over a Vector. They scan data() rather than going through the iterators, whose
+// checks keep the compiler from vectorizing the loop, and use the SIMD kernels in simd_algorithms.h
+// for integers and floating-point numbers. Other element types fall back to the standard
+// algorithms.
+
+namespace detail
+{
+template <typename T>
+std::size_t find_index(const T* data, std::size_t size, const T& value)
+{
+  if constexpr (simd::is_supported_v<T>)
+  {
+    return simd::find(data, size, value);
+  }
+  else
+  {
+    return static_cast<std::size_t>(std::find(data, data + size, value) - data);
+  }
+}
+
+template <typename T>
+std::size_t min_index(const T* data, std::size_t size)
+{
+  if constexpr (simd::is_supported_v<T>)
+  {
+    return simd::min_element(data, size);
+  }
+  else
+  {
+    return static_cast<std::size_t>(std::min_element(data, data + size) - data);
+  }
+}
+
+template <typename T>
+std::size_t max_index(const T* data, std::size_t size)
+{
+  if constexpr (simd::is_supported_v<T>)
+  {
+    return simd::max_element(data, size);
+  }
+  else
+  {
+    return static_cast<std::size_t>(std::max_element(data, data + size) - data);
+  }
+}
+} // namespace detail
+
+/// @brief The first element equal to value, or end().
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+find(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+     const typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::value_type& value)
+{
+  const auto index = detail::find_index(values.data(), values.size(), value);
+  return values.begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+find(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+     const typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::value_type& value)
+{
+  const auto index = detail::find_index(values.data(), values.size(), value);
+  return values.begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+bool contains(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+              const typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::value_type& value)
+{
+  return detail::find_index(values.data(), values.size(), value) != values.size();
+}
+
+/// @brief The number of elements equal to value.
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::size_type
+count(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values,
+      const typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::value_type& value)
+{
+  if constexpr (simd::is_supported_v<T>)
+  {
+    return simd::count(values.data(), values.size(), value);
+  }
+  else
+  {
+    return static_cast<std::size_t>(
+      std::count(values.data(), values.data() + values.size(), value));
+  }
+}
+
+/// @brief The first smallest element, or end() if there are none.
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+min_element(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values)
+{
+  const auto index = detail::min_index(values.data(), values.size());
+  return values.begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+min_element(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values)
+{
+  const auto index = detail::min_index(values.data(), values.size());
+  return values.begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+/// @brief The first largest element, or end() if there are none.
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::Iterator
+max_element(Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values)
+{
+  const auto index = detail::max_index(values.data(), values.size());
+  return values.begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+typename Vector<T, Allocator, GrowthPolicy, InlineCapacity>::ConstIterator
+max_element(const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values)
+{
+  const auto index = detail::max_index(values.data(), values.size());
+  return values.begin() + static_cast<std::ptrdiff_t>(index);
+}
+} // namespace CppTraining
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+#include <gsl/span>
+
+#include "simd_algorithms.h"
+#include "snapshot_file.h"
+#include "vector.h"
+
+namespace CppTraining
+{
+// Binary snapshots of a Vector of trivially copyable elements (see snapshot_file.h for the
+// format). save() writes the elements' bytes straight from data(), and load_view() maps the file
+// and returns a view of the elements where they lie in the mapping.
+
+/// @brief Identifies an element type in a snapshot's header, so that loading a snapshot as another
+/// type fails. Defaults to a hash of the type's std::type_info::name(), which is only stable
+/// between builds of the same compiler; specialize it to give a type a tag of its own.
+template <typename T>
+struct snapshot_type_tag
+{
+  static std::uint64_t value()
+  {
+    return static_cast<std::uint64_t>(simd::string_hash(typeid(T).name()));
+  }
+};
+
+template <typename T>
+SnapshotLayout snapshot_layout()
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable elements can be read back from a snapshot");
+
+  return SnapshotLayout{snapshot_type_tag<T>::value(), sizeof(T), alignof(T)};
+}
+
+/// @brief The elements of a snapshot, read-only, in a mapping of the file that lives as long as
+/// the view.
+template <typename T>
+class SnapshotView final
+{
+public:
+  using size_type = std::size_t;
+  using value_type = T;
+  using ConstIterator = const T*;
+
+  explicit SnapshotView(SnapshotMapping mapping) noexcept : mapping_{std::move(mapping)} {}
+
+  gsl::span<const T> span() const noexcept
+  {
+    return {static_cast<const T*>(mapping_.data()), mapping_.count()};
+  }
+
+  const T& operator[](size_type index) const { return span()[index]; }
+  const T* data() const noexcept { return static_cast<const T*>(mapping_.data()); }
+  size_type size() const noexcept { return mapping_.count(); }
+  bool empty() const noexcept { return size() == 0; }
+
+  ConstIterator begin() const noexcept { return data(); }
+  ConstIterator end() const noexcept { return data() + size(); }
+
+private:
+  SnapshotMapping mapping_;
+};
+
+/// @brief Writes the elements to path as a snapshot, replacing the file atomically.
+template <typename T, typename Allocator, typename GrowthPolicy, std::size_t InlineCapacity>
+void save(const std::string& path, const Vector<T, Allocator, GrowthPolicy, InlineCapacity>& values)
+{
+  write_snapshot(path, snapshot_layout<T>(), values.data(), values.size());
+}
+
+/// @brief Maps a snapshot of T elements. Throws std::runtime_error if the file is not one (see
+/// SnapshotMapping).
+template <typename T>
+SnapshotView<T> load_view(const std::string& path, SnapshotCheck check = SnapshotCheck::Checksum)
+{
+  return SnapshotView<T>{SnapshotMapping{path, snapshot_layout<T>(), check}};
+}
+} // namespace CppTraining
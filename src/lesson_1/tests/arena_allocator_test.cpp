@@ -0,0 +1,155 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include <catch2/catch_all.hpp>
+
+#include "arena.h"
+#include "arena_allocator.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+// Atomic, as other tests in this executable allocate from several threads
+std::atomic<std::size_t> global_allocation_count{0_z};
+} // namespace
+
+// Count every trip to the global allocator made by this test executable
+void* operator new(std::size_t size)
+{
+  global_allocation_count.fetch_add(1_z, std::memory_order_relaxed);
+  if (auto p = std::malloc(size == 0_z ? 1_z : size))
+  {
+    return p;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+SCENARIO("Vector with an ArenaAllocator", "[arena]")
+{
+  using IntVector = Vector<std::int32_t, ArenaAllocator<std::int32_t>>;
+  using IntVectors = Vector<IntVector, ArenaAllocator<IntVector>>;
+
+  GIVEN("An arena over a buffer large enough for a request")
+  {
+    alignas(std::max_align_t) static std::byte buffer[1 << 20];
+    Arena arena{buffer, sizeof(buffer)};
+
+    WHEN("A request's worth of vectors is built and torn down")
+    {
+      const auto allocations_before = global_allocation_count.load();
+      std::int64_t sum = 0;
+      {
+        IntVectors request{0_z, ArenaAllocator<IntVector>{arena}};
+        for (std::int32_t i = 0; i < 1000; ++i)
+        {
+          auto& values = *request.emplace_back(0_z, ArenaAllocator<std::int32_t>{arena});
+          for (std::int32_t j = 0; j < 20; ++j)
+          {
+            values.push_back(i + j);
+          }
+        }
+
+        for (const auto& values : request)
+        {
+          sum += values.back();
+        }
+      }
+      const auto allocations_after = global_allocation_count.load();
+
+      THEN("The global allocator is never called")
+      {
+        REQUIRE(allocations_after == allocations_before);
+        REQUIRE(sum == 1000 * 19 + 999 * 1000 / 2);
+        REQUIRE(arena.chunk_count() == 0_z);
+      }
+
+      AND_WHEN("The arena is reset")
+      {
+        arena.reset();
+
+        THEN("All of its memory is available again")
+        {
+          REQUIRE(arena.bytes_allocated() == 0_z);
+          REQUIRE(arena.allocate(1_z) == buffer);
+        }
+      }
+    }
+  }
+
+  GIVEN("Vectors over two different arenas")
+  {
+    Arena one;
+    Arena two;
+
+    IntVector lhs{0_z, ArenaAllocator<std::int32_t>{one}};
+    IntVector rhs{0_z, ArenaAllocator<std::int32_t>{two}};
+    lhs.push_back(1);
+    rhs.push_back(2);
+    rhs.push_back(3);
+
+    WHEN("One is copy assigned to the other")
+    {
+      const auto one_before = one.bytes_allocated();
+      const auto two_before = two.bytes_allocated();
+      lhs = rhs;
+
+      THEN("The allocator propagates and the copy lives in the source's arena")
+      {
+        REQUIRE(lhs.size() == 2_z);
+        REQUIRE(lhs.at(1) == 3);
+        REQUIRE(two.bytes_allocated() > two_before);
+        REQUIRE(one.bytes_allocated() == one_before);
+      }
+    }
+
+    WHEN("One is move assigned to the other")
+    {
+      lhs = std::move(rhs);
+
+      THEN("The storage is stolen along with the allocator")
+      {
+        REQUIRE(lhs.size() == 2_z);
+        REQUIRE(lhs.at(0) == 2);
+        REQUIRE(rhs.empty());
+      }
+    }
+
+    WHEN("They are swapped")
+    {
+      swap(lhs, rhs);
+
+      THEN("The allocators are swapped with the storage")
+      {
+        REQUIRE(lhs.size() == 2_z);
+        REQUIRE(rhs.size() == 1_z);
+        lhs.push_back(4);
+        REQUIRE(lhs.at(2) == 4);
+
+        // Growing past the capacity it took over allocates from the arena it took over too
+        const auto one_before = one.bytes_allocated();
+        const auto two_before = two.bytes_allocated();
+        rhs.reserve(rhs.capacity() + 16_z);
+        rhs.push_back(5);
+        REQUIRE(rhs.at(1) == 5);
+        REQUIRE(one.bytes_allocated() > one_before);
+        REQUIRE(two.bytes_allocated() == two_before);
+      }
+    }
+  }
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "small_vector.h"
+#include "vector.h"
+
+namespace CppTraining
+{
+/// @brief Containers that share Vector's interface, so that a TEMPLATE_TEST_CASE runs against
+/// each of them: TestType::container<T> (or container<T, Allocator>) names the container.
+struct VectorFamily
+{
+  template <typename T, typename Allocator = std::allocator<T>>
+  using container = Vector<T, Allocator>;
+};
+
+template <std::size_t N>
+struct SmallVectorFamily
+{
+  template <typename T, typename Allocator = std::allocator<T>>
+  using container = SmallVector<T, N, Allocator>;
+};
+} // namespace CppTraining
@@ -0,0 +1,103 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <catch2/catch_all.hpp>
+
+#include "allocation_stats.h"
+#include "instrumented_allocator.h"
+#include "propogating_allocator.h"
+#include "small_vector.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+SCENARIO("Vector with an InstrumentedAllocator", "[stats]")
+{
+  using Allocator = InstrumentedAllocator<std::int32_t, PropagatingAllocator<std::int32_t>>;
+
+  GIVEN("A vector recording in a fresh registry")
+  {
+    AllocationStatsRegistry registry;
+    auto& site = registry.site("vector");
+    Vector<std::int32_t, Allocator> values{0_z, Allocator{site}};
+
+    WHEN("Elements are appended one at a time")
+    {
+      for (std::int32_t i = 0; i < 100; ++i)
+      {
+        values.push_back(i);
+      }
+
+      THEN("Every growth is recorded, along with the capacity it added")
+      {
+        const auto stats = site.snapshot();
+        REQUIRE(stats.growth_events == 8);
+        REQUIRE(stats.growth_bytes == values.capacity() * sizeof(std::int32_t));
+        REQUIRE(stats.live_bytes ==
+                static_cast<std::int64_t>(values.capacity() * sizeof(std::int32_t)));
+      }
+
+      THEN("Growth goes through the inner allocator's realloc rather than new blocks")
+      {
+        const auto stats = site.snapshot();
+        REQUIRE(stats.allocations == 1);
+        REQUIRE(stats.reallocations == 7);
+      }
+    }
+
+    WHEN("The vector reserves ahead of time")
+    {
+      values.reserve(100);
+      for (std::int32_t i = 0; i < 100; ++i)
+      {
+        values.push_back(i);
+      }
+
+      THEN("There is a single growth event")
+      {
+        REQUIRE(site.snapshot().growth_events == 1);
+      }
+    }
+
+    WHEN("The vector is copied and both are destroyed")
+    {
+      values.push_back(1);
+      {
+        auto copy = values;
+
+        THEN("The copy records in the same site")
+        {
+          REQUIRE(site.snapshot().allocations == 2);
+        }
+      }
+      values = Vector<std::int32_t, Allocator>{};
+
+      THEN("None of their memory is live")
+      {
+        REQUIRE(site.snapshot().live_bytes == 0);
+      }
+    }
+  }
+
+  GIVEN("A SmallVector recording in a fresh registry")
+  {
+    AllocationStatsRegistry registry;
+    auto& site = registry.site("small vector");
+    SmallVector<std::int32_t, 4, Allocator> values{0_z, Allocator{site}};
+
+    WHEN("It outgrows its inline storage")
+    {
+      for (std::int32_t i = 0; i < 5; ++i)
+      {
+        values.push_back(i);
+      }
+
+      THEN("Only the move to the heap is recorded")
+      {
+        const auto stats = site.snapshot();
+        REQUIRE(stats.allocations == 1);
+        REQUIRE(stats.growth_events == 1);
+      }
+    }
+  }
+}
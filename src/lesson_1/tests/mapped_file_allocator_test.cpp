@@ -0,0 +1,207 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include "literal_operators.h"
+#include "mapped_file.h"
+#include "mapped_file_allocator.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+struct Entry
+{
+  std::uint64_t key;
+  double value;
+};
+
+using Entries = Vector<Entry, MappedFileAllocator<Entry>>;
+
+std::string temporaryPath(const char* name)
+{
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+Entries adoptStored(MappedFileAllocator<Entry>& allocator)
+{
+  const auto stored = allocator.adopt_stored();
+  return Entries{adopt_buffer, stored.data, stored.size, stored.capacity, allocator};
+}
+} // namespace
+
+SCENARIO("Vector in a memory-mapped file", "[mapped_file]")
+{
+  const auto path = temporaryPath("cpp_training_mapped_file_test.bin");
+  std::remove(path.c_str());
+
+  GIVEN("A vector built in a new file")
+  {
+    {
+      MappedFile file{path};
+      MappedFileAllocator<Entry> allocator{file};
+      Entries entries{0_z, allocator};
+      for (std::uint64_t i = 0; i < 100'000; ++i)
+      {
+        entries.push_back(Entry{i, static_cast<double>(i) / 2});
+      }
+
+      // Growing in the middle moves the elements to a second block in the file
+      entries.insert(entries.begin() + 50'000, 100'000, Entry{0, -1.0});
+      entries.erase(entries.begin() + 50'000, entries.begin() + 150'000);
+      allocator.store_size(entries.size());
+    }
+
+    WHEN("The file is opened again")
+    {
+      MappedFile file{path};
+      MappedFileAllocator<Entry> allocator{file};
+      auto entries = adoptStored(allocator);
+
+      THEN("The vector is back without being rebuilt")
+      {
+        REQUIRE(entries.size() == 100'000_z);
+        REQUIRE(entries.capacity() >= entries.size());
+        for (std::uint64_t i = 0; i < 100'000; ++i)
+        {
+          REQUIRE(entries[i].key == i);
+          REQUIRE(entries[i].value == static_cast<double>(i) / 2);
+        }
+        REQUIRE(allocator.adopt_stored().data == nullptr);
+      }
+
+      AND_WHEN("It is changed and opened a third time")
+      {
+        entries.resize(200'000);
+        entries.back() = Entry{7, 7.0};
+        entries.shrink_to_fit();
+        allocator.store_size(entries.size());
+        entries = Entries{0_z, allocator};
+
+        MappedFile reopened{path};
+        MappedFileAllocator<Entry> reopened_allocator{reopened};
+        const auto stored = reopened_allocator.adopt_stored();
+
+        THEN("The file holds what was stored last")
+        {
+          REQUIRE(stored.size == 200'000_z);
+          REQUIRE(stored.capacity == 200'000_z);
+          REQUIRE(stored.data[199'999].key == 7);
+          reopened_allocator.deallocate(stored.data, stored.capacity);
+        }
+      }
+    }
+
+    WHEN("The file is truncated")
+    {
+      MappedFile file{path, MappedFile::Mode::Truncate};
+      MappedFileAllocator<Entry> allocator{file};
+
+      THEN("There is nothing to adopt")
+      {
+        REQUIRE(adoptStored(allocator).empty());
+      }
+    }
+
+    WHEN("A new vector is built without adopting the stored one")
+    {
+      {
+        MappedFile file{path};
+        MappedFileAllocator<Entry> allocator{file};
+        Entries entries{0_z, allocator};
+        entries.push_back(Entry{42, 42.0});
+        allocator.store_size(entries.size());
+      }
+
+      MappedFile file{path};
+      MappedFileAllocator<Entry> allocator{file};
+
+      THEN("It replaces the stored one")
+      {
+        const auto entries = adoptStored(allocator);
+        REQUIRE(entries.size() == 1_z);
+        REQUIRE(entries.front().key == 42);
+      }
+    }
+  }
+
+  GIVEN("A vector in a file and one on the heap")
+  {
+    MappedFile file{path};
+    MappedFileAllocator<Entry> allocator{file};
+    Entries in_file{{Entry{1, 1.0}, Entry{2, 2.0}}, allocator};
+    Entries on_heap{{Entry{3, 3.0}}};
+
+    const auto file_bytes = 2 * sizeof(Entry);
+    REQUIRE(file.stored_bytes() == file_bytes);
+
+    THEN("A copy of the vector in the file is on the heap")
+    {
+      auto copy = in_file;
+      copy.reserve(1000);
+      REQUIRE(copy.size() == 2_z);
+      REQUIRE(file.stored_bytes() == file_bytes);
+    }
+
+    WHEN("They are swapped")
+    {
+      swap(in_file, on_heap);
+
+      THEN("The allocators go with the elements")
+      {
+        in_file.reserve(1000);
+        REQUIRE(file.stored_bytes() == file_bytes);
+        on_heap.reserve(1000);
+        REQUIRE(file.stored_bytes() == 1000 * sizeof(Entry));
+        REQUIRE(on_heap[1].key == 2);
+      }
+    }
+
+    WHEN("The vector on the heap is move assigned to the one in the file")
+    {
+      const auto* data = in_file.data();
+      in_file = std::move(on_heap);
+
+      THEN("The elements are moved into the file")
+      {
+        REQUIRE(in_file.data() == data);
+        REQUIRE(in_file.size() == 1_z);
+        REQUIRE(in_file.front().key == 3);
+      }
+    }
+  }
+
+  GIVEN("A file that was not written by a MappedFile")
+  {
+    std::ofstream{path} << std::string(8192, 'x');
+
+    THEN("Opening it throws")
+    {
+      REQUIRE_THROWS_AS(MappedFile{path}, std::runtime_error);
+    }
+  }
+
+  std::remove(path.c_str());
+}
+
+SCENARIO("MappedFileAllocator without a file", "[mapped_file]")
+{
+  MappedFileAllocator<std::int32_t> allocator;
+  Vector<std::int32_t, MappedFileAllocator<std::int32_t>> values{0_z, allocator};
+  for (std::int32_t i = 0; i < 1000; ++i)
+  {
+    values.push_back(i);
+  }
+
+  REQUIRE(std::accumulate(values.begin(), values.end(), 0) == 999 * 1000 / 2);
+  REQUIRE(allocator.adopt_stored().data == nullptr);
+  REQUIRE(allocator == MappedFileAllocator<double>{});
+}
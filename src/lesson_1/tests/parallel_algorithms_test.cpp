@@ -0,0 +1,416 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "literal_operators.h"
+#include "parallel_algorithms.h"
+#include "thread_pool.h"
+#include "vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+/// @brief Small values, so that sorting has plenty of ties.
+Vector<std::int64_t> makeValues(std::size_t count)
+{
+  std::mt19937 engine{static_cast<std::mt19937::result_type>(count)};
+  std::uniform_int_distribution<std::int64_t> distribution{-1000, 1000};
+
+  Vector<std::int64_t> values;
+  values.reserve(count);
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    values.push_back(distribution(engine));
+  }
+
+  return values;
+}
+
+std::vector<std::int64_t> toStd(const Vector<std::int64_t>& values)
+{
+  return std::vector<std::int64_t>(values.data(), values.data() + values.size());
+}
+
+/// @brief Counts its live instances, and throws from the default constructor once armed.
+struct Counted
+{
+  static std::atomic<std::int64_t> live;
+  static std::atomic<std::int64_t> constructions_left;
+
+  Counted()
+  {
+    if (constructions_left.fetch_sub(1) == 0)
+    {
+      throw std::runtime_error("Counted");
+    }
+    ++live;
+  }
+  Counted(const Counted&) { ++live; }
+  ~Counted() { --live; }
+
+  std::int64_t value{42};
+};
+
+std::atomic<std::int64_t> Counted::live{0};
+std::atomic<std::int64_t> Counted::constructions_left{-1};
+} // namespace
+
+// Sizes from empty, through a single chunk, to many chunks of uneven length
+constexpr std::size_t Sizes[] = {0, 1, 2, 4095, 4096, 70'001, 250'007};
+
+SCENARIO("Sorting a Vector in parallel", "[parallel_algorithms]")
+{
+  ThreadPool pool{4};
+
+  GIVEN("Vectors of integers of various sizes")
+  {
+    for (auto size : Sizes)
+    {
+      CAPTURE(size);
+      auto values = makeValues(size);
+      auto expected = toStd(values);
+
+      WHEN("They are sorted")
+      {
+        parallel::sort(values, std::less<>{}, pool);
+        std::sort(expected.begin(), expected.end());
+
+        THEN("They match std::sort")
+        {
+          REQUIRE(toStd(values) == expected);
+        }
+      }
+
+      WHEN("They are sorted with another order")
+      {
+        parallel::sort(values, std::greater<>{}, pool);
+        std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+        THEN("They match std::sort")
+        {
+          REQUIRE(toStd(values) == expected);
+        }
+      }
+    }
+  }
+
+  GIVEN("A vector of strings")
+  {
+    Vector<std::string> values;
+    for (const auto value : makeValues(20'000))
+    {
+      values.push_back("key-" + std::to_string(value));
+    }
+    std::vector<std::string> expected(values.begin(), values.end());
+
+    WHEN("It is sorted")
+    {
+      parallel::sort(values, std::less<>{}, pool);
+      std::sort(expected.begin(), expected.end());
+
+      THEN("Every string is moved into place intact")
+      {
+        REQUIRE(std::equal(values.begin(), values.end(), expected.begin(), expected.end()));
+      }
+    }
+  }
+
+  GIVEN("A comparison that throws")
+  {
+    auto values = makeValues(70'001);
+    std::atomic<int> comparisons{0};
+    auto compare = [&comparisons](std::int64_t lhs, std::int64_t rhs) {
+      if (comparisons.fetch_add(1) == 100'000)
+      {
+        throw std::runtime_error{"compare"};
+      }
+      return lhs < rhs;
+    };
+
+    THEN("The exception reaches the caller and the pool keeps working")
+    {
+      REQUIRE_THROWS_AS(parallel::sort(values, compare, pool), std::runtime_error);
+      REQUIRE(values.size() == 70'001_z);
+
+      parallel::sort(values, std::less<>{}, pool);
+      REQUIRE(std::is_sorted(values.data(), values.data() + values.size()));
+    }
+  }
+}
+
+SCENARIO("for_each and transform over a Vector in parallel", "[parallel_algorithms]")
+{
+  ThreadPool pool{4};
+
+  GIVEN("A vector of integers")
+  {
+    auto values = makeValues(100'003);
+    const auto original = toStd(values);
+
+    WHEN("for_each doubles every element")
+    {
+      parallel::for_each(values, [](std::int64_t& value) { value *= 2; }, pool);
+
+      THEN("Each one is doubled once")
+      {
+        for (std::size_t i = 0; i < original.size(); ++i)
+        {
+          REQUIRE(values[i] == 2 * original[i]);
+        }
+      }
+    }
+
+    WHEN("for_each reads every element of a const vector")
+    {
+      const auto& const_values = values;
+      std::atomic<std::int64_t> sum{0};
+      parallel::for_each(const_values, [&sum](std::int64_t value) { sum += value; }, pool);
+
+      THEN("It sees them all")
+      {
+        REQUIRE(sum.load() == std::accumulate(original.begin(), original.end(), std::int64_t{0}));
+      }
+    }
+
+    WHEN("They are transformed into strings")
+    {
+      Vector<std::string> strings{3};
+      strings.push_back("stale");
+      parallel::transform(
+        values, strings, [](std::int64_t value) { return std::to_string(value); }, pool);
+
+      THEN("The output has one string per element")
+      {
+        REQUIRE(strings.size() == values.size());
+        REQUIRE(strings.front() == std::to_string(original.front()));
+        REQUIRE(strings[77'777] == std::to_string(original[77'777]));
+        REQUIRE(strings.back() == std::to_string(original.back()));
+      }
+    }
+
+    WHEN("They are transformed in place")
+    {
+      parallel::transform(values, values, [](std::int64_t value) { return -value; }, pool);
+
+      THEN("Each one is negated")
+      {
+        REQUIRE(values.size() == original.size());
+        for (std::size_t i = 0; i < original.size(); ++i)
+        {
+          REQUIRE(values[i] == -original[i]);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Reducing and scanning a Vector in parallel", "[parallel_algorithms]")
+{
+  ThreadPool pool{4};
+
+  GIVEN("Vectors of integers of various sizes")
+  {
+    for (auto size : Sizes)
+    {
+      CAPTURE(size);
+      const auto values = makeValues(size);
+      const auto original = toStd(values);
+
+      THEN("reduce and transform_reduce match std::accumulate")
+      {
+        REQUIRE(parallel::reduce(values, std::int64_t{5}, std::plus<>{}, pool) ==
+                std::accumulate(original.begin(), original.end(), std::int64_t{5}));
+        REQUIRE(parallel::transform_reduce(
+                  values,
+                  std::int64_t{0},
+                  std::plus<>{},
+                  [](std::int64_t value) { return value * value; },
+                  pool) == std::inner_product(original.begin(),
+                                              original.end(),
+                                              original.begin(),
+                                              std::int64_t{0}));
+      }
+
+      THEN("The scans match std::inclusive_scan and std::exclusive_scan")
+      {
+        Vector<std::int64_t> inclusive;
+        parallel::inclusive_scan(values, inclusive, std::plus<>{}, pool);
+        std::vector<std::int64_t> expected(original.size());
+        std::inclusive_scan(original.begin(), original.end(), expected.begin());
+        REQUIRE(toStd(inclusive) == expected);
+
+        Vector<std::int64_t> exclusive;
+        parallel::exclusive_scan(values, exclusive, std::int64_t{7}, std::plus<>{}, pool);
+        std::exclusive_scan(original.begin(), original.end(), expected.begin(), std::int64_t{7});
+        REQUIRE(toStd(exclusive) == expected);
+      }
+    }
+  }
+
+  GIVEN("A scan whose operation is associative but not commutative")
+  {
+    Vector<std::string> letters;
+    for (std::size_t i = 0; i < 9000; ++i)
+    {
+      letters.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+    }
+
+    THEN("Every prefix keeps its order")
+    {
+      Vector<std::string> prefixes;
+      parallel::inclusive_scan(letters, prefixes, std::plus<>{}, pool);
+
+      std::string expected;
+      for (std::size_t i = 0; i < letters.size(); ++i)
+      {
+        expected += letters[i];
+        REQUIRE(prefixes[i] == expected);
+      }
+
+      REQUIRE(parallel::reduce(letters, std::string{}, std::plus<>{}, pool) == expected);
+    }
+  }
+
+  GIVEN("A scan done in place")
+  {
+    auto values = makeValues(100'003);
+    const auto original = toStd(values);
+
+    THEN("Each element is replaced by its exclusive prefix sum")
+    {
+      parallel::exclusive_scan(values, values, std::int64_t{0}, std::plus<>{}, pool);
+
+      std::vector<std::int64_t> expected(original.size());
+      std::exclusive_scan(original.begin(), original.end(), expected.begin(), std::int64_t{0});
+      REQUIRE(toStd(values) == expected);
+    }
+  }
+
+  GIVEN("The global pool")
+  {
+    const auto values = makeValues(50'000);
+
+    THEN("The algorithms run on it by default")
+    {
+      auto sorted = values;
+      parallel::sort(sorted);
+      REQUIRE(std::is_sorted(sorted.data(), sorted.data() + sorted.size()));
+
+      Vector<std::int64_t> sums;
+      parallel::inclusive_scan(values, sums);
+      REQUIRE(sums.back() == parallel::reduce(values, std::int64_t{0}));
+    }
+  }
+}
+
+SCENARIO("Resizing a Vector in parallel", "[parallel_algorithms]")
+{
+  ThreadPool pool{4};
+
+  GIVEN("Vectors of integers of various sizes")
+  {
+    for (auto size : Sizes)
+    {
+      CAPTURE(size);
+      auto values = makeValues(size);
+      const auto original = toStd(values);
+
+      WHEN("They grow to many chunks")
+      {
+        values.resize(size + 1'000'003, parallel_tag, pool);
+
+        THEN("The old elements are kept, the new ones are zero, and shrinking undoes it")
+        {
+          REQUIRE(values.size() == size + 1'000'003);
+          REQUIRE(std::equal(original.begin(), original.end(), values.data()));
+          REQUIRE(std::all_of(values.begin() + size, values.end(), [](std::int64_t value) {
+            return value == 0;
+          }));
+
+          values.resize(size, parallel_tag, pool);
+          REQUIRE(toStd(values) == original);
+        }
+      }
+
+      WHEN("Their pages are prefaulted first")
+      {
+        values.reserve(size + 700'001, parallel_tag, pool);
+        const auto data = values.data();
+        values.resize(size + 700'001, parallel_tag, pool);
+
+        THEN("The storage is not reallocated and the new elements are still zero")
+        {
+          REQUIRE(values.data() == data);
+          REQUIRE(std::equal(original.begin(), original.end(), values.data()));
+          REQUIRE(std::all_of(values.begin() + size, values.end(), [](std::int64_t value) {
+            return value == 0;
+          }));
+        }
+      }
+    }
+  }
+
+  GIVEN("Elements that are not trivial")
+  {
+    Vector<std::string> names;
+    names.push_back("first");
+
+    WHEN("The vector grows in parallel")
+    {
+      names.resize(300'000, parallel_tag, pool);
+
+      THEN("Every new element is an empty string")
+      {
+        REQUIRE(names[0] == "first");
+        REQUIRE(std::all_of(names.begin() + 1, names.end(), [](const std::string& name) {
+          return name.empty();
+        }));
+      }
+    }
+  }
+
+  GIVEN("Elements whose construction throws part way through")
+  {
+    {
+      Vector<Counted> counted;
+      counted.resize(10);
+      Counted::constructions_left = 400'000;
+
+      THEN("The new elements are all destroyed and the old ones kept")
+      {
+        REQUIRE_THROWS_AS(counted.resize(1'000'000, parallel_tag, pool), std::runtime_error);
+        REQUIRE(counted.size() == 10);
+        REQUIRE(Counted::live == 10);
+        REQUIRE(counted[9].value == 42);
+      }
+
+      Counted::constructions_left = -1;
+    }
+
+    REQUIRE(Counted::live == 0);
+  }
+
+  GIVEN("The global pool")
+  {
+    Vector<std::int64_t> values;
+
+    THEN("resize() and reserve() run on it by default")
+    {
+      values.reserve(500'000, parallel_tag);
+      REQUIRE(values.capacity() >= 500'000);
+      values.resize(500'000, parallel_tag);
+      REQUIRE(values.size() == 500'000);
+      REQUIRE(parallel::reduce(values, std::int64_t{0}) == 0);
+    }
+  }
+}
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "growth_policies.h"
+#include "instrumented_allocator.h"
+#include "literal_operators.h"
+#include "segmented_vector.h"
+#include "throwing_copy.h"
+
+using namespace CppTraining;
+
+SCENARIO("Exercising SegmentedVector", "[segmented_vector]")
+{
+  GIVEN("An empty vector whose first segment holds 4 elements")
+  {
+    SegmentedVector<std::string> values{3};
+
+    THEN("It is empty")
+    {
+      REQUIRE(values.empty());
+      REQUIRE(values.size() == 0_z);
+      REQUIRE(values.begin() == values.end());
+      REQUIRE_THROWS_AS(values[0], std::out_of_range);
+    }
+
+    WHEN("Elements are appended across several segments")
+    {
+      std::vector<const std::string*> addresses;
+      for (int i = 0; i < 100; ++i)
+      {
+        auto position = values.push_back(std::to_string(i));
+        addresses.push_back(&*position);
+      }
+
+      THEN("They keep their order and their addresses")
+      {
+        REQUIRE(values.size() == 100_z);
+        for (std::size_t i = 0; i < 100; ++i)
+        {
+          REQUIRE(values[i] == std::to_string(i));
+          REQUIRE(&values.at(i) == addresses[i]);
+        }
+        REQUIRE_THROWS_AS(values.at(100), std::out_of_range);
+      }
+
+      THEN("Each segment is contiguous and twice the size of the one before")
+      {
+        REQUIRE(&values[3] == &values[0] + 3);
+        REQUIRE(&values[7] == &values[4] + 3);
+        REQUIRE(&values[15] == &values[8] + 7);
+        REQUIRE(&values[63] == &values[32] + 31);
+      }
+
+      THEN("The iterators visit every element")
+      {
+        const auto& const_values = values;
+        REQUIRE(const_values.end() - const_values.begin() == 100);
+        REQUIRE(std::count_if(values.begin(), values.end(), [](const std::string& value) {
+                  return value.size() == 2;
+                }) == 90);
+
+        auto it = values.begin() + 42;
+        REQUIRE(*it == "42");
+        REQUIRE(it[8] == "50");
+        REQUIRE((it--)->size() == 2_z);
+        REQUIRE(*it == "41");
+        SegmentedVector<std::string>::ConstIterator const_it = it;
+        REQUIRE(const_it == values.cbegin() + 41);
+        REQUIRE(const_it < values.cend());
+      }
+
+      AND_WHEN("It is cleared")
+      {
+        values.clear();
+
+        THEN("It is empty and can be filled again in the same segments")
+        {
+          REQUIRE(values.empty());
+          values.emplace_back(3, 'x');
+          REQUIRE(values[0] == "xxx");
+          REQUIRE(&values[0] == addresses[0]);
+        }
+      }
+    }
+
+    WHEN("grow_by appends a range")
+    {
+      values.push_back("first");
+      auto first = values.grow_by(10, "filler");
+      auto defaulted = values.grow_by(3);
+
+      THEN("The range is contiguous in index and initialized")
+      {
+        REQUIRE(first - values.begin() == 1);
+        REQUIRE(defaulted - values.begin() == 11);
+        REQUIRE(values.size() == 14_z);
+        REQUIRE(std::all_of(first, defaulted, [](const std::string& value) {
+          return value == "filler";
+        }));
+        REQUIRE(values[13].empty());
+      }
+    }
+
+    THEN("It cannot reserve more than max_size()")
+    {
+      REQUIRE_THROWS_AS(values.reserve(values.max_size() + 1), std::length_error);
+    }
+  }
+
+  GIVEN("A vector with a growth policy that grows by a constant step")
+  {
+    SegmentedVector<std::int32_t, std::allocator<std::int32_t>, CappedLinearGrowthPolicy<8, 8>>
+      values{8};
+    for (std::int32_t i = 0; i < 1000; ++i)
+    {
+      values.push_back(i);
+    }
+
+    THEN("Every element is found with the binary search over the segments")
+    {
+      for (std::size_t i = 0; i < 1000; ++i)
+      {
+        REQUIRE(values[i] == static_cast<std::int32_t>(i));
+      }
+      REQUIRE(&values[15] == &values[8] + 7);
+      REQUIRE(values.max_size() == 8_z * SegmentedVector<std::int32_t>::MaxSegmentCount);
+    }
+
+    THEN("Growing past the last segment throws")
+    {
+      REQUIRE_THROWS_AS(values.grow_by(values.max_size()), std::length_error);
+    }
+  }
+
+  GIVEN("A vector that reserves through an InstrumentedAllocator")
+  {
+    AllocationSite site{"segmented_vector_test"};
+    {
+      SegmentedVector<std::int64_t, InstrumentedAllocator<std::int64_t>> values{
+        16, InstrumentedAllocator<std::int64_t>{site}};
+      values.reserve(100);
+      REQUIRE(site.snapshot().allocations == 4);
+
+      values.grow_by(100);
+      REQUIRE(site.snapshot().allocations == 4);
+    }
+
+    THEN("Appending uses the reserved segments and destruction returns them")
+    {
+      REQUIRE(site.snapshot().deallocations == 4);
+      REQUIRE(site.snapshot().live_bytes == 0);
+    }
+  }
+
+  GIVEN("Elements whose copy constructor can throw")
+  {
+    SegmentedVector<ThrowingCopy> values;
+    values.emplace_back(1);
+    ThrowingCopy value{2};
+
+    WHEN("A copy throws in the middle of grow_by")
+    {
+      ThrowingCopy::reset(3);
+      REQUIRE_THROWS_AS(values.grow_by(5, value), std::runtime_error);
+      ThrowingCopy::reset(std::numeric_limits<std::size_t>::max());
+
+      THEN("The range becomes a hole and appending carries on after it")
+      {
+        REQUIRE(values.size() == 6_z);
+        auto position = values.push_back(value);
+        REQUIRE(position - values.begin() == 6);
+        REQUIRE(values[0] == ThrowingCopy{1});
+        REQUIRE(values[6] == value);
+      }
+    }
+  }
+}
+
+SCENARIO("Appending to a SegmentedVector from many threads", "[segmented_vector]")
+{
+  GIVEN("Producers that mix push_back and grow_by")
+  {
+    constexpr std::int64_t Producers = 8;
+    constexpr std::int64_t PerProducer = 20'000;
+
+    // A first segment of 2 makes the producers race to allocate many small segments
+    SegmentedVector<std::int64_t> values{2};
+    std::vector<std::vector<const std::int64_t*>> addresses(Producers);
+
+    std::vector<std::thread> producers;
+    for (std::int64_t producer = 0; producer < Producers; ++producer)
+    {
+      producers.emplace_back([&values, &addresses, producer] {
+        auto& appended = addresses[static_cast<std::size_t>(producer)];
+        for (std::int64_t i = 0; i < PerProducer;)
+        {
+          const auto value = producer * PerProducer + i;
+          if (i % 100 == 0 && i + 3 <= PerProducer)
+          {
+            // The range belongs to this thread until grow_by returns it
+            auto first = values.grow_by(3);
+            for (std::int64_t offset = 0; offset < 3; ++offset)
+            {
+              first[offset] = value + offset;
+              appended.push_back(&first[offset]);
+            }
+            i += 3;
+          }
+          else
+          {
+            appended.push_back(&*values.push_back(value));
+            ++i;
+          }
+        }
+      });
+    }
+
+    for (auto& producer : producers)
+    {
+      producer.join();
+    }
+
+    THEN("Every value is there exactly once")
+    {
+      REQUIRE(values.size() == static_cast<std::size_t>(Producers * PerProducer));
+
+      std::vector<std::int64_t> seen(values.begin(), values.end());
+      std::sort(seen.begin(), seen.end());
+      for (std::size_t i = 0; i < seen.size(); ++i)
+      {
+        REQUIRE(seen[i] == static_cast<std::int64_t>(i));
+      }
+    }
+
+    THEN("Every element stayed where it was appended")
+    {
+      for (std::int64_t producer = 0; producer < Producers; ++producer)
+      {
+        const auto& appended = addresses[static_cast<std::size_t>(producer)];
+        REQUIRE(appended.size() == static_cast<std::size_t>(PerProducer));
+        for (std::int64_t i = 0; i < PerProducer; ++i)
+        {
+          REQUIRE(*appended[static_cast<std::size_t>(i)] == producer * PerProducer + i);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "instrumented_allocator.h"
+#include "literal_operators.h"
+#include "soa_vector.h"
+
+using namespace CppTraining;
+
+namespace
+{
+using Records = SoaVector<std::int32_t, std::string, double>;
+
+Records makeRecords(std::size_t count)
+{
+  Records records;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    const auto key = static_cast<std::int32_t>((i * 7919) % count);
+    records.emplace_back(key, "name-" + std::to_string(key), key * 0.5);
+  }
+  return records;
+}
+} // namespace
+
+SCENARIO("Exercising SoaVector", "[soa_vector]")
+{
+  GIVEN("An empty vector")
+  {
+    Records records;
+
+    THEN("It is empty")
+    {
+      REQUIRE(records.empty());
+      REQUIRE(records.size() == 0_z);
+      REQUIRE(records.begin() == records.end());
+      REQUIRE(records.column<1>().empty());
+      REQUIRE_THROWS_AS(records.front(), std::out_of_range);
+    }
+
+    WHEN("Records are appended")
+    {
+      records.emplace_back(1, "one", 1.5);
+      records.push_back(Records::value_type{2, "two", 2.5});
+      const Records::value_type three{3, "three", 3.5};
+      records.push_back(three);
+
+      THEN("Each field lands in its own column")
+      {
+        REQUIRE(records.size() == 3_z);
+        REQUIRE(records.column<0>().size() == 3_z);
+        REQUIRE(records.column<0>()[1] == 2);
+        REQUIRE(records.column<1>()[2] == "three");
+        REQUIRE(records.column<2>()[0] == 1.5);
+        REQUIRE(&records.column<0>()[1] == &records.column<0>()[0] + 1);
+      }
+
+      THEN("An element reads like a tuple")
+      {
+        REQUIRE(records[1] == Records::value_type{2, "two", 2.5});
+        REQUIRE(std::get<1>(records.back()) == "three");
+        REQUIRE(records.front() < records.back());
+
+        const auto& const_records = records;
+        Records::value_type copy = const_records.at(2);
+        REQUIRE(copy == three);
+        REQUIRE_THROWS_AS(records.at(3), std::out_of_range);
+      }
+
+      THEN("Assigning through an element assigns its fields")
+      {
+        std::get<1>(records[0]) = "uno";
+        records[1] = records[2];
+        records[2] = Records::value_type{4, "four", 4.5};
+
+        REQUIRE(records.column<1>()[0] == "uno");
+        REQUIRE(records[1] == three);
+        REQUIRE(std::get<0>(records[2]) == 4);
+      }
+
+      THEN("pop_back, resize and clear keep the columns the same length")
+      {
+        records.pop_back();
+        REQUIRE(records.size() == 2_z);
+        REQUIRE(records.column<2>().size() == 2_z);
+
+        records.resize(5);
+        REQUIRE(records[4] == Records::value_type{0, "", 0.0});
+
+        records.clear();
+        REQUIRE(records.empty());
+        REQUIRE(records.column<1>().empty());
+      }
+    }
+  }
+
+  GIVEN("Many records in no particular order")
+  {
+    auto records = makeRecords(5000);
+
+    WHEN("They are sorted by one field")
+    {
+      std::sort(records.begin(), records.end(), [](const auto& lhs, const auto& rhs) {
+        return std::get<1>(lhs) < std::get<1>(rhs);
+      });
+
+      THEN("Every record is sorted as a whole")
+      {
+        REQUIRE(std::is_sorted(records.column<1>().begin(), records.column<1>().end()));
+        for (const auto& record : records)
+        {
+          REQUIRE(std::get<1>(record) == "name-" + std::to_string(std::get<0>(record)));
+          REQUIRE(std::get<2>(record) == std::get<0>(record) * 0.5);
+        }
+      }
+    }
+
+    WHEN("They are sorted as tuples")
+    {
+      std::sort(records.begin(), records.end());
+
+      THEN("They are in key order")
+      {
+        for (std::size_t i = 0; i < records.size(); ++i)
+        {
+          REQUIRE(std::get<0>(records[i]) == static_cast<std::int32_t>(i));
+        }
+      }
+    }
+
+    THEN("A column scan sees every key")
+    {
+      const auto keys = records.column<0>();
+      REQUIRE(std::accumulate(keys.begin(), keys.end(), std::int64_t{0}) == 4999 * 5000 / 2);
+
+      std::vector<std::int32_t> through_iterators;
+      for (auto it = records.cbegin(); it != records.cend(); ++it)
+      {
+        through_iterators.push_back(std::get<0>(*it));
+      }
+      REQUIRE(std::equal(keys.begin(), keys.end(), through_iterators.begin()));
+    }
+  }
+
+  GIVEN("A vector whose columns allocate through an InstrumentedAllocator")
+  {
+    AllocationSite site{"soa_vector_test"};
+    {
+      BasicSoaVector<InstrumentedAllocator<std::byte>, DefaultGrowthPolicy, std::int64_t, float>
+        records{0, InstrumentedAllocator<std::byte>{site}};
+      records.reserve(1000);
+      for (std::int64_t i = 0; i < 1000; ++i)
+      {
+        records.emplace_back(i, static_cast<float>(i));
+      }
+
+      THEN("Each column is one block, grown by the same policy")
+      {
+        REQUIRE(records.capacity() == 1000_z);
+        REQUIRE(site.snapshot().allocations == 2);
+        REQUIRE(site.snapshot().live_bytes == 1000 * (8 + 4));
+      }
+    }
+
+    THEN("Every column is freed")
+    {
+      REQUIRE(site.snapshot().live_bytes == 0);
+    }
+  }
+}
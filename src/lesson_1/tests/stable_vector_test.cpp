@@ -0,0 +1,234 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "instrumented_allocator.h"
+#include "literal_operators.h"
+#include "propogating_allocator.h"
+#include "stable_vector.h"
+#include "throwing_copy.h"
+
+using namespace CppTraining;
+
+SCENARIO("Exercising StableVector", "[stable_vector]")
+{
+  GIVEN("An empty vector")
+  {
+    StableVector<std::string> values;
+
+    THEN("It is empty")
+    {
+      REQUIRE(values.empty());
+      REQUIRE(values.size() == 0_z);
+      REQUIRE(values.begin() == values.end());
+      REQUIRE_THROWS_AS(values.front(), std::out_of_range);
+      REQUIRE_THROWS_AS(values.back(), std::out_of_range);
+      REQUIRE_NOTHROW(values.pop_back());
+      REQUIRE_NOTHROW(values.pop_front());
+    }
+
+    WHEN("Elements are appended across many blocks")
+    {
+      constexpr std::size_t Count = 10 * StableVector<std::string>::BlockSize + 3;
+      std::vector<const std::string*> addresses;
+      for (std::size_t i = 0; i < Count; ++i)
+      {
+        addresses.push_back(&*values.push_back(std::to_string(i)));
+      }
+
+      THEN("None of them has moved")
+      {
+        REQUIRE(values.size() == Count);
+        for (std::size_t i = 0; i < Count; ++i)
+        {
+          REQUIRE(values[i] == std::to_string(i));
+          REQUIRE(&values.at(i) == addresses[i]);
+        }
+        REQUIRE_THROWS_AS(values.at(Count), std::out_of_range);
+        REQUIRE(values.front() == "0");
+        REQUIRE(values.back() == std::to_string(Count - 1));
+      }
+
+      AND_WHEN("Elements are pushed and popped at the front")
+      {
+        for (int i = 1; i <= 100; ++i)
+        {
+          values.emplace_front(3, static_cast<char>('a' + i % 26));
+        }
+        values.pop_front();
+        values.push_front("front");
+        values.pop_back();
+
+        THEN("The others still have not moved")
+        {
+          REQUIRE(values.size() == Count + 99);
+          REQUIRE(values.front() == "front");
+          REQUIRE(values[1] == "vvv");
+          REQUIRE(values[99] == "bbb");
+          REQUIRE(values.back() == std::to_string(Count - 2));
+          for (std::size_t i = 0; i + 1 < Count; ++i)
+          {
+            REQUIRE(&values[i + 100] == addresses[i]);
+          }
+        }
+      }
+
+      AND_WHEN("It is cleared")
+      {
+        values.clear();
+
+        THEN("It is empty and can be used again")
+        {
+          REQUIRE(values.empty());
+          values.push_front("again");
+          REQUIRE(values.size() == 1_z);
+          REQUIRE(values.back() == "again");
+        }
+      }
+    }
+  }
+
+  GIVEN("A vector of integers")
+  {
+    StableVector<std::int32_t> values;
+    for (std::int32_t i = 0; i < 5000; ++i)
+    {
+      values.push_back(4999 - i);
+    }
+
+    THEN("The iterators work with the standard algorithms")
+    {
+      std::sort(values.begin(), values.end());
+      REQUIRE(std::is_sorted(values.cbegin(), values.cend()));
+      REQUIRE(std::accumulate(values.begin(), values.end(), 0) == 4999 * 5000 / 2);
+
+      auto it = values.begin() + 100;
+      REQUIRE(*it == 100);
+      REQUIRE(it[1000] == 1100);
+      REQUIRE(values.end() - it == 4900);
+      StableVector<std::int32_t>::ConstIterator const_it = it;
+      REQUIRE(const_it == values.cbegin() + 100);
+      REQUIRE(const_it > values.cbegin());
+    }
+
+    WHEN("It is copied")
+    {
+      auto copy = values;
+
+      THEN("The copy has the same elements in storage of its own")
+      {
+        REQUIRE(std::equal(copy.begin(), copy.end(), values.begin(), values.end()));
+        REQUIRE(&copy[0] != &values[0]);
+      }
+    }
+
+    WHEN("It is moved")
+    {
+      const auto* first = &values[0];
+      auto moved = std::move(values);
+
+      THEN("The blocks change hands")
+      {
+        REQUIRE(moved.size() == 5000_z);
+        REQUIRE(&moved[0] == first);
+        REQUIRE(values.empty());
+        values.push_back(1);
+        REQUIRE(values.front() == 1);
+      }
+    }
+  }
+
+  GIVEN("A vector used as a queue through an InstrumentedAllocator")
+  {
+    AllocationSite site{"stable_vector_test"};
+    {
+      StableVector<std::int64_t, InstrumentedAllocator<std::int64_t>> queue{
+        InstrumentedAllocator<std::int64_t>{site}};
+      constexpr auto BlockSize = decltype(queue)::BlockSize;
+
+      std::int64_t next = 0;
+      for (std::size_t i = 0; i < 100 * BlockSize; ++i)
+      {
+        queue.push_back(static_cast<std::int64_t>(i));
+        if (queue.size() > BlockSize / 2)
+        {
+          REQUIRE(queue.front() == next++);
+          queue.pop_front();
+        }
+      }
+
+      THEN("The blocks it drifts through are reused rather than accumulated")
+      {
+        REQUIRE(queue.size() == BlockSize / 2);
+        REQUIRE(site.snapshot().peak_live_bytes <
+                static_cast<std::int64_t>(4 * BlockSize * sizeof(std::int64_t) + 1024));
+      }
+    }
+
+    THEN("Everything is freed")
+    {
+      REQUIRE(site.snapshot().live_bytes == 0);
+    }
+  }
+
+  GIVEN("Vectors with stateful allocators that do not propagate on move")
+  {
+    StableVector<std::int32_t, PropagatingAllocator<std::int32_t>> lhs{
+      {1, 2, 3}, PropagatingAllocator<std::int32_t>{1}};
+    StableVector<std::int32_t, PropagatingAllocator<std::int32_t>> rhs{
+      {4, 5}, PropagatingAllocator<std::int32_t>{2}};
+
+    WHEN("One is move assigned to the other")
+    {
+      lhs = std::move(rhs);
+
+      THEN("The elements are moved one at a time")
+      {
+        REQUIRE(lhs.size() == 2_z);
+        REQUIRE(lhs[1] == 5);
+        REQUIRE(rhs.empty());
+      }
+    }
+
+    WHEN("One is copy assigned to the other")
+    {
+      lhs = rhs;
+
+      THEN("It holds copies of the other's elements")
+      {
+        REQUIRE(lhs.size() == 2_z);
+        REQUIRE(lhs[0] == 4);
+        REQUIRE(rhs.size() == 2_z);
+      }
+    }
+  }
+
+  GIVEN("Elements whose copy constructor can throw")
+  {
+    StableVector<ThrowingCopy> values;
+    const ThrowingCopy value{7};
+    values.push_back(value);
+
+    WHEN("A copy throws while pushing at either end")
+    {
+      ThrowingCopy::reset(1);
+      REQUIRE_THROWS_AS(values.push_back(value), std::runtime_error);
+      ThrowingCopy::reset(1);
+      REQUIRE_THROWS_AS(values.push_front(value), std::runtime_error);
+      ThrowingCopy::reset(std::numeric_limits<std::size_t>::max());
+
+      THEN("The vector is unchanged")
+      {
+        REQUIRE(values.size() == 1_z);
+        REQUIRE(values.front() == value);
+      }
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include <catch2/catch_all.hpp>
+
+#include "container_families.h"
+#include "small_vector.h"
+#include "vector.h"
+#include "vector_algorithms.h"
+
+using namespace CppTraining;
+
+TEMPLATE_TEST_CASE("Searching a Vector<T>",
+                   "[Vector][simd]",
+                   VectorFamily,
+                   SmallVectorFamily<2>,
+                   SmallVectorFamily<8>)
+{
+  using IntVector = typename TestType::template container<std::int32_t>;
+  using StringVector = typename TestType::template container<std::string>;
+
+  GIVEN("A vector of integers, long enough for several vectors of lanes")
+  {
+    IntVector values;
+    for (std::int32_t i = 0; i < 101; ++i)
+    {
+      values.push_back(i % 10);
+    }
+    values[57] = -4;
+    values[90] = 30;
+
+    THEN("find returns the first match, or end()")
+    {
+      REQUIRE(find(values, 7) == values.begin() + 7);
+      REQUIRE(find(values, -4) == values.begin() + 57);
+      REQUIRE(find(values, 11) == values.end());
+
+      const IntVector& const_values = values;
+      REQUIRE(find(const_values, 30) == const_values.begin() + 90);
+    }
+
+    THEN("count and contains agree with the elements")
+    {
+      REQUIRE(count(values, 3) == 10);
+      REQUIRE(count(values, 7) == 9);
+      REQUIRE(count(values, 11) == 0);
+      REQUIRE(contains(values, 30));
+      REQUIRE_FALSE(contains(values, 31));
+    }
+
+    THEN("min_element and max_element return the extreme elements")
+    {
+      REQUIRE(min_element(values) == values.begin() + 57);
+      REQUIRE(max_element(values) == values.begin() + 90);
+    }
+
+    THEN("An iterator from find can modify the element")
+    {
+      *find(values, -4) = 100;
+      REQUIRE(max_element(values) == values.begin() + 57);
+    }
+
+    THEN("A copy is equal until one of its elements changes")
+    {
+      auto copy = values;
+      REQUIRE(copy == values);
+
+      copy.back() = 12;
+      REQUIRE(copy != values);
+
+      copy.pop_back();
+      REQUIRE(copy != values);
+    }
+  }
+
+  GIVEN("An empty vector")
+  {
+    IntVector values;
+
+    THEN("Every search comes back empty-handed")
+    {
+      REQUIRE(find(values, 0) == values.end());
+      REQUIRE(count(values, 0) == 0);
+      REQUIRE(min_element(values) == values.end());
+      REQUIRE(max_element(values) == values.end());
+      REQUIRE(values == IntVector{});
+    }
+  }
+
+  GIVEN("A vector of strings, which the SIMD kernels do not handle")
+  {
+    StringVector values{"pear", "apple", "fig", "apple"};
+
+    THEN("The searches fall back to the standard algorithms")
+    {
+      REQUIRE(find(values, "apple") == values.begin() + 1);
+      REQUIRE(count(values, "apple") == 2);
+      REQUIRE(contains(values, "fig"));
+      REQUIRE(min_element(values) == values.begin() + 1);
+      REQUIRE(max_element(values) == values.begin());
+      REQUIRE(values == StringVector{"pear", "apple", "fig", "apple"});
+      REQUIRE(values != StringVector{"pear", "apple", "fig", "plum"});
+    }
+  }
+}
+
+TEST_CASE("Vector<double> comparisons treat NaN as unequal to everything", "[Vector][simd]")
+{
+  const auto nan = std::numeric_limits<double>::quiet_NaN();
+  const Vector<double> values{1.0, nan, 3.0};
+
+  REQUIRE_FALSE(contains(values, nan));
+  REQUIRE(count(values, nan) == 0);
+  REQUIRE(values != values);
+  REQUIRE(max_element(values) == values.begin() + 2);
+}
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <catch2/catch_all.hpp>
+
+#include "literal_operators.h"
+#include "vector.h"
+#include "vector_snapshot.h"
+
+using namespace CppTraining;
+
+namespace
+{
+struct Quote
+{
+  std::int64_t instrument;
+  double bid;
+  double ask;
+};
+
+struct alignas(128) Line
+{
+  std::uint8_t bytes[128];
+};
+
+std::string temporaryPath(const char* name)
+{
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/// @brief Overwrites one byte of a file in place.
+void corruptByte(const std::string& path, std::size_t offset)
+{
+  std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+  file.seekg(static_cast<std::streamoff>(offset));
+  const auto byte = static_cast<char>(file.get() ^ 0x5a);
+  file.seekp(static_cast<std::streamoff>(offset));
+  file.put(byte);
+}
+} // namespace
+
+SCENARIO("Saving and loading Vector snapshots", "[vector_snapshot]")
+{
+  const auto path = temporaryPath("cpp_training_vector_snapshot_test.bin");
+
+  GIVEN("A snapshot of a vector of structs")
+  {
+    Vector<Quote> quotes;
+    for (std::int64_t i = 0; i < 300'000; ++i)
+    {
+      const auto price = 100.0 + static_cast<double>(i % 17);
+      quotes.push_back(Quote{i, price, price + 0.5});
+    }
+    save(path, quotes);
+
+    WHEN("It is loaded as a view")
+    {
+      const auto view = load_view<Quote>(path);
+
+      THEN("The view holds the same elements, in the mapping")
+      {
+        REQUIRE(view.size() == quotes.size());
+        REQUIRE(view.span().size() == quotes.size());
+        REQUIRE(view[123'456].instrument == 123'456);
+        REQUIRE(std::equal(
+          view.begin(), view.end(), quotes.begin(), [](const auto& lhs, const auto& rhs) {
+            return lhs.instrument == rhs.instrument && lhs.bid == rhs.bid && lhs.ask == rhs.ask;
+          }));
+        REQUIRE(view.data() != quotes.data());
+      }
+    }
+
+    WHEN("It is replaced by a snapshot of fewer elements")
+    {
+      quotes.resize(10);
+      save(path, quotes);
+
+      THEN("The new snapshot is loaded, and no temporary file is left behind")
+      {
+        REQUIRE(load_view<Quote>(path).size() == 10_z);
+        REQUIRE_FALSE(std::filesystem::exists(path + ".tmp"));
+      }
+    }
+
+    WHEN("A byte of the payload is corrupted")
+    {
+      corruptByte(path, 64 + 1'000'000);
+
+      THEN("Loading it with the checksum check throws")
+      {
+        REQUIRE_THROWS_AS(load_view<Quote>(path), std::runtime_error);
+      }
+
+      THEN("Loading it without the check does not look at the payload")
+      {
+        REQUIRE(load_view<Quote>(path, SnapshotCheck::HeaderOnly).size() == quotes.size());
+      }
+    }
+
+    WHEN("The file is cut short")
+    {
+      std::filesystem::resize_file(path, 64 + 1000);
+
+      THEN("Loading it throws")
+      {
+        REQUIRE_THROWS_AS(load_view<Quote>(path, SnapshotCheck::HeaderOnly), std::runtime_error);
+      }
+    }
+
+    THEN("Loading it as another element type throws")
+    {
+      REQUIRE_THROWS_AS(load_view<std::int64_t>(path), std::runtime_error);
+      REQUIRE_THROWS_AS(load_view<Line>(path), std::runtime_error);
+    }
+  }
+
+  GIVEN("A snapshot of an empty vector")
+  {
+    save(path, Vector<double>{});
+
+    THEN("It loads as an empty view")
+    {
+      const auto view = load_view<double>(path);
+      REQUIRE(view.empty());
+      REQUIRE(view.begin() == view.end());
+    }
+  }
+
+  GIVEN("A snapshot of over-aligned elements")
+  {
+    Vector<Line> lines;
+    lines.resize(3);
+    lines[2].bytes[127] = 42;
+    save(path, lines);
+
+    THEN("The payload is aligned in the mapping")
+    {
+      const auto view = load_view<Line>(path);
+      REQUIRE(reinterpret_cast<std::uintptr_t>(view.data()) % alignof(Line) == 0);
+      REQUIRE(view[2].bytes[127] == 42);
+    }
+  }
+
+  GIVEN("A file that is not a snapshot")
+  {
+    std::ofstream{path} << std::string(4096, 'x');
+
+    THEN("Loading it throws")
+    {
+      REQUIRE_THROWS_AS(load_view<double>(path), std::runtime_error);
+    }
+  }
+
+  GIVEN("No file at all")
+  {
+    std::remove(path.c_str());
+
+    THEN("Loading throws a system error")
+    {
+      REQUIRE_THROWS_AS(load_view<double>(path), std::system_error);
+    }
+  }
+
+  std::remove(path.c_str());
+}
@@ -1,16 +1,172 @@
 #include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch_all.hpp>
+#include <gsl/span>
 
+#include "bar.h"
+#include "container_families.h"
 #include "foo.h"
+#include "malloc_allocator.h"
 #include "propogating_allocator.h"
+#include "small_vector.h"
 #include "throwing_copy.h"
 #include "vector.h"
 
 using namespace CppTraining;
 
-SCENARIO("Exercising Vector<T>", "[vector]")
+namespace
 {
+/// @brief Counts the moves and destructions that happen while a Vector relocates its elements.
+template <bool Relocatable>
+class RelocationCounter final
+{
+public:
+  explicit RelocationCounter(std::int32_t value) : value_{value} {}
+  RelocationCounter(const RelocationCounter&) = default;
+  RelocationCounter(RelocationCounter&& other) noexcept : value_{other.value_} { ++move_count; }
+  RelocationCounter& operator=(const RelocationCounter&) = default;
+  RelocationCounter& operator=(RelocationCounter&&) noexcept = default;
+  ~RelocationCounter() { ++destruction_count; }
+
+  std::int32_t getData() const { return value_; }
+
+  static void reset()
+  {
+    move_count = 0_z;
+    destruction_count = 0_z;
+  }
+
+  static inline std::size_t move_count{0_z};
+  static inline std::size_t destruction_count{0_z};
+
+private:
+  std::int32_t value_;
+};
+
+/// @brief An element whose move constructor may throw, so that Vector has to copy it to keep the
+/// strong exception guarantee while relocating. The copy chosen by reset() throws.
+class ThrowingMove final
+{
+public:
+  explicit ThrowingMove(std::int32_t value) : value_{value} {}
+  ThrowingMove(const ThrowingMove& other) : value_{other.value_}
+  {
+    if (++copy_count == throw_on_copy)
+    {
+      throw std::runtime_error("Simulated copy failure");
+    }
+  }
+  ThrowingMove(ThrowingMove&& other) : value_{other.value_} { ++move_count; }
+  ThrowingMove& operator=(const ThrowingMove&) = default;
+  ThrowingMove& operator=(ThrowingMove&&) = default;
+  ~ThrowingMove() = default;
+
+  std::int32_t getData() const { return value_; }
+
+  static void reset(std::size_t throw_on = 0_z)
+  {
+    copy_count = 0_z;
+    move_count = 0_z;
+    throw_on_copy = throw_on;
+  }
+
+  static inline std::size_t copy_count{0_z};
+  static inline std::size_t move_count{0_z};
+  static inline std::size_t throw_on_copy{0_z};
+
+private:
+  std::int32_t value_;
+};
+
+/// @brief Malloc-backed allocator that records which allocator extensions Vector calls.
+template <typename T>
+class RecordingAllocator final
+{
+public:
+  using value_type = T;
+
+  RecordingAllocator() = default;
+  template <class U>
+  RecordingAllocator(const RecordingAllocator<U>&) noexcept
+  {
+  }
+
+  T* allocate(std::size_t n)
+  {
+    ++allocations;
+    return MallocAllocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, std::size_t n) noexcept { MallocAllocator<T>{}.deallocate(p, n); }
+
+  T* reallocate(T* p, std::size_t old_count, std::size_t new_count)
+  {
+    ++reallocations;
+    return MallocAllocator<T>{}.reallocate(p, old_count, new_count);
+  }
+
+  bool expand_in_place(T*, std::size_t, std::size_t new_count) noexcept
+  {
+    ++expansion_attempts;
+    return new_count <= expandable_count;
+  }
+
+  static void reset(std::size_t expandable)
+  {
+    allocations = 0_z;
+    reallocations = 0_z;
+    expansion_attempts = 0_z;
+    expandable_count = expandable;
+  }
+
+  static inline std::size_t allocations{0_z};
+  static inline std::size_t reallocations{0_z};
+  static inline std::size_t expansion_attempts{0_z};
+  static inline std::size_t expandable_count{0_z};
+};
+
+template <typename T, typename U>
+bool operator==(const RecordingAllocator<T>&, const RecordingAllocator<U>&) noexcept
+{
+  return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const RecordingAllocator<T>&, const RecordingAllocator<U>&) noexcept
+{
+  return false;
+}
+} // namespace
+
+namespace CppTraining
+{
+template <>
+struct is_trivially_relocatable<RelocationCounter<true>> : std::true_type
+{
+};
+} // namespace CppTraining
+
+TEMPLATE_TEST_CASE("Exercising Vector<T>",
+                   "[vector]",
+                   VectorFamily,
+                   SmallVectorFamily<2>,
+                   SmallVectorFamily<8>)
+{
+  using FooVector = typename TestType::template container<Foo>;
+  using PropagatingFooVector =
+    typename TestType::template container<Foo, PropagatingAllocator<Foo>>;
+  using ThrowingCopyVector = typename TestType::template container<ThrowingCopy>;
+
   GIVEN("An empty vector<Foo>")
   {
     const Foo a{1};
@@ -18,13 +174,13 @@ SCENARIO("Exercising Vector<T>", "[vector]")
     const Foo c{3};
     const Foo d{4};
 
-    Vector<Foo> values;
+    FooVector values;
 
     THEN("It is empty")
     {
       REQUIRE(values.empty());
       REQUIRE(values.size() == 0_z);
-      REQUIRE(values.capacity() == 0_z);
+      REQUIRE(values.capacity() == FooVector::inline_capacity);
     }
 
     WHEN("We reserve space for 10 elements")
@@ -135,11 +291,11 @@ SCENARIO("Exercising Vector<T>", "[vector]")
     {
       values.shrink_to_fit();
 
-      THEN("It is empty and capacity is zero")
+      THEN("It is empty and capacity is back to the inline capacity")
       {
         REQUIRE(values.empty());
         REQUIRE(values.size() == 0_z);
-        REQUIRE(values.capacity() == 0_z);
+        REQUIRE(values.capacity() == FooVector::inline_capacity);
       }
     }
 
@@ -268,7 +424,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
       values.push_back(b);
       values.push_back(c);
 
-      Vector<Foo> other{values};
+      FooVector other{values};
 
       THEN("The copy has the same size and elements")
       {
@@ -284,14 +440,14 @@ SCENARIO("Exercising Vector<T>", "[vector]")
     WHEN("The copy constructor triggers an exception")
     {
       ThrowingCopy::reset(3_z);
-      Vector<ThrowingCopy> vector;
+      ThrowingCopyVector vector;
       vector.emplace_back(1);
       vector.emplace_back(2);
       vector.emplace_back(3);
 
       THEN("It throws an exception as expected")
       {
-        REQUIRE_THROWS_AS(Vector<ThrowingCopy>{vector}, std::runtime_error);
+        REQUIRE_THROWS_AS(ThrowingCopyVector{vector}, std::runtime_error);
       }
     }
 
@@ -301,7 +457,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
       values.push_back(b);
       values.push_back(c);
 
-      Vector<Foo> other;
+      FooVector other;
       other.push_back(d);
 
       other = values;
@@ -322,7 +478,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
       values.push_back(b);
       values.push_back(c);
 
-      Vector<Foo> other;
+      FooVector other;
 
       other = values;
 
@@ -343,7 +499,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
       values.push_back(b);
       values.push_back(c);
 
-      Vector<Foo> other;
+      FooVector other;
       other.push_back(d);
 
       other = values;
@@ -378,8 +534,8 @@ SCENARIO("Exercising Vector<T>", "[vector]")
 
     WHEN("We assignment triggers allocator replacement")
     {
-      Vector<Foo, PropagatingAllocator<Foo>> vector1{0_z, PropagatingAllocator<Foo>{1}};
-      Vector<Foo, PropagatingAllocator<Foo>> vector2{0_z, PropagatingAllocator<Foo>{2}};
+      PropagatingFooVector vector1{0_z, PropagatingAllocator<Foo>{1}};
+      PropagatingFooVector vector2{0_z, PropagatingAllocator<Foo>{2}};
 
       vector1.emplace_back(a);
       vector1.emplace_back(b);
@@ -404,7 +560,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
       values.push_back(b);
       values.push_back(c);
 
-      Vector<Foo> other{std::move(values)};
+      FooVector other{std::move(values)};
 
       THEN("The moved vector has the same size and elements, and original is empty")
       {
@@ -422,7 +578,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
       values.push_back(b);
       values.push_back(c);
 
-      Vector<Foo> other;
+      FooVector other;
       other = std::move(values);
 
       THEN("The moved vector has the same size and elements, and original is empty")
@@ -441,7 +597,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
       values.push_back(b);
       values.push_back(c);
 
-      Vector<Foo> other;
+      FooVector other;
       other.push_back(d);
 
       other = std::move(values);
@@ -458,8 +614,8 @@ SCENARIO("Exercising Vector<T>", "[vector]")
 
     WHEN("We move assign vectors with non-propagating allocator and allocator IDs differ")
     {
-      Vector<Foo, PropagatingAllocator<Foo>> lhs{0_z, PropagatingAllocator<Foo>{1}};
-      Vector<Foo, PropagatingAllocator<Foo>> rhs{0_z, PropagatingAllocator<Foo>{2}};
+      PropagatingFooVector lhs{0_z, PropagatingAllocator<Foo>{1}};
+      PropagatingFooVector rhs{0_z, PropagatingAllocator<Foo>{2}};
 
       rhs.emplace_back(a);
       rhs.emplace_back(b);
@@ -473,13 +629,19 @@ SCENARIO("Exercising Vector<T>", "[vector]")
         REQUIRE(lhs.at(0) == a);
         REQUIRE(lhs.at(1) == b);
       }
+
+      THEN("rhs is left empty, having returned its block to its own allocator")
+      {
+        REQUIRE(rhs.empty());
+        REQUIRE(rhs.capacity() == PropagatingFooVector::inline_capacity);
+      }
     }
 
     WHEN("We move assign vectors with non-propagating allocator and allocator IDs are equal")
     {
       PropagatingAllocator<Foo> allocator{42};
-      Vector<Foo, PropagatingAllocator<Foo>> lhs{0_z, allocator};
-      Vector<Foo, PropagatingAllocator<Foo>> rhs{0_z, allocator};
+      PropagatingFooVector lhs{0_z, allocator};
+      PropagatingFooVector rhs{0_z, allocator};
 
       rhs.emplace_back(a);
       rhs.emplace_back(b);
@@ -496,7 +658,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
 
     WHEN("We swap two vectors")
     {
-      Vector<Foo> other;
+      FooVector other;
       other.push_back(a);
       other.push_back(b);
 
@@ -514,8 +676,8 @@ SCENARIO("Exercising Vector<T>", "[vector]")
 
     WHEN("We swap two vectors with a propogating allocator")
     {
-      Vector<Foo, PropagatingAllocator<Foo>> vector1{a, b, c};
-      Vector<Foo, PropagatingAllocator<Foo>> vector2;
+      PropagatingFooVector vector1{a, b, c};
+      PropagatingFooVector vector2;
 
       swap(vector1, vector2);
 
@@ -550,7 +712,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
       values.push_back(b);
       values.push_back(c);
 
-      const Vector<Foo>& const_ref = values;
+      const FooVector& const_ref = values;
 
       THEN("We can retrieve size, capacity, and check emptiness")
       {
@@ -575,7 +737,7 @@ SCENARIO("Exercising Vector<T>", "[vector]")
 
     WHEN("We construct the vector from an initializer list")
     {
-      Vector<Foo> values{a, b, c};
+      FooVector values{a, b, c};
 
       THEN("The size is correct and all elements are in order")
       {
@@ -588,6 +750,1119 @@ SCENARIO("Exercising Vector<T>", "[vector]")
   }
 }
 
+TEMPLATE_TEST_CASE("Vector relocates elements on reserve and shrink_to_fit",
+                   "[vector]",
+                   RelocationCounter<true>,
+                   RelocationCounter<false>)
+{
+  constexpr bool relocatable = is_trivially_relocatable_v<TestType>;
+
+  Vector<TestType> values;
+  values.emplace_back(1);
+  values.emplace_back(2);
+  values.emplace_back(3);
+
+  TestType::reset();
+
+  SECTION("Growing with reserve preserves the elements")
+  {
+    values.reserve(100_z);
+
+    REQUIRE(values.capacity() == 100_z);
+    REQUIRE(values.at(0).getData() == 1);
+    REQUIRE(values.at(1).getData() == 2);
+    REQUIRE(values.at(2).getData() == 3);
+    REQUIRE(TestType::move_count == (relocatable ? 0_z : 3_z));
+    REQUIRE(TestType::destruction_count == (relocatable ? 0_z : 3_z));
+  }
+
+  SECTION("Shrinking with shrink_to_fit preserves the elements")
+  {
+    values.reserve(100_z);
+    TestType::reset();
+    values.shrink_to_fit();
+
+    REQUIRE(values.capacity() == 3_z);
+    REQUIRE(values.at(0).getData() == 1);
+    REQUIRE(values.at(2).getData() == 3);
+    REQUIRE(TestType::move_count == (relocatable ? 0_z : 3_z));
+    REQUIRE(TestType::destruction_count == (relocatable ? 0_z : 3_z));
+  }
+}
+
+TEMPLATE_TEST_CASE("Vector of move-only elements",
+                   "[vector]",
+                   VectorFamily,
+                   SmallVectorFamily<2>,
+                   SmallVectorFamily<8>)
+{
+  using PointerVector = typename TestType::template container<std::unique_ptr<std::int32_t>>;
+  using BarVector = typename TestType::template container<Bar>;
+
+  GIVEN("A vector of five unique_ptrs")
+  {
+    PointerVector values;
+    for (std::int32_t i = 0; i < 5; ++i)
+    {
+      values.push_back(std::make_unique<std::int32_t>(i));
+    }
+
+    auto requireValues = [](const PointerVector& pointers) {
+      REQUIRE(pointers.size() == 5_z);
+      for (std::int32_t i = 0; i < 5; ++i)
+      {
+        REQUIRE(*pointers[static_cast<std::size_t>(i)] == i);
+      }
+    };
+
+    WHEN("It grows and shrinks")
+    {
+      values.reserve(100_z);
+      requireValues(values);
+      values.shrink_to_fit();
+
+      THEN("The elements move along")
+      {
+        requireValues(values);
+        REQUIRE(values.capacity() == std::max<std::size_t>(5_z, PointerVector::inline_capacity));
+      }
+    }
+
+    WHEN("It is move constructed")
+    {
+      PointerVector other{std::move(values)};
+
+      THEN("The elements belong to the new vector")
+      {
+        requireValues(other);
+        REQUIRE(values.empty());
+      }
+    }
+
+    WHEN("It is move assigned over a vector with elements")
+    {
+      PointerVector other;
+      other.push_back(std::make_unique<std::int32_t>(42));
+      other = std::move(values);
+
+      THEN("The elements belong to the assigned vector")
+      {
+        requireValues(other);
+        REQUIRE(values.empty());
+      }
+    }
+
+    WHEN("It is swapped with a shorter vector")
+    {
+      PointerVector other;
+      other.push_back(std::make_unique<std::int32_t>(42));
+      swap(values, other);
+
+      THEN("The elements change places")
+      {
+        requireValues(other);
+        REQUIRE(values.size() == 1_z);
+        REQUIRE(*values[0] == 42);
+      }
+    }
+
+    WHEN("It is resized")
+    {
+      values.resize(2_z);
+      values.resize(4_z);
+
+      THEN("The new elements are value-initialized")
+      {
+        REQUIRE(*values[1] == 1);
+        REQUIRE(values[2] == nullptr);
+        REQUIRE(values[3] == nullptr);
+      }
+    }
+  }
+
+  GIVEN("A vector of Bar")
+  {
+    BarVector values;
+    for (std::size_t i = 0_z; i < 20_z; ++i)
+    {
+      values.emplace_back();
+    }
+    values.pop_back();
+
+    THEN("It grows like any other vector")
+    {
+      REQUIRE(values.size() == 19_z);
+      REQUIRE(values.capacity() >= 19_z);
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Vector keeps the strong guarantee while relocating",
+                   "[vector]",
+                   VectorFamily,
+                   SmallVectorFamily<2>,
+                   SmallVectorFamily<8>)
+{
+  using ThrowingMoveVector = typename TestType::template container<ThrowingMove>;
+  using ThrowingCopyVector = typename TestType::template container<ThrowingCopy>;
+
+  GIVEN("A full vector of elements whose move may throw")
+  {
+    ThrowingMove::reset();
+    ThrowingMoveVector values;
+    for (std::int32_t i = 0; i < 10; ++i)
+    {
+      values.emplace_back(i);
+    }
+    values.shrink_to_fit();
+
+    auto requireUnchanged = [&values] {
+      REQUIRE(values.size() == 10_z);
+      REQUIRE(values.capacity() == 10_z);
+      for (std::int32_t i = 0; i < 10; ++i)
+      {
+        REQUIRE(values[static_cast<std::size_t>(i)].getData() == i);
+      }
+    };
+
+    WHEN("It grows")
+    {
+      ThrowingMove::reset();
+      values.reserve(20_z);
+
+      THEN("The elements are copied rather than moved")
+      {
+        REQUIRE(ThrowingMove::copy_count == 10_z);
+        REQUIRE(ThrowingMove::move_count == 0_z);
+        REQUIRE(values.capacity() == 20_z);
+      }
+    }
+
+    WHEN("A copy throws while it grows")
+    {
+      ThrowingMove::reset(4_z);
+
+      THEN("The vector is unchanged")
+      {
+        REQUIRE_THROWS_AS(values.reserve(20_z), std::runtime_error);
+        requireUnchanged();
+      }
+    }
+
+    WHEN("A copy throws while it regrows in emplace_back")
+    {
+      ThrowingMove::reset(10_z);
+
+      THEN("The vector is unchanged")
+      {
+        REQUIRE_THROWS_AS(values.emplace_back(10), std::runtime_error);
+        requireUnchanged();
+      }
+    }
+
+    WHEN("A copy throws while it shrinks")
+    {
+      values.pop_back();
+      ThrowingMove::reset(9_z);
+
+      THEN("The vector is unchanged")
+      {
+        REQUIRE_THROWS_AS(values.shrink_to_fit(), std::runtime_error);
+        REQUIRE(values.size() == 9_z);
+        REQUIRE(values.capacity() == 10_z);
+        REQUIRE(values.back().getData() == 8);
+      }
+    }
+  }
+
+  GIVEN("A vector of elements whose copies may throw but whose moves cannot")
+  {
+    ThrowingCopy::reset(1_z);
+    ThrowingCopyVector values;
+    for (std::int32_t i = 0; i < 10; ++i)
+    {
+      values.emplace_back(i);
+    }
+
+    WHEN("It grows")
+    {
+      THEN("Nothing is copied")
+      {
+        REQUIRE_NOTHROW(values.reserve(100_z));
+        REQUIRE_NOTHROW(values.shrink_to_fit());
+        REQUIRE(values.size() == 10_z);
+      }
+    }
+
+    WHEN("It is copied and a copy throws")
+    {
+      ThrowingCopy::reset(6_z);
+
+      THEN("The source is unchanged")
+      {
+        REQUIRE_THROWS_AS(ThrowingCopyVector{values}, std::runtime_error);
+        REQUIRE(values.size() == 10_z);
+        REQUIRE(values.back().getData() == 9);
+      }
+    }
+
+    WHEN("It is copy assigned and a copy throws")
+    {
+      ThrowingCopyVector other;
+      other.emplace_back(42);
+      ThrowingCopy::reset(6_z);
+
+      THEN("The assigned vector is left empty")
+      {
+        REQUIRE_THROWS_AS(other = values, std::runtime_error);
+        REQUIRE(other.empty());
+        REQUIRE(values.size() == 10_z);
+      }
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Inserting into and erasing from Vector<T>",
+                   "[vector]",
+                   VectorFamily,
+                   SmallVectorFamily<2>,
+                   SmallVectorFamily<8>)
+{
+  using IntVector = typename TestType::template container<std::int32_t>;
+  using StringVector = typename TestType::template container<std::string>;
+  using RecordingVector =
+    typename TestType::template container<std::int32_t, RecordingAllocator<std::int32_t>>;
+  using ThrowingMoveVector = typename TestType::template container<ThrowingMove>;
+
+  auto contents = [](const auto& values) {
+    using value_type = typename std::decay_t<decltype(values)>::value_type;
+    return std::vector<value_type>(values.begin(), values.end());
+  };
+
+  GIVEN("A vector of five integers")
+  {
+    IntVector values{0, 1, 2, 3, 4};
+
+    WHEN("Single elements are inserted at the front, middle and back")
+    {
+      auto front = values.insert(values.begin(), -1);
+      REQUIRE(*front == -1);
+      auto middle = values.insert(values.begin() + 3, 42);
+      REQUIRE(*middle == 42);
+      auto back = values.insert(values.end(), 5);
+      REQUIRE(*back == 5);
+
+      THEN("The other elements keep their order")
+      {
+        REQUIRE(contents(values) == std::vector<std::int32_t>{-1, 0, 1, 42, 2, 3, 4, 5});
+      }
+    }
+
+    WHEN("One of its own elements is inserted")
+    {
+      values.shrink_to_fit();
+      values.insert(values.begin(), values[4]);
+      values.insert(values.begin(), values[5]);
+
+      THEN("The value is read before the elements shift")
+      {
+        REQUIRE(contents(values) == std::vector<std::int32_t>{4, 4, 0, 1, 2, 3, 4});
+      }
+    }
+
+    WHEN("Several copies of a value are inserted")
+    {
+      values.insert(values.begin() + 1, 3_z, values[0]);
+      values.insert(values.end(), 0_z, 7);
+
+      THEN("They appear together")
+      {
+        REQUIRE(contents(values) == std::vector<std::int32_t>{0, 0, 0, 0, 1, 2, 3, 4});
+      }
+    }
+
+    WHEN("Ranges are inserted")
+    {
+      const std::vector<std::int32_t> more{10, 11, 12};
+      std::istringstream stream{"20 21"};
+
+      auto first = values.insert(values.begin() + 2, more.begin(), more.end());
+      REQUIRE(*first == 10);
+      values.insert(values.end(),
+                    std::istream_iterator<std::int32_t>{stream},
+                    std::istream_iterator<std::int32_t>{});
+      values.insert(values.begin(), {-2, -1});
+
+      THEN("Each range lands at its position")
+      {
+        REQUIRE(contents(values) ==
+                std::vector<std::int32_t>{-2, -1, 0, 1, 10, 11, 12, 2, 3, 4, 20, 21});
+      }
+    }
+
+    WHEN("An element is emplaced in the middle")
+    {
+      auto it = values.emplace(values.begin() + 1, 9);
+
+      THEN("It is constructed in place")
+      {
+        REQUIRE(*it == 9);
+        REQUIRE(contents(values) == std::vector<std::int32_t>{0, 9, 1, 2, 3, 4});
+      }
+    }
+
+    WHEN("Elements are erased")
+    {
+      auto next = values.erase(values.begin() + 1);
+      REQUIRE(*next == 2);
+      next = values.erase(values.begin() + 1, values.begin() + 3);
+      REQUIRE(*next == 4);
+      next = values.erase(values.begin(), values.begin());
+      REQUIRE(*next == 0);
+
+      THEN("The rest close up")
+      {
+        REQUIRE(contents(values) == std::vector<std::int32_t>{0, 4});
+      }
+
+      THEN("Erasing at the end is out of range")
+      {
+        REQUIRE_THROWS_AS(values.erase(values.end()), std::out_of_range);
+      }
+    }
+
+    WHEN("Elements are erased by value and by predicate")
+    {
+      values.insert(values.end(), {2, 2});
+      const auto erased_twos = erase(values, 2);
+      const auto erased_odd = erase_if(values, [](std::int32_t value) { return value % 2 != 0; });
+
+      THEN("The counts and the survivors are right")
+      {
+        REQUIRE(erased_twos == 3_z);
+        REQUIRE(erased_odd == 2_z);
+        REQUIRE(contents(values) == std::vector<std::int32_t>{0, 4});
+      }
+    }
+
+#if !defined(CPP_TRAINING_UNCHECKED_ITERATORS)
+    WHEN("An iterator from another vector is used")
+    {
+      IntVector other{1};
+
+      THEN("The insertion is rejected")
+      {
+        REQUIRE_THROWS_AS(values.insert(other.begin(), 1), std::runtime_error);
+        REQUIRE_THROWS_AS(values.erase(other.begin()), std::runtime_error);
+      }
+    }
+#endif
+  }
+
+  GIVEN("A vector of strings")
+  {
+    StringVector values{"a", "b", "c"};
+
+    WHEN("Strings are inserted and erased in the middle")
+    {
+      values.insert(values.begin() + 1, {"x", "y"});
+      values.emplace(values.begin(), 3_z, 'z');
+      values.erase(values.begin() + 2);
+
+      THEN("The elements shift without losing their contents")
+      {
+        REQUIRE(contents(values) == std::vector<std::string>{"zzz", "a", "y", "b", "c"});
+      }
+    }
+
+    WHEN("One of its own elements is inserted at the end of a full vector")
+    {
+      values[0] = std::string(40, 'a');
+      while (values.size() < values.capacity())
+      {
+        values.push_back("filler");
+      }
+      const auto size = values.size();
+      values.insert(values.end(), values[0]);
+
+      THEN("The value is copied before the elements are relocated")
+      {
+        REQUIRE(values.size() == size + 1);
+        REQUIRE(values.back() == std::string(40, 'a'));
+        REQUIRE(values[0] == std::string(40, 'a'));
+      }
+    }
+  }
+
+  GIVEN("A vector with an allocator that counts allocations")
+  {
+    RecordingAllocator<std::int32_t>::reset(0_z);
+    RecordingVector values;
+    values.push_back(1);
+    values.push_back(2);
+
+    WHEN("A large range is inserted")
+    {
+      const auto allocations = RecordingAllocator<std::int32_t>::allocations;
+      const std::vector<std::int32_t> more(100, 7);
+      values.insert(values.begin() + 1, more.begin(), more.end());
+
+      THEN("The vector reallocates once")
+      {
+        REQUIRE(RecordingAllocator<std::int32_t>::allocations == allocations + 1_z);
+        REQUIRE(values.size() == 102_z);
+        REQUIRE(values.back() == 2);
+      }
+    }
+  }
+
+  GIVEN("A vector of elements whose move may throw")
+  {
+    ThrowingMove::reset();
+    ThrowingMoveVector values;
+    for (std::int32_t i = 0; i < 4; ++i)
+    {
+      values.emplace_back(i);
+    }
+    values.reserve(10_z);
+
+    WHEN("A copy throws during an insertion")
+    {
+      ThrowingMove::reset(3_z);
+
+      THEN("The vector is unchanged")
+      {
+        REQUIRE_THROWS_AS(values.insert(values.begin() + 1, ThrowingMove{9}), std::runtime_error);
+        REQUIRE(values.size() == 4_z);
+        for (std::int32_t i = 0; i < 4; ++i)
+        {
+          REQUIRE(values[static_cast<std::size_t>(i)].getData() == i);
+        }
+      }
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Building Vector<T> from ranges",
+                   "[vector]",
+                   VectorFamily,
+                   SmallVectorFamily<2>,
+                   SmallVectorFamily<8>)
+{
+  using IntVector = typename TestType::template container<std::int32_t>;
+  using StringVector = typename TestType::template container<std::string>;
+  using RecordingVector =
+    typename TestType::template container<std::int32_t, RecordingAllocator<std::int32_t>>;
+  using ThrowingMoveVector = typename TestType::template container<ThrowingMove>;
+
+  auto contents = [](const auto& values) {
+    using value_type = typename std::decay_t<decltype(values)>::value_type;
+    return std::vector<value_type>(values.begin(), values.end());
+  };
+
+  const std::vector<std::int32_t> numbers{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+
+  GIVEN("Ranges of every iterator category")
+  {
+    const std::list<std::string> words{"alpha", "beta", "gamma"};
+    std::istringstream stream{"7 8 9"};
+
+    WHEN("Vectors are constructed from them")
+    {
+      IntVector from_vector(numbers.begin(), numbers.end());
+      IntVector from_pointers(numbers.data() + 2, numbers.data() + 4);
+      StringVector from_list(words.begin(), words.end());
+      IntVector from_stream(std::istream_iterator<std::int32_t>{stream},
+                            std::istream_iterator<std::int32_t>{});
+
+      THEN("They hold the same elements")
+      {
+        REQUIRE(contents(from_vector) == numbers);
+        REQUIRE(contents(from_pointers) == std::vector<std::int32_t>{3, 4});
+        REQUIRE(contents(from_list) == std::vector<std::string>(words.begin(), words.end()));
+        REQUIRE(contents(from_stream) == std::vector<std::int32_t>{7, 8, 9});
+      }
+
+      THEN("Sized ranges allocate exactly what they need")
+      {
+        REQUIRE(from_vector.capacity() == std::max(numbers.size(), IntVector::inline_capacity));
+        REQUIRE(from_list.capacity() == std::max(words.size(), StringVector::inline_capacity));
+      }
+    }
+  }
+
+  GIVEN("A vector with an allocator that counts allocations")
+  {
+    RecordingAllocator<std::int32_t>::reset(0_z);
+
+    WHEN("It is constructed from a large range")
+    {
+      RecordingVector values(numbers.begin(), numbers.end());
+      for (std::int32_t i = 0; i < 10; ++i)
+      {
+        values.append_range(numbers);
+      }
+
+      THEN("Each construction or append allocates at most once")
+      {
+        REQUIRE(values.size() == 110_z);
+        REQUIRE(RecordingAllocator<std::int32_t>::allocations <= 11_z);
+        REQUIRE(values[109] == 10);
+      }
+    }
+  }
+
+  GIVEN("A vector of five integers")
+  {
+    IntVector values{0, 1, 2, 3, 4};
+
+    WHEN("A longer range is assigned")
+    {
+      values.assign(numbers.begin(), numbers.end());
+
+      THEN("The old elements are replaced and the new block fits the range exactly")
+      {
+        REQUIRE(contents(values) == numbers);
+        REQUIRE(values.capacity() == std::max(numbers.size(), IntVector::inline_capacity));
+      }
+    }
+
+    WHEN("A shorter range is assigned")
+    {
+      const auto capacity = values.capacity();
+      values.assign({9, 8});
+
+      THEN("The storage is reused")
+      {
+        REQUIRE(contents(values) == std::vector<std::int32_t>{9, 8});
+        REQUIRE(values.capacity() == capacity);
+      }
+    }
+
+    WHEN("Copies of one of its own elements are assigned")
+    {
+      values.assign(20, values[4]);
+
+      THEN("The value is read before the elements are destroyed")
+      {
+        REQUIRE(contents(values) == std::vector<std::int32_t>(20, 4));
+      }
+    }
+
+    WHEN("Ranges are appended")
+    {
+      const std::list<std::int32_t> list{5, 6};
+      const std::int32_t array[] = {7, 8};
+      values.append_range(list);
+      values.append_range(array);
+      values.append_range(IntVector{});
+
+      THEN("They follow the existing elements")
+      {
+        REQUIRE(contents(values) == std::vector<std::int32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8});
+      }
+    }
+
+    WHEN("Copies of one of its own elements are appended")
+    {
+      values.shrink_to_fit();
+      auto first = values.emplace_back_n(3, values[4]);
+      values.emplace_back_n(0);
+
+      THEN("The value is read before the elements relocate")
+      {
+        REQUIRE(*first == 4);
+        REQUIRE(contents(values) == std::vector<std::int32_t>{0, 1, 2, 3, 4, 4, 4, 4});
+      }
+    }
+  }
+
+  GIVEN("A vector of strings")
+  {
+    StringVector values{"a"};
+
+    WHEN("Several elements are constructed from the same arguments")
+    {
+      values.emplace_back_n(2, 3_z, 'z');
+
+      THEN("Each is constructed from them")
+      {
+        REQUIRE(contents(values) == std::vector<std::string>{"a", "zzz", "zzz"});
+      }
+    }
+  }
+
+  GIVEN("A vector of elements whose copy may throw")
+  {
+    ThrowingMove::reset();
+    ThrowingMoveVector values;
+    values.emplace_back(0);
+    std::vector<ThrowingMove> more;
+    for (std::int32_t i = 1; i < 5; ++i)
+    {
+      more.emplace_back(i);
+    }
+
+    WHEN("A copy throws while appending a range")
+    {
+      ThrowingMove::reset(3_z);
+
+      THEN("The elements appended so far are destroyed")
+      {
+        REQUIRE_THROWS_AS(values.append_range(more), std::runtime_error);
+        REQUIRE(values.size() == 1_z);
+        REQUIRE(values[0].getData() == 0);
+      }
+    }
+  }
+}
+
+TEMPLATE_TEST_CASE("Sharing Vector<T>'s storage without copying",
+                   "[vector]",
+                   VectorFamily,
+                   SmallVectorFamily<2>,
+                   SmallVectorFamily<8>)
+{
+  using IntVector = typename TestType::template container<std::int32_t>;
+  using StringVector = typename TestType::template container<std::string>;
+
+  auto sum = [](gsl::span<const std::int32_t> values) {
+    std::int32_t total = 0;
+    for (auto value : values)
+    {
+      total += value;
+    }
+    return total;
+  };
+
+  GIVEN("A vector of integers")
+  {
+    IntVector values{1, 2, 3, 4};
+
+    THEN("data() points at the elements")
+    {
+      REQUIRE(values.data() == &values[0]);
+      REQUIRE(std::as_const(values).data()[3] == 4);
+    }
+
+    WHEN("It is viewed through a span")
+    {
+      gsl::span<std::int32_t> view = values;
+      view[0] = 10;
+
+      THEN("The span covers the vector's own elements")
+      {
+        REQUIRE(view.data() == values.data());
+        REQUIRE(view.size() == values.size());
+        REQUIRE(values[0] == 10);
+      }
+    }
+
+    THEN("It converts implicitly to a span of constant elements")
+    {
+      const IntVector& constant = values;
+      REQUIRE(sum(values) == 10);
+      REQUIRE(sum(constant) == 10);
+      REQUIRE(gsl::as_bytes(gsl::span<const std::int32_t>{constant}).size() ==
+              4 * sizeof(std::int32_t));
+    }
+  }
+
+  GIVEN("A block of strings built outside any vector")
+  {
+    std::allocator<std::string> allocator;
+    auto block = std::allocator_traits<std::allocator<std::string>>::allocate(allocator, 4);
+    std::allocator_traits<std::allocator<std::string>>::construct(allocator, block, "first");
+    std::allocator_traits<std::allocator<std::string>>::construct(allocator, block + 1, "second");
+
+    WHEN("A vector adopts it")
+    {
+      StringVector values{adopt_buffer, block, 2_z, 4_z, allocator};
+
+      THEN("The vector uses the block as it is")
+      {
+        REQUIRE(values.data() == block);
+        REQUIRE(values.size() == 2_z);
+        REQUIRE(values.capacity() == 4_z);
+        REQUIRE(values[1] == "second");
+      }
+
+      THEN("The vector grows out of it like any other block")
+      {
+        for (std::int32_t i = 0; i < 3; ++i)
+        {
+          values.push_back(std::to_string(i));
+        }
+        REQUIRE(values.size() == 5_z);
+        REQUIRE(values.front() == "first");
+        REQUIRE(values.back() == "2");
+      }
+    }
+  }
+
+  GIVEN("No block")
+  {
+    IntVector values{adopt_buffer, nullptr, 0_z, 0_z};
+
+    THEN("The vector is empty")
+    {
+      REQUIRE(values.empty());
+      REQUIRE(values.capacity() == IntVector::inline_capacity);
+    }
+  }
+}
+
+TEST_CASE("Contiguous iterator detection", "[vector]")
+{
+  STATIC_REQUIRE(detail::is_contiguous_iterator_v<const std::int32_t*>);
+  STATIC_REQUIRE(detail::is_contiguous_iterator_v<std::vector<std::int32_t>::iterator>);
+  STATIC_REQUIRE(detail::is_contiguous_iterator_v<std::vector<std::string>::const_iterator>);
+  STATIC_REQUIRE(detail::is_contiguous_iterator_v<std::string::const_iterator>);
+  STATIC_REQUIRE_FALSE(detail::is_contiguous_iterator_v<std::list<std::int32_t>::iterator>);
+  STATIC_REQUIRE_FALSE(detail::is_contiguous_iterator_v<std::vector<bool>::iterator>);
+  STATIC_REQUIRE_FALSE(detail::is_contiguous_iterator_v<std::istream_iterator<std::int32_t>>);
+}
+
+TEST_CASE("Vector moves are noexcept unless inline elements may throw", "[vector]")
+{
+  STATIC_REQUIRE(std::is_nothrow_move_constructible_v<Vector<ThrowingMove>>);
+  STATIC_REQUIRE(std::is_nothrow_move_assignable_v<Vector<ThrowingMove>>);
+  STATIC_REQUIRE(std::is_nothrow_move_constructible_v<SmallVector<std::string, 4>>);
+  STATIC_REQUIRE_FALSE(std::is_nothrow_move_constructible_v<SmallVector<ThrowingMove, 4>>);
+  STATIC_REQUIRE_FALSE(std::is_nothrow_move_assignable_v<Vector<Foo, PropagatingAllocator<Foo>>>);
+  STATIC_REQUIRE(std::is_nothrow_swappable_v<Vector<ThrowingMove>>);
+  STATIC_REQUIRE_FALSE(std::is_nothrow_swappable_v<SmallVector<ThrowingMove, 4>>);
+}
+
+SCENARIO("Vector resizes its block through allocator extensions", "[vector]")
+{
+  GIVEN("A vector of trivially relocatable elements with a reallocating allocator")
+  {
+    Vector<std::int32_t, RecordingAllocator<std::int32_t>> values(4_z);
+    values.push_back(1);
+    values.push_back(2);
+    RecordingAllocator<std::int32_t>::reset(0_z);
+
+    WHEN("It grows and shrinks")
+    {
+      values.reserve(1000_z);
+      values.shrink_to_fit();
+
+      THEN("The block is reallocated rather than copied into a new allocation")
+      {
+        REQUIRE(RecordingAllocator<std::int32_t>::reallocations == 2_z);
+        REQUIRE(RecordingAllocator<std::int32_t>::allocations == 0_z);
+        REQUIRE(values.capacity() == 2_z);
+        REQUIRE(values.at(0) == 1);
+        REQUIRE(values.at(1) == 2);
+      }
+    }
+  }
+
+  GIVEN("A vector of non-relocatable elements with an expanding allocator")
+  {
+    Vector<std::string, RecordingAllocator<std::string>> values(4_z);
+    values.push_back("one");
+    values.push_back("two");
+
+    WHEN("The allocator can expand the block in place")
+    {
+      RecordingAllocator<std::string>::reset(8_z);
+      values.reserve(8_z);
+
+      THEN("The elements stay where they are")
+      {
+        REQUIRE(RecordingAllocator<std::string>::expansion_attempts == 1_z);
+        REQUIRE(RecordingAllocator<std::string>::reallocations == 0_z);
+        REQUIRE(RecordingAllocator<std::string>::allocations == 0_z);
+        REQUIRE(values.capacity() == 8_z);
+        REQUIRE(values.at(1) == "two");
+      }
+    }
+
+    WHEN("The allocator cannot expand the block in place")
+    {
+      RecordingAllocator<std::string>::reset(0_z);
+      values.reserve(100_z);
+
+      THEN("The elements are moved into a new block")
+      {
+        REQUIRE(RecordingAllocator<std::string>::expansion_attempts == 1_z);
+        REQUIRE(RecordingAllocator<std::string>::allocations == 1_z);
+        REQUIRE(values.capacity() == 100_z);
+        REQUIRE(values.at(0) == "one");
+        REQUIRE(values.at(1) == "two");
+      }
+    }
+  }
+
+  GIVEN("A vector with a malloc-backed allocator")
+  {
+    Vector<Foo, MallocAllocator<Foo>> values;
+
+    WHEN("It grows one element at a time")
+    {
+      for (std::int32_t i = 0; i < 1000; ++i)
+      {
+        values.emplace_back(i);
+      }
+
+      THEN("Every element survives the regrowth")
+      {
+        REQUIRE(values.size() == 1000_z);
+        for (std::int32_t i = 0; i < 1000; ++i)
+        {
+          REQUIRE(values.at(static_cast<std::size_t>(i)).getData() == i);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("Vector growth policies", "[vector]")
+{
+  GIVEN("A vector with the default growth policy")
+  {
+    Vector<std::int32_t> values;
+
+    THEN("The stateless allocator and growth policy take up no space")
+    {
+      STATIC_REQUIRE(sizeof(Vector<std::int32_t>) == 3 * sizeof(void*));
+    }
+
+    WHEN("Elements are added one at a time")
+    {
+      Vector<std::size_t> capacities;
+      for (std::int32_t i = 0; i < 9; ++i)
+      {
+        values.push_back(i);
+        capacities.push_back(values.capacity());
+      }
+
+      THEN("The capacity doubles")
+      {
+        REQUIRE(capacities.at(0) == 1_z);
+        REQUIRE(capacities.at(1) == 2_z);
+        REQUIRE(capacities.at(2) == 4_z);
+        REQUIRE(capacities.at(4) == 8_z);
+        REQUIRE(capacities.at(8) == 16_z);
+      }
+    }
+  }
+
+  GIVEN("A vector with a runtime growth policy")
+  {
+    using RuntimeVector = Vector<std::int32_t, std::allocator<std::int32_t>, RuntimeGrowthPolicy>;
+
+    RuntimeVector values{0_z, std::allocator<std::int32_t>{}, [](std::size_t, std::size_t) {
+                           return 10_z;
+                         }};
+    values.push_back(1);
+
+    THEN("The policy is used when the vector grows")
+    {
+      REQUIRE(values.capacity() == 10_z);
+    }
+
+    WHEN("The vector is copied")
+    {
+      RuntimeVector other{values};
+      other.shrink_to_fit();
+      other.push_back(2);
+
+      THEN("The copy uses the same policy")
+      {
+        REQUIRE(other.capacity() == 11_z);
+      }
+    }
+
+    WHEN("The vector is moved")
+    {
+      RuntimeVector other{std::move(values)};
+      other.shrink_to_fit();
+      other.push_back(2);
+      values.push_back(3);
+
+      THEN("The policy moves with the elements and the source is still usable")
+      {
+        REQUIRE(other.capacity() == 11_z);
+        REQUIRE(values.size() == 1_z);
+        REQUIRE(values.at(0) == 3);
+      }
+    }
+  }
+
+  GIVEN("A vector with a stateful compile-time growth policy")
+  {
+    struct LinearGrowthPolicy
+    {
+      std::size_t step;
+      std::size_t operator()(std::size_t, std::size_t) const { return step; }
+    };
+
+    Vector<std::int32_t, std::allocator<std::int32_t>, LinearGrowthPolicy> values{
+      0_z, std::allocator<std::int32_t>{}, LinearGrowthPolicy{3_z}};
+
+    WHEN("Elements are added")
+    {
+      for (std::int32_t i = 0; i < 4; ++i)
+      {
+        values.push_back(i);
+      }
+
+      THEN("The capacity grows by the policy's step")
+      {
+        REQUIRE(values.capacity() == 6_z);
+      }
+    }
+  }
+}
+
+SCENARIO("SmallVector keeps small contents inline", "[small_vector]")
+{
+  GIVEN("A SmallVector with room for four elements inline")
+  {
+    using IntVector = SmallVector<std::int32_t, 4, RecordingAllocator<std::int32_t>>;
+
+    RecordingAllocator<std::int32_t>::reset(0_z);
+    IntVector values;
+
+    THEN("It is empty but already has the inline capacity")
+    {
+      STATIC_REQUIRE(sizeof(IntVector) >= sizeof(Vector<std::int32_t>) + 4 * sizeof(std::int32_t));
+      REQUIRE(values.empty());
+      REQUIRE(values.capacity() == 4_z);
+    }
+
+    WHEN("It holds up to four elements")
+    {
+      for (std::int32_t i = 0; i < 4; ++i)
+      {
+        values.push_back(i);
+      }
+
+      THEN("Nothing is allocated")
+      {
+        REQUIRE(values.size() == 4_z);
+        REQUIRE(values.capacity() == 4_z);
+        REQUIRE(RecordingAllocator<std::int32_t>::allocations == 0_z);
+      }
+
+      AND_WHEN("A fifth element is added")
+      {
+        values.push_back(4);
+
+        THEN("The elements spill into a single allocation")
+        {
+          REQUIRE(RecordingAllocator<std::int32_t>::allocations == 1_z);
+          REQUIRE(values.capacity() == 8_z);
+          REQUIRE(std::equal(values.begin(), values.end(), std::begin({0, 1, 2, 3, 4})));
+        }
+
+        AND_WHEN("It is shrunk to fit once the elements fit inline again")
+        {
+          values.pop_back();
+          values.pop_back();
+          values.shrink_to_fit();
+
+          THEN("The elements move back inline")
+          {
+            REQUIRE(values.capacity() == 4_z);
+            REQUIRE(std::equal(values.begin(), values.end(), std::begin({0, 1, 2})));
+          }
+        }
+      }
+    }
+  }
+
+  GIVEN("SmallVectors of strings, one inline and one spilled")
+  {
+    using StringVector = SmallVector<std::string, 2>;
+
+    StringVector inline_values{"a", "b"};
+    StringVector spilled_values{"c", "d", "e"};
+
+    WHEN("The inline one is moved")
+    {
+      StringVector other{std::move(inline_values)};
+
+      THEN("Its elements are moved into the new vector's inline storage")
+      {
+        REQUIRE(other.size() == 2_z);
+        REQUIRE(other.capacity() == 2_z);
+        REQUIRE(other.at(0) == "a");
+        REQUIRE(other.at(1) == "b");
+        REQUIRE(inline_values.empty());
+        REQUIRE(inline_values.capacity() == 2_z);
+      }
+    }
+
+    WHEN("The spilled one is move-assigned to the inline one")
+    {
+      inline_values = std::move(spilled_values);
+
+      THEN("The block is stolen")
+      {
+        REQUIRE(inline_values.size() == 3_z);
+        REQUIRE(inline_values.at(2) == "e");
+        REQUIRE(spilled_values.empty());
+        REQUIRE(spilled_values.capacity() == 2_z);
+      }
+    }
+
+    WHEN("They are swapped")
+    {
+      swap(inline_values, spilled_values);
+
+      THEN("The inline elements and the block trade places")
+      {
+        REQUIRE(inline_values.size() == 3_z);
+        REQUIRE(inline_values.at(0) == "c");
+        REQUIRE(inline_values.at(2) == "e");
+        REQUIRE(spilled_values.size() == 2_z);
+        REQUIRE(spilled_values.capacity() == 2_z);
+        REQUIRE(spilled_values.at(0) == "a");
+        REQUIRE(spilled_values.at(1) == "b");
+      }
+    }
+
+    WHEN("Two inline vectors of different sizes are swapped")
+    {
+      StringVector other{"x"};
+      swap(inline_values, other);
+
+      THEN("Their elements are exchanged")
+      {
+        REQUIRE(inline_values.size() == 1_z);
+        REQUIRE(inline_values.at(0) == "x");
+        REQUIRE(other.size() == 2_z);
+        REQUIRE(other.at(0) == "a");
+        REQUIRE(other.at(1) == "b");
+      }
+    }
+
+    WHEN("The spilled one is copied")
+    {
+      StringVector other{spilled_values};
+
+      THEN("The copy has its own block")
+      {
+        REQUIRE(other.size() == 3_z);
+        REQUIRE(other.at(1) == "d");
+        REQUIRE(spilled_values.at(1) == "d");
+      }
+    }
+  }
+}
+
+TEST_CASE("Trivially relocatable trait", "[vector]")
+{
+  STATIC_REQUIRE(is_trivially_relocatable_v<int>);
+  STATIC_REQUIRE(is_trivially_relocatable_v<Foo>);
+  STATIC_REQUIRE(is_trivially_relocatable_v<Bar>);
+  STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<std::string>);
+}
+
 template <typename Iterator, typename VectorType>
 void testCommonIteratorOperations(VectorType& values, Iterator begin, Iterator end)
 {
@@ -671,10 +1946,16 @@ void testCommonIteratorOperations(VectorType& values, Iterator begin, Iterator e
   }
 }
 
-SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector_iterator]")
+TEMPLATE_TEST_CASE("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator",
+                   "[vector_iterator]",
+                   VectorFamily,
+                   SmallVectorFamily<2>,
+                   SmallVectorFamily<8>)
 {
-  using Iterator = Vector<Foo>::Iterator;
-  using ConstIterator = Vector<Foo>::ConstIterator;
+  using FooVector = typename TestType::template container<Foo>;
+  using IntVector = typename TestType::template container<int>;
+  using Iterator = typename FooVector::Iterator;
+  using ConstIterator = typename FooVector::ConstIterator;
 
   GIVEN("A vector with three elements")
   {
@@ -682,7 +1963,7 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
     const Foo b{2};
     const Foo c{3};
 
-    Vector<Foo> values{a, b, c};
+    FooVector values{a, b, c};
 
     GIVEN("A non-const Vector")
     {
@@ -691,11 +1972,12 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
 
     GIVEN("A const Vector")
     {
-      const Vector<Foo>& const_values = values;
+      const FooVector& const_values = values;
       testCommonIteratorOperations(const_values, const_values.begin(), const_values.end());
     }
   }
 
+#if !defined(CPP_TRAINING_UNCHECKED_ITERATORS)
   GIVEN("A default-constructed iterator")
   {
     Iterator it{};
@@ -758,8 +2040,8 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
 
   GIVEN("Iterators from unrelated containers")
   {
-    Vector<Foo> one;
-    Vector<Foo> two;
+    FooVector one;
+    FooVector two;
 
     auto it1 = one.begin();
     auto it2 = two.begin();
@@ -773,7 +2055,7 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
   GIVEN("An invalid iterator and a valid iterator")
   {
     Iterator invalid{};
-    Vector<Foo> values{Foo{1}};
+    FooVector values{Foo{1}};
     auto valid = values.begin();
 
     SECTION("operator< throws when lhs is invalid")
@@ -828,7 +2110,7 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
     const Foo b{2};
     const Foo c{3};
 
-    Vector<Foo> values{a, b, c};
+    FooVector values{a, b, c};
     auto it = values.end();
 
     SECTION("Subtracting past begin() clamps at begin()")
@@ -838,16 +2120,18 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
       REQUIRE(result == values.begin()); // clamp to begin()
     }
   }
+#endif
 
   SECTION("std::sort works with iterators (if T is sortable)")
   {
-    Vector<int> values{3, 1, 2};
+    IntVector values{3, 1, 2};
     std::sort(values.begin(), values.end());
     REQUIRE(values.at(0) == 1);
     REQUIRE(values.at(1) == 2);
     REQUIRE(values.at(2) == 3);
   }
 
+#if !defined(CPP_TRAINING_UNCHECKED_ITERATORS)
   GIVEN("A default-constructed ConstIterator")
   {
     ConstIterator it{};
@@ -910,8 +2194,8 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
 
   GIVEN("ConstIterators from unrelated containers")
   {
-    const Vector<Foo> one;
-    const Vector<Foo> two;
+    const FooVector one;
+    const FooVector two;
 
     auto it1 = one.begin();
     auto it2 = two.begin();
@@ -925,7 +2209,7 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
   GIVEN("An invalid ConstIterator and a valid ConstIterator")
   {
     ConstIterator invalid{};
-    const Vector<Foo> values{Foo{1}};
+    const FooVector values{Foo{1}};
     auto valid = values.begin();
 
     SECTION("operator< throws when lhs is invalid")
@@ -973,6 +2257,7 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
       REQUIRE_THROWS_AS(invalid - invalid, std::runtime_error);
     }
   }
+#endif
 
   GIVEN("A valid ConstIterator at cbegin()")
   {
@@ -980,18 +2265,20 @@ SCENARIO("Exercising Vector<T>::Iterator and Vector<T>::ConstIterator", "[vector
     const Foo b{2};
     const Foo c{3};
 
-    Vector<Foo> values{a, b, c};
+    FooVector values{a, b, c};
 
+#if !defined(CPP_TRAINING_UNCHECKED_ITERATORS)
     SECTION("Subtracting past cbegin() clamps at cbegin()")
     {
       auto result = values.cend();
       result -= 4;
       REQUIRE(result == values.cbegin()); // clamp to cbegin()
     }
+#endif
 
     SECTION("ConstIterator can be constructed from Iterator")
     {
-      Vector<Foo>::Iterator it = values.begin();
+      Iterator it = values.begin();
       ConstIterator const_it(it);
       REQUIRE(const_it == values.cbegin());
       REQUIRE(*const_it == *it);